@@ -36,6 +36,7 @@
 ##########################################################################
 
 import os, sys, traceback
+import functools
 
 import IECore
 
@@ -94,6 +95,18 @@ class execute( Gaffer.Application ) :
 					allowEmptyList = False,
 				),
 
+				IECore.IntParameter(
+					name = "scriptThreads",
+					description = "The maximum number of threads used to execute "
+						"the script's tasks. These threads are taken from a "
+						"dedicated arena, so that several execute processes, or "
+						"several scripts within one process, can be given "
+						"predictable shares of the machine. The default value of "
+						"zero imposes no limit other than the -threads parameter.",
+					defaultValue = 0,
+					minValue = 0,
+				),
+
 				IECore.StringVectorParameter(
 					name = "context",
 					description = "The context used during execution. Note that the frames "
@@ -128,6 +141,9 @@ class execute( Gaffer.Application ) :
 
 		self.root()["scripts"].addChild( scriptNode )
 
+		if args["scriptThreads"].value :
+			scriptNode.setThreadBudget( Gaffer.ThreadBudget( args["scriptThreads"].value ) )
+
 		nodes = []
 		if len( args["nodes"] ) :
 			for nodeName in args["nodes"] :
@@ -161,7 +177,7 @@ class execute( Gaffer.Application ) :
 		with context :
 			for node in nodes :
 				try :
-					node["task"].executeSequence( frames )
+					self.__executeSequence( scriptNode, node, frames )
 				except Exception as exception :
 					IECore.msg(
 						IECore.Msg.Level.Debug,
@@ -177,4 +193,12 @@ class execute( Gaffer.Application ) :
 
 		return 0
 
+	def __executeSequence( self, scriptNode, node, frames ) :
+
+		threadBudget = scriptNode.getThreadBudget()
+		if threadBudget is not None :
+			threadBudget.execute( functools.partial( node["task"].executeSequence, frames ) )
+		else :
+			node["task"].executeSequence( frames )
+
 IECore.registerRunTimeTyped( execute )
@@ -69,6 +69,18 @@ class gui( Gaffer.Application ) :
 					description = "Opens the UI in full screen mode.",
 					defaultValue = False,
 				),
+
+				IECore.IntParameter(
+					name = "scriptThreads",
+					description = "The maximum number of threads used by background "
+						"work for each script, such as interactive render updates. "
+						"These threads are taken from a dedicated arena, leaving the "
+						"remainder free for the viewers and the rest of the UI. The "
+						"default value of zero imposes no limit other than the "
+						"-threads parameter.",
+					defaultValue = 0,
+					minValue = 0,
+				),
 			]
 
 		)
@@ -85,6 +97,10 @@ class gui( Gaffer.Application ) :
 
 		GafferUI.ScriptWindow.connect( self.root() )
 
+		self.__scriptThreads = args["scriptThreads"].value
+		if self.__scriptThreads :
+			self.__scriptAddedConnection = self.root()["scripts"].childAddedSignal().connect( Gaffer.WeakMethod( self.__scriptAdded ) )
+
 		if len( args["scripts"] ) :
 			for fileName in args["scripts"] :
 				scriptNode = Gaffer.ScriptNode()
@@ -107,6 +123,10 @@ class gui( Gaffer.Application ) :
 
 		return 0
 
+	def __scriptAdded( self, scriptContainer, scriptNode ) :
+
+		scriptNode.setThreadBudget( Gaffer.ThreadBudget( self.__scriptThreads ) )
+
 	def __setupClipboardSync( self ) :
 
 		## This function sets up two way syncing between the clipboard held in the Gaffer::ApplicationRoot
@@ -75,6 +75,12 @@ class stats( Gaffer.Application ) :
 			```
 			gaffer stats fileName.gfr -image NameOfNode -performanceMonitor
 			```
+
+			To record a timeline of a scene generation for viewing in a trace viewer :
+
+			```
+			gaffer stats fileName.gfr -scene NameOfNode -chromeTrace trace.json
+			```
 			"""
 		)
 
@@ -115,10 +121,42 @@ class stats( Gaffer.Application ) :
 					defaultValue = False,
 				),
 
+				IECore.IntParameter(
+					name = "performanceMonitorSampleInterval",
+					description = "Reduces the overhead of the performance monitor "
+						"by timing only one in every N processes on each thread. "
+						"Hash and compute counts remain exact, but durations are "
+						"estimated.",
+					defaultValue = 1,
+					minValue = 1,
+				),
+
+				IECore.FileNameParameter(
+					name = "chromeTrace",
+					description = "Turns on a performance monitor and writes a timeline "
+						"of every hash and compute process, on every thread, to the "
+						"specified file. The file uses the Chrome trace event format, "
+						"and may be viewed in chrome://tracing and similar tools.",
+					defaultValue = "",
+					allowEmptyString = True,
+					extensions = "json",
+				),
+
+				IECore.FileNameParameter(
+					name = "flameGraph",
+					description = "Turns on a performance monitor and writes the time "
+						"spent in each stack of hash and compute processes to the "
+						"specified file, in the \"folded stacks\" format used by "
+						"flame graph generators.",
+					defaultValue = "",
+					allowEmptyString = True,
+				),
+
 				IECore.IntParameter(
 					name = "maxLinesPerMetric",
 					description = "The maximum number of plugs to list for each metric "
-						"captured by the performance monitor.",
+						"captured by the performance monitor, and for each breakdown "
+						"of cache memory usage.",
 					defaultValue = 50,
 				),
 
@@ -163,8 +201,12 @@ class stats( Gaffer.Application ) :
 
 		self.__memory["Script"] = _Memory.maxRSS() - self.__memory["Application"]
 
-		if args["performanceMonitor"].value :
-			self.__performanceMonitor = Gaffer.PerformanceMonitor()
+		recordEvents = bool( args["chromeTrace"].value or args["flameGraph"].value )
+		if args["performanceMonitor"].value or recordEvents :
+			self.__performanceMonitor = Gaffer.PerformanceMonitor(
+				recordEvents = recordEvents,
+				sampleInterval = args["performanceMonitorSampleInterval"].value
+			)
 		else :
 			self.__performanceMonitor = None
 
@@ -215,10 +257,16 @@ class stats( Gaffer.Application ) :
 
 		print ""
 
+		self.__printCacheMemoryUsage( script, args )
+
+		print ""
+
 		self.__printPerformance( script, args )
 
 		print ""
 
+		self.__writeEvents( args )
+
 		self.__printContext( script, args )
 
 		print
@@ -388,6 +436,37 @@ class stats( Gaffer.Application ) :
 		print "Memory :\n"
 		self.__printItems( items )
 
+	def __printCacheMemoryUsage( self, script, args ) :
+
+		# The cache is shared by all scripts, and reports usage by full
+		# plug name. We're only interested in the plugs from our script.
+
+		prefix = script.fullName() + "."
+
+		plugUsage = []
+		nodeUsage = collections.defaultdict( int )
+		for name, usage in Gaffer.ValuePlug.cacheMemoryUsageByPlug().items() :
+			if not name.startswith( prefix ) :
+				continue
+			plug = script.descendant( name[len(prefix):] )
+			if plug is None :
+				continue
+			plugUsage.append( ( plug.relativeName( script ), usage ) )
+			nodeUsage[plug.node().relativeName( script )] += usage
+
+		n = args["maxLinesPerMetric"].value
+
+		print "Cache memory usage by node :\n"
+		self.__printCacheMemoryUsageItems( nodeUsage.items(), n )
+
+		print "\nCache memory usage by plug :\n"
+		self.__printCacheMemoryUsageItems( plugUsage, n )
+
+	def __printCacheMemoryUsageItems( self, stats, n ) :
+
+		stats.sort( key = lambda x : x[1], reverse = True )
+		self.__printItems( [ ( x[0], _Memory( x[1] ) ) for x in stats[:n] ] )
+
 	def __printStatisticsItems( self, script, stats, key, n ) :
 
 		stats.sort( key = key, reverse = True )
@@ -397,7 +476,20 @@ class stats( Gaffer.Application ) :
 	def __printPerformance( self, script, args ) :
 
 			print "Performance :\n"
-			self.__printItems( self.__timers.items() )
+
+			hashCacheStatistics = Gaffer.ValuePlug.hashCacheStatistics()
+
+			items = self.__timers.items()
+			items.extend( [
+				( "", "" ),
+				( "Hash cache limit", Gaffer.ValuePlug.getHashCacheSizeLimit() ),
+				( "Hash cache size", Gaffer.ValuePlug.hashCacheSize() ),
+				( "Hash cache hits", hashCacheStatistics.hits ),
+				( "Hash cache misses", hashCacheStatistics.misses ),
+				( "Hash cache evictions", hashCacheStatistics.evictions ),
+			] )
+
+			self.__printItems( items )
 
 			if self.__performanceMonitor is not None :
 				print "\n" + Gaffer.MonitorAlgo.formatStatistics(
@@ -405,6 +497,17 @@ class stats( Gaffer.Application ) :
 					maxLinesPerMetric = args["maxLinesPerMetric"].value
 				)
 
+	def __writeEvents( self, args ) :
+
+		for parameterName, formatter in (
+			( "chromeTrace", Gaffer.MonitorAlgo.formatChromeTrace ),
+			( "flameGraph", Gaffer.MonitorAlgo.formatFlameGraph ),
+		) :
+			fileName = args[parameterName].value
+			if fileName :
+				with open( fileName, "w" ) as f :
+					f.write( formatter( self.__performanceMonitor ) )
+
 	def __printContext( self, script, args ) :
 
 			if self.__contextMonitor is None :
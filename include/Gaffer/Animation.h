@@ -37,6 +37,8 @@
 #ifndef GAFFER_ANIMATION_H
 #define GAFFER_ANIMATION_H
 
+#include "tbb/atomic.h"
+
 #include "Gaffer/ComputeNode.h"
 #include "Gaffer/NumericPlug.h"
 
@@ -120,6 +122,11 @@ class Animation : public ComputeNode
 				const Keys &keys() const;
 
 				float evaluate( float time ) const;
+				/// Evaluates the curve at each of the specified times,
+				/// filling `values` with the results. This is significantly
+				/// faster than calling evaluate( time ) repeatedly, particularly
+				/// when the times are in increasing order.
+				void evaluate( const std::vector<float> &times, std::vector<float> &values ) const;
 
 				/// Output plug for evaluating the curve
 				/// over time - use this as the input to
@@ -130,8 +137,19 @@ class Animation : public ComputeNode
 			private :
 
 				void addOrRemoveKeyInternal( const Key &key );
+				// Returns the index of the first key in m_packedKeys with
+				// a time not less than `time`, searching forwards from
+				// `hint` where possible.
+				size_t lowerBound( float time, size_t hint ) const;
+				float evaluate( float time, size_t lowerBound ) const;
 
 				Keys m_keys;
+				// A copy of m_keys packed into contiguous storage,
+				// for faster evaluation.
+				std::vector<Key> m_packedKeys;
+				// The result of the last lowerBound() search made by
+				// evaluate( time ), used as the hint for the next one.
+				mutable tbb::atomic<size_t> m_lowerBoundHint;
 
 		};
 
@@ -143,6 +161,10 @@ class Animation : public ComputeNode
 		Plug *curvesPlug();
 		const Plug *curvesPlug() const;
 
+		/// Evaluates each of the curves at the specified time, filling
+		/// `values` with the results.
+		static void evaluate( const std::vector<const CurvePlug *> &curves, float time, std::vector<float> &values );
+
 		static bool canAnimate( const ValuePlug *plug );
 		static bool isAnimated( const ValuePlug *plug );
 
@@ -0,0 +1,95 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2016, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef GAFFER_BATCHEDITSCOPE_H
+#define GAFFER_BATCHEDITSCOPE_H
+
+#include "boost/noncopyable.hpp"
+
+namespace Gaffer
+{
+
+/// Used to group many calls to ValuePlug::setValue() into
+/// a single edit. Values are assigned immediately, but the
+/// Node::plugSetSignal() and the propagation of dirtiness
+/// are deferred until the outermost scope exits. Then the
+/// edits are applied as a single undoable action per
+/// ScriptNode, within a single pass of dirty propagation.
+/// This makes it suitable for large programmatic edits such
+/// as applying presets or importing animation.
+///
+/// ```
+/// {
+/// 	BatchEditScope scope;
+/// 	for( ... )
+/// 	{
+/// 		plug->setValue( value );
+/// 	}
+/// }
+/// // A single undo step restores all the values
+/// // set above.
+/// ```
+///
+/// > Note : Because the edits are recorded as an action when
+/// > the scope exits, other undoable edits should not be made
+/// > within the scope.
+class BatchEditScope : boost::noncopyable
+{
+
+	public :
+
+		BatchEditScope();
+		/// Calls commit() if it hasn't been called already. Because
+		/// destructors must not throw, any exception thrown by the commit
+		/// is reported via IECore::msg() instead.
+		~BatchEditScope();
+
+		/// Exits the scope, enacting the edits if it is the outermost
+		/// one. Exceptions thrown by slots connected to the signals
+		/// this emits are propagated to the caller. Must be called at
+		/// most once.
+		void commit();
+
+	private :
+
+		bool m_committed;
+
+};
+
+} // namespace Gaffer
+
+#endif // GAFFER_BATCHEDITSCOPE_H
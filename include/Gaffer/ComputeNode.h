@@ -41,6 +41,7 @@
 #include "IECore/MurmurHash.h"
 
 #include "Gaffer/DependencyNode.h"
+#include "Gaffer/ValuePlug.h"
 
 namespace Gaffer
 {
@@ -78,6 +79,20 @@ class ComputeNode : public DependencyNode
 		/// an appropriate value and apply it using output->setValue().
 		virtual void compute( ValuePlug *output, const Context *context ) const = 0;
 
+		/// Called to determine how the results of computations for an output
+		/// plug should be cached. The default implementation returns Standard
+		/// for plugs with the Cacheable flag and HashOnly for those without.
+		/// Derived classes may reimplement to choose a more appropriate
+		/// policy, but must not return a policy which depends on the context.
+		virtual ValuePlug::CachePolicy computeCachePolicy( const ValuePlug *output ) const;
+		/// Called to determine whether or not the results of computations for an
+		/// output plug may be stored in the persistent cache, for reuse by other
+		/// processes. This should only return true if the hash for the output is
+		/// stable from one process to the next, and if the value is expensive
+		/// enough to compute that loading it from disk is worthwhile. The default
+		/// implementation returns false.
+		virtual bool persistentCacheable( const ValuePlug *output ) const;
+
 	private :
 
 		friend class ValuePlug;
@@ -37,13 +37,18 @@
 #ifndef GAFFER_CONTEXT_H
 #define GAFFER_CONTEXT_H
 
+#include "tbb/spin_mutex.h"
+
 #include "boost/container/flat_map.hpp"
+#include "boost/container/flat_set.hpp"
 #include "boost/signals.hpp"
 
 #include "IECore/InternedString.h"
 #include "IECore/Data.h"
 #include "IECore/MurmurHash.h"
 
+#include "Gaffer/Canceller.h"
+
 namespace Gaffer
 {
 
@@ -105,6 +110,10 @@ class Context : public IECore::RefCounted
 		/// context is const and outlives the temporary context, the constraints
 		/// required of client code are met with little effort.
 		Context( const Context &other, Ownership ownership = Copied );
+		/// Copy constructor for creating a cancellable context. The canceller
+		/// is referenced, not copied, and must remain alive for as long as the
+		/// context and any contexts copied from it are in use.
+		Context( const Context &other, const Canceller &canceller, Ownership ownership = Copied );
 		~Context();
 
 		IE_CORE_DECLAREMEMBERPTR( Context )
@@ -171,7 +180,17 @@ class Context : public IECore::RefCounted
 		/// A signal emitted when an element of the context is changed.
 		ChangedSignal &changedSignal();
 
+		/// Returns the canceller for work performed in this context, or
+		/// NULL if it is not cancellable. Copies of a context share its
+		/// canceller. Long-running computes should call
+		/// `Canceller::check( context->canceller() )` periodically. The
+		/// canceller doesn't contribute to the hash.
+		const Canceller *canceller() const;
+
 		IECore::MurmurHash hash() const;
+		/// Returns a hash of just the named variables. Variables which
+		/// don't exist in the context don't contribute to the hash.
+		IECore::MurmurHash hash( const std::vector<IECore::InternedString> &names ) const;
 
 		bool operator == ( const Context &other ) const;
 		bool operator != ( const Context &other ) const;
@@ -231,13 +250,157 @@ class Context : public IECore::RefCounted
 
 		};
 
+		/// The EditableScope class provides a cheaper alternative to
+		/// constructing a temporary Borrowed copy of a context and making
+		/// it current with a Scope. Rather than being allocated on the heap,
+		/// the copy is taken from a per-thread pool, and values set via the
+		/// scope reuse the storage from previous uses where possible. This
+		/// makes it well suited to the tight loops common in scene traversals.
+		///
+		/// The constraints for Borrowed ownership apply : the original context
+		/// must outlive the scope. Additionally, the context provided by the
+		/// scope is reused once the scope is destroyed, so it must not be
+		/// referenced beyond the lifetime of the scope.
+		class EditableScope : boost::noncopyable
+		{
+
+			public :
+
+				/// Pushes a borrowed copy of context, which may then be
+				/// edited using the methods below.
+				EditableScope( const Context *context );
+				/// Pops the copy and returns it to the pool.
+				~EditableScope();
+
+				/// As for Context::set(), but for simple types only.
+				template<typename T>
+				void set( const IECore::InternedString &name, const T &value );
+
+				void setFrame( float frame );
+				void setTime( float timeInSeconds );
+
+				void remove( const IECore::InternedString &name );
+
+				const Context *context() const;
+
+			private :
+
+				struct Pool;
+				struct PoolEntry;
+
+				static PoolEntry *acquire( const Context *context, Pool *&pool );
+
+				// Returns scratch data previously set for name, provided it is of
+				// the required type and is not referenced elsewhere. Returns NULL
+				// otherwise.
+				IECore::Data *scratch( const IECore::InternedString &name, IECore::TypeId typeId );
+				void setScratch( const IECore::InternedString &name, IECore::Data *data );
+
+				Pool *m_pool;
+				PoolEntry *m_entry;
+				Context *m_context;
+				Scope m_scope;
+
+		};
+
 		/// Returns the current context for the calling thread.
 		static const Context *current();
 
+		/// The AccessRecorder class records the names of the context variables
+		/// accessed by the calling thread while it is in scope. This is used by
+		/// ValuePlug to determine which variables a hash depends on, so that
+		/// other variables can be ignored when caching. Accesses made via get()
+		/// and substitute() record just the variables concerned, while hash(),
+		/// names() and operator == record a dependency on all variables. When a
+		/// recorder is destroyed, its accesses are also recorded by the recorder
+		/// which was current when it was constructed.
+		///
+		/// Accesses made by the thread which constructed the recorder are
+		/// recorded directly. To account for work which ComputeNode::hash()
+		/// parallelises using TBB, the recorder also makes current a borrowed
+		/// copy of the current context which is linked to the recorder. This
+		/// link is inherited by any contexts copied from it, and accesses to
+		/// any such context are recorded by the recorder, even when made on
+		/// other threads. Code may also use an AccessRecorder::Scope to make
+		/// a recorder current on a worker thread explicitly, which avoids the
+		/// cost of locking the link for each access.
+		class AccessRecorder : boost::noncopyable
+		{
+
+			public :
+
+				/// Constructs a recorder, making it current for the calling thread,
+				/// and pushing a linked copy of the current context. If the calling
+				/// thread has no current recorder, but the current context is linked
+				/// to one, that recorder is treated as the previously current recorder.
+				AccessRecorder();
+				/// Restores the previously current recorder, adding our accesses to it.
+				~AccessRecorder();
+
+				typedef boost::container::flat_set<IECore::InternedString> Names;
+
+				/// Returns true if a dependency on all variables was recorded,
+				/// in which case names() is meaningless.
+				bool all() const;
+				/// Returns the names of the variables accessed.
+				const Names &names() const;
+
+				/// Returns the current recorder for the calling thread, or NULL
+				/// if there is none.
+				static AccessRecorder *current();
+
+				/// Makes a recorder current for the calling thread for the lifetime
+				/// of the Scope. Passing NULL suspends recording entirely, including
+				/// recording via linked contexts.
+				class Scope : boost::noncopyable
+				{
+
+					public :
+
+						Scope( AccessRecorder *recorder );
+						~Scope();
+
+					private :
+
+						AccessRecorder *m_previous;
+						bool m_previousScoped;
+
+				};
+
+			private :
+
+				friend class Context;
+
+				// Shared by the recorder and the contexts linked to it, so that
+				// accesses made via those contexts can be recorded without
+				// risk of the recorder being destroyed concurrently.
+				struct Link;
+				typedef boost::intrusive_ptr<Link> LinkPtr;
+
+				void record( const IECore::InternedString &name );
+				void recordAll();
+				// Records all our accesses with `recorder`.
+				void recordInto( AccessRecorder *recorder ) const;
+
+				AccessRecorder *m_parent;
+				LinkPtr m_parentLink;
+				LinkPtr m_link;
+				EditableScope m_scope;
+				tbb::spin_mutex m_mutex;
+				bool m_all;
+				Names m_names;
+
+		};
+
 	private :
 
 		void substituteInternal( const char *s, std::string &result, const int recursionDepth, unsigned substitutions ) const;
 
+		// Records an access with the current AccessRecorder, if there is one,
+		// and otherwise with the recorder we are linked to, if any.
+		void recordAccess( const IECore::InternedString &name ) const;
+		void recordAccessToAll() const;
+
 		// Storage for each entry.
 		struct Storage
 		{
@@ -248,14 +411,36 @@ class Context : public IECore::RefCounted
 			// And use this ownership flag to tell us when we need to do explicit
 			// reference count management.
 			Ownership ownership;
+			// The contribution this entry makes to the hash of the context.
+			IECore::MurmurHash hash;
 		};
 
 		typedef boost::container::flat_map<IECore::InternedString, Storage> Map;
 
+		// Updates the hash for an entry whose value has changed, along
+		// with the hash for the context as a whole.
+		void updateHash( const IECore::InternedString &name, Storage &storage );
+		// Applies the ownership to entries copied from another context.
+		void copyValues( Ownership ownership );
+		// Used by EditableScope to reinitialise a pooled context as a
+		// borrowed copy of another, reusing the existing map storage. All
+		// our entries must already be Borrowed.
+		void assignBorrowed( const Context &other );
+		// Used by EditableScope to reference a value without taking
+		// ownership.
+		void setBorrowed( const IECore::InternedString &name, const IECore::Data *data );
+
 		Map m_map;
 		ChangedSignal *m_changedSignal;
-		mutable IECore::MurmurHash m_hash;
-		mutable bool m_hashValid;
+		const Canceller *m_canceller;
+		// The hash is maintained incrementally, as the sum of the hashes of
+		// the individual entries. This is independent of the order of the
+		// entries, and means that changing a single entry only requires that
+		// entry to be rehashed, regardless of how many others there are.
+		IECore::MurmurHash m_hash;
+		// The AccessRecorder used for accesses made on threads
+		// with no recorder of their own.
+		AccessRecorder::LinkPtr m_accessRecorderLink;
 
 };
 
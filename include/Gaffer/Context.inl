@@ -181,7 +181,7 @@ void Context::set( const IECore::InternedString &name, const T &value )
 	Storage &s = m_map[name];
 	if( Accessor<T>().set( s, value ) )
 	{
-		m_hashValid = false;
+		updateHash( name, s );
 		if( m_changedSignal )
 		{
 			(*m_changedSignal)( this, name );
@@ -192,6 +192,7 @@ void Context::set( const IECore::InternedString &name, const T &value )
 template<typename T>
 typename Context::Accessor<T>::ResultType Context::get( const IECore::InternedString &name ) const
 {
+	recordAccess( name );
 	Map::const_iterator it = m_map.find( name );
 	if( it == m_map.end() )
 	{
@@ -203,6 +204,7 @@ typename Context::Accessor<T>::ResultType Context::get( const IECore::InternedSt
 template<typename T>
 typename Context::Accessor<T>::ResultType Context::get( const IECore::InternedString &name, typename Accessor<T>::ResultType defaultValue ) const
 {
+	recordAccess( name );
 	Map::const_iterator it = m_map.find( name );
 	if( it == m_map.end() )
 	{
@@ -211,6 +213,25 @@ typename Context::Accessor<T>::ResultType Context::get( const IECore::InternedSt
 	return Accessor<T>().get( it->second.data );
 }
 
+template<typename T>
+void Context::EditableScope::set( const IECore::InternedString &name, const T &value )
+{
+	typedef typename Gaffer::Detail::DataTraits<T>::DataType DataType;
+	DataType *data = static_cast<DataType *>( scratch( name, DataType::staticTypeId() ) );
+	if( data )
+	{
+		// Update in place to avoid allocations.
+		data->writable() = value;
+	}
+	else
+	{
+		typename DataType::Ptr newData = new DataType( value );
+		data = newData.get();
+		setScratch( name, data );
+	}
+	m_context->setBorrowed( name, data );
+}
+
 } // namespace Gaffer
 
 #endif // GAFFER_CONTEXT_INL
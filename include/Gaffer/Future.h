@@ -0,0 +1,203 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2016, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef GAFFER_FUTURE_H
+#define GAFFER_FUTURE_H
+
+#include "tbb/atomic.h"
+
+#include "IECore/RefCounted.h"
+
+#include "Gaffer/Canceller.h"
+#include "Gaffer/Context.h"
+
+namespace Gaffer
+{
+
+/// Base class for the results of work launched asynchronously on the TBB
+/// thread pool. The work is performed in a copy of the Context that was
+/// current at launch, so the caller is free to change or discard its own
+/// context in the meantime. The copy is given a Canceller, which is used
+/// to implement cancel().
+///
+/// Futures allow code such as the UI to request many values concurrently
+/// without blocking, polling done() or calling wait() to gather the results.
+class FutureBase : public IECore::RefCounted
+{
+
+	public :
+
+		virtual ~FutureBase();
+
+		IE_CORE_DECLAREMEMBERPTR( FutureBase )
+
+		/// Returns true once the work has finished, whether it succeeded,
+		/// failed or was cancelled. Never blocks.
+		bool done() const;
+		/// Blocks until the work has finished. This must not be called
+		/// from within a TBB task, because all the worker threads could
+		/// end up waiting for work that none of them are free to perform.
+		void wait() const;
+		/// Requests that the work be cancelled. Cancellation is
+		/// cooperative, so the work may still complete normally.
+		void cancel();
+		/// Returns true if the work was abandoned due to cancellation.
+		/// Only meaningful once done() returns true.
+		bool cancelled() const;
+
+	protected :
+
+		FutureBase();
+
+		/// Must be called by derived classes once fully constructed,
+		/// to launch run() on the thread pool.
+		void start();
+		/// Must be implemented by derived classes to perform the work
+		/// and store its result. Called on a TBB thread, with the copy
+		/// of the launching context made current.
+		virtual void run() = 0;
+		/// Waits for the work to finish, then throws Cancelled if it was
+		/// cancelled, or IECore::Exception if it failed.
+		void check() const;
+
+	private :
+
+		class Task;
+		struct Waiter;
+
+		enum Status
+		{
+			Running,
+			Succeeded,
+			Failed,
+			WasCancelled
+		};
+
+		void finish( Status status, const std::string &error = "" );
+
+		Canceller m_canceller;
+		ConstContextPtr m_context;
+		tbb::atomic<int> m_status;
+		std::string m_error;
+		Waiter *m_waiter;
+
+};
+
+IE_CORE_DECLAREPTR( FutureBase );
+
+/// A Future for a result of type T.
+template<typename T>
+class Future : public FutureBase
+{
+
+	public :
+
+		IE_CORE_DECLAREMEMBERPTR( Future )
+
+		/// Launches `f()` on the thread pool, returning a Future
+		/// for its result. The functor is copied.
+		template<typename F>
+		static Ptr launch( const F &f );
+
+		/// Waits for the work to finish and returns the result. Throws
+		/// Cancelled if the work was cancelled, and IECore::Exception if
+		/// it failed.
+		const T &get() const;
+
+	protected :
+
+		Future();
+
+		T m_value;
+
+	private :
+
+		template<typename F>
+		class FunctorFuture;
+
+};
+
+template<typename T>
+template<typename F>
+class Future<T>::FunctorFuture : public Future<T>
+{
+
+	public :
+
+		FunctorFuture( const F &f )
+			:	m_f( f )
+		{
+		}
+
+	protected :
+
+		virtual void run()
+		{
+			this->m_value = m_f();
+		}
+
+	private :
+
+		F m_f;
+
+};
+
+template<typename T>
+Future<T>::Future()
+	:	m_value()
+{
+}
+
+template<typename T>
+template<typename F>
+typename Future<T>::Ptr Future<T>::launch( const F &f )
+{
+	Ptr result = new FunctorFuture<F>( f );
+	result->start();
+	return result;
+}
+
+template<typename T>
+const T &Future<T>::get() const
+{
+	check();
+	return m_value;
+}
+
+} // namespace Gaffer
+
+#endif // GAFFER_FUTURE_H
@@ -39,6 +39,7 @@
 #define GAFFER_GRAPHCOMPONENT_H
 
 #include "boost/signals.hpp"
+#include "boost/scoped_ptr.hpp"
 
 #include "IECore/RunTimeTyped.h"
 #include "IECore/InternedString.h"
@@ -246,6 +247,7 @@ class GraphComponent : public IECore::RunTimeTyped, public boost::signals::track
 		void setNameInternal( const IECore::InternedString &name );
 		void addChildInternal( GraphComponentPtr child );
 		void removeChildInternal( GraphComponentPtr child, bool emitParentChanged );
+		const GraphComponent *getChildInternal( const IECore::InternedString &name ) const;
 
 		/// \todo The memory overhead of all these signals may become too great.
 		/// At this point we need to reimplement the signal returning functions to
@@ -262,6 +264,12 @@ class GraphComponent : public IECore::RunTimeTyped, public boost::signals::track
 		GraphComponent *m_parent;
 		ChildContainer m_children;
 
+		// Parents with many children maintain an index of them by
+		// name, so that lookups and unique name generation don't
+		// require a linear search of m_children.
+		struct ChildIndex;
+		boost::scoped_ptr<ChildIndex> m_childIndex;
+
 };
 
 } // namespace Gaffer
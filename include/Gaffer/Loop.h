@@ -38,6 +38,8 @@
 #ifndef GAFFER_LOOP_H
 #define GAFFER_LOOP_H
 
+#include "tbb/concurrent_hash_map.h"
+
 #include "Gaffer/ComputeNode.h"
 #include "Gaffer/NumericPlug.h"
 #include "Gaffer/StringPlug.h"
@@ -105,6 +107,39 @@ class Loop : public BaseType
 		const ValuePlug *ancestorPlug( const ValuePlug *plug, std::vector<IECore::InternedString> &relativeName ) const;
 		const ValuePlug *descendantPlug( const ValuePlug *plug, const std::vector<IECore::InternedString> &relativeName ) const;
 		const ValuePlug *sourcePlug( const ValuePlug *output, const Context *context, int &sourceLoopIndex, IECore::InternedString &indexVariable ) const;
+		// Evaluates `plug` for each loop index in [0, index] in turn, holding
+		// the result of each iteration so that the next one can use it directly
+		// rather than recursing through every earlier iteration. The result of
+		// the final iteration is returned via `hash` and/or `value`, and values
+		// are only computed if `value` is non-null.
+		void evaluateIterations( const ValuePlug *plug, const Context *context, int index, const IECore::InternedString &indexVariable, IECore::MurmurHash *hash, IECore::ConstObjectPtr *value ) const;
+
+		// Results held by evaluateIterations(), keyed by the plug and the
+		// context they were evaluated in. Each entry is counted so that
+		// concurrent evaluations of the same iteration can share it.
+		struct HeldIteration
+		{
+			HeldIteration() : all( false ), holders( 0 ) {}
+			IECore::MurmurHash hash;
+			IECore::ConstObjectPtr value;
+			// The context variables accessed in evaluating the hash.
+			bool all;
+			std::vector<IECore::InternedString> dependencies;
+			int holders;
+		};
+		typedef tbb::concurrent_hash_map<IECore::MurmurHash, HeldIteration> HeldIterations;
+		mutable HeldIterations m_heldIterations;
+
+		static IECore::MurmurHash heldIterationKey( const ValuePlug *plug, const Context *context );
+		void holdIteration( const IECore::MurmurHash &key, const HeldIteration &iteration ) const;
+		// Adds a holder to an existing entry, returning false if there is
+		// no such entry, or if it has no value and `needValue` is true.
+		bool acquireIteration( const IECore::MurmurHash &key, bool needValue ) const;
+		void releaseIteration( const IECore::MurmurHash &key ) const;
+		// Returns true if a held result for `plug` in `context` was found,
+		// filling in `hash` and/or `value` where they are non-null, and
+		// recording the context variables the result depends on.
+		bool heldIteration( const ValuePlug *plug, const Context *context, IECore::MurmurHash *hash, IECore::ConstObjectPtr *value ) const;
 
 		IE_CORE_DECLARERUNTIMETYPEDDESCRIPTION( Loop<BaseType> );
 
@@ -189,10 +189,20 @@ void Loop<BaseType>::hash( const ValuePlug *output, const Context *context, IECo
 	{
 		if( index >= 0 )
 		{
-			ContextPtr tmpContext = new Context( *context, Context::Borrowed );
-			tmpContext->set<int>( indexVariable, index );
-			Context::Scope scopedContext( tmpContext.get() );
-			h = plug->hash();
+			std::vector<IECore::InternedString> relativeName;
+			if( ancestorPlug( output, relativeName ) == outPlugInternal() )
+			{
+				evaluateIterations( plug, context, index, indexVariable, &h, NULL );
+			}
+			else
+			{
+				Context::EditableScope scope( context );
+				scope.set<int>( indexVariable, index );
+				if( !heldIteration( plug, Context::current(), &h, NULL ) )
+				{
+					h = plug->hash();
+				}
+			}
 		}
 		else
 		{
@@ -213,10 +223,27 @@ void Loop<BaseType>::compute( ValuePlug *output, const Context *context ) const
 	{
 		if( index >= 0 )
 		{
-			ContextPtr tmpContext = new Context( *context, Context::Borrowed );
-			tmpContext->set<int>( indexVariable, index );
-			Context::Scope scopedContext( tmpContext.get() );
-			output->setFrom( plug );
+			std::vector<IECore::InternedString> relativeName;
+			if( ancestorPlug( output, relativeName ) == outPlugInternal() )
+			{
+				IECore::ConstObjectPtr value;
+				evaluateIterations( plug, context, index, indexVariable, NULL, &value );
+				output->setObjectValue( value );
+			}
+			else
+			{
+				Context::EditableScope scope( context );
+				scope.set<int>( indexVariable, index );
+				IECore::ConstObjectPtr value;
+				if( heldIteration( plug, Context::current(), NULL, &value ) )
+				{
+					output->setObjectValue( value );
+				}
+				else
+				{
+					output->setFrom( plug );
+				}
+			}
 		}
 		else
 		{
@@ -396,4 +423,196 @@ const ValuePlug *Loop<BaseType>::sourcePlug( const ValuePlug *output, const Cont
 	return NULL;
 }
 
+template<typename BaseType>
+void Loop<BaseType>::evaluateIterations( const ValuePlug *plug, const Context *context, int index, const IECore::InternedString &indexVariable, IECore::MurmurHash *hash, IECore::ConstObjectPtr *value ) const
+{
+	// Left to itself, evaluating iteration N recurses through the previous
+	// plug into iteration N-1 and so on, using stack proportional to the
+	// number of iterations. Walking the iterations from the bottom up instead,
+	// and holding the result of each one for use by the next, keeps the
+	// recursion depth constant. We don't rely on the hash and compute caches
+	// for this, because they may have evicted the previous iteration by the
+	// time it is needed. Only the most recent iteration is held at any time.
+	Context::EditableScope scope( context );
+
+	// If a concurrent walk is holding the iteration itself, we can use it
+	// directly, and if it is holding the previous iteration, we can share
+	// that rather than walk all the iterations before it.
+	scope.set<int>( indexVariable, index );
+	if( heldIteration( plug, Context::current(), hash, value ) )
+	{
+		return;
+	}
+
+	int first = 0;
+	IECore::MurmurHash heldKey;
+	bool holding = false;
+	if( index > 0 )
+	{
+		scope.set<int>( indexVariable, index - 1 );
+		heldKey = heldIterationKey( plug, Context::current() );
+		if( acquireIteration( heldKey, value != NULL ) )
+		{
+			first = index;
+			holding = true;
+		}
+	}
+
+	try
+	{
+		for( int i = first; i <= index; ++i )
+		{
+			scope.set<int>( indexVariable, i );
+			if( i == index )
+			{
+				const IECore::MurmurHash h = plug->hash();
+				if( hash )
+				{
+					*hash = h;
+				}
+				if( value )
+				{
+					*value = plug->getObjectValue( &h );
+				}
+				break;
+			}
+
+			// Record the context variables the iteration depends on, so
+			// they can be recorded again each time the held result is
+			// used in place of evaluating the plug.
+			HeldIteration iteration;
+			{
+				Context::AccessRecorder recorder;
+				iteration.hash = plug->hash();
+				iteration.all = recorder.all();
+				if( !iteration.all )
+				{
+					iteration.dependencies.assign( recorder.names().begin(), recorder.names().end() );
+				}
+			}
+			if( value )
+			{
+				iteration.value = plug->getObjectValue( &iteration.hash );
+			}
+
+			const IECore::MurmurHash key = heldIterationKey( plug, Context::current() );
+			holdIteration( key, iteration );
+			if( holding )
+			{
+				releaseIteration( heldKey );
+			}
+			heldKey = key;
+			holding = true;
+		}
+	}
+	catch( ... )
+	{
+		if( holding )
+		{
+			releaseIteration( heldKey );
+		}
+		throw;
+	}
+
+	if( holding )
+	{
+		releaseIteration( heldKey );
+	}
+}
+
+template<typename BaseType>
+IECore::MurmurHash Loop<BaseType>::heldIterationKey( const ValuePlug *plug, const Context *context )
+{
+	// We key on the whole context, but we don't want that to record a
+	// dependency on all variables. Instead, heldIteration() records the
+	// dependencies of the iteration itself.
+	Context::AccessRecorder::Scope recorderScope( NULL );
+	IECore::MurmurHash result = context->hash();
+	result.append( (uint64_t)plug );
+	return result;
+}
+
+template<typename BaseType>
+void Loop<BaseType>::holdIteration( const IECore::MurmurHash &key, const HeldIteration &iteration ) const
+{
+	typename HeldIterations::accessor a;
+	if( m_heldIterations.insert( a, key ) )
+	{
+		a->second = iteration;
+	}
+	else if( !a->second.value )
+	{
+		a->second.value = iteration.value;
+	}
+	a->second.holders++;
+}
+
+template<typename BaseType>
+bool Loop<BaseType>::acquireIteration( const IECore::MurmurHash &key, bool needValue ) const
+{
+	if( m_heldIterations.empty() )
+	{
+		return false;
+	}
+
+	typename HeldIterations::accessor a;
+	if( !m_heldIterations.find( a, key ) || ( needValue && !a->second.value ) )
+	{
+		return false;
+	}
+	a->second.holders++;
+	return true;
+}
+
+template<typename BaseType>
+void Loop<BaseType>::releaseIteration( const IECore::MurmurHash &key ) const
+{
+	typename HeldIterations::accessor a;
+	if( m_heldIterations.find( a, key ) && --(a->second.holders) == 0 )
+	{
+		m_heldIterations.erase( a );
+	}
+}
+
+template<typename BaseType>
+bool Loop<BaseType>::heldIteration( const ValuePlug *plug, const Context *context, IECore::MurmurHash *hash, IECore::ConstObjectPtr *value ) const
+{
+	if( m_heldIterations.empty() )
+	{
+		return false;
+	}
+
+	typename HeldIterations::const_accessor a;
+	if( !m_heldIterations.find( a, heldIterationKey( plug, context ) ) )
+	{
+		return false;
+	}
+
+	if( value )
+	{
+		if( !a->second.value )
+		{
+			// Held by a walk which only evaluated hashes.
+			return false;
+		}
+		*value = a->second.value;
+	}
+	if( hash )
+	{
+		*hash = a->second.hash;
+	}
+
+	// Record the accesses that evaluating the plug would have made.
+	if( a->second.all )
+	{
+		context->hash();
+	}
+	else
+	{
+		context->hash( a->second.dependencies );
+	}
+
+	return true;
+}
+
 } // namespace Gaffer
@@ -81,6 +81,7 @@ class MatchPatternPathFilter : public Gaffer::PathFilter
 		bool remove( PathPtr path ) const;
 
 		std::vector<StringAlgo::MatchPattern> m_patterns;
+		StringAlgo::CompiledMatchPattern m_compiledPatterns;
 		IECore::InternedString m_propertyName;
 		bool m_leafOnly;
 		bool m_inverted;
@@ -66,6 +66,16 @@ enum PerformanceMetric
 std::string formatStatistics( const PerformanceMonitor &monitor, size_t maxLinesPerMetric = 50 );
 std::string formatStatistics( const PerformanceMonitor &monitor, PerformanceMetric metric, size_t maxLines = 50 );
 
+/// Formats the events recorded by a monitor constructed with
+/// `recordEvents = true` as JSON in the Chrome trace event format,
+/// suitable for loading into `chrome://tracing` and similar viewers.
+std::string formatChromeTrace( const PerformanceMonitor &monitor );
+/// Formats the events recorded by a monitor constructed with
+/// `recordEvents = true` as the "folded stacks" used as input to
+/// flame graph generators. Each line contains a stack of processes
+/// followed by the time in nanoseconds spent in the innermost one.
+std::string formatFlameGraph( const PerformanceMonitor &monitor );
+
 } // namespace MonitorAlgo
 
 /// \todo Remove this temporary backwards compatibility.
@@ -66,6 +66,7 @@ class Node : public GraphComponent
 
 		typedef boost::signal<void (Plug *)> UnaryPlugSignal;
 		typedef boost::signal<void (Plug *, Plug *)> BinaryPlugSignal;
+		typedef boost::signal<void (const std::vector<Plug *> &)> PlugVectorSignal;
 
 		/// @name Plug signals
 		/// These signals are emitted on events relating to child Plugs
@@ -106,6 +107,13 @@ class Node : public GraphComponent
 		/// onto an input plug of a plain Node (and potentially onwards if that plug
 		/// has its own output connections).
 		UnaryPlugSignal &plugDirtiedSignal();
+		/// Emitted once per dirty propagation with all the plugs of this node
+		/// which were dirtied, in the order in which plugDirtiedSignal() was
+		/// emitted for them. This is emitted after plugDirtiedSignal() has been
+		/// emitted for every plug, and carries the same restrictions. Observers
+		/// which would otherwise connect to plugDirtiedSignal() for every node
+		/// should prefer this signal, since it is emitted far less often.
+		PlugVectorSignal &plugsDirtiedSignal();
 		/// Emitted when the flags are changed for a plug of this node.
 		UnaryPlugSignal &plugFlagsChangedSignal();
 		//@}
@@ -182,6 +190,7 @@ class Node : public GraphComponent
 		UnaryPlugSignal m_plugInputChangedSignal;
 		UnaryPlugSignal m_plugFlagsChangedSignal;
 		UnaryPlugSignal m_plugDirtiedSignal;
+		PlugVectorSignal m_plugsDirtiedSignal;
 		ErrorSignal m_errorSignal;
 
 };
@@ -37,14 +37,17 @@
 #ifndef GAFFER_PERFORMANCEMONITOR_H
 #define GAFFER_PERFORMANCEMONITOR_H
 
-#include <stack>
+#include <vector>
 
 #include "tbb/enumerable_thread_specific.h"
+#include "tbb/atomic.h"
 
 #include "boost/unordered_map.hpp"
 #include "boost/chrono.hpp"
+#include "boost/cstdint.hpp"
 
 #include "IECore/RefCounted.h"
+#include "IECore/InternedString.h"
 
 #include "Gaffer/Monitor.h"
 
@@ -55,12 +58,29 @@ IE_CORE_FORWARDDECLARE( Plug )
 
 /// A monitor which collects statistics about the frequency
 /// and duration of hash and compute processes per plug.
+/// Optionally it may also record a timeline of the individual
+/// processes on each thread, suitable for export to a trace
+/// viewer via the MonitorAlgo functions.
+///
+/// Statistics are accumulated into thread local storage without
+/// locking, and are only merged when they are queried. To further
+/// reduce overhead when monitoring production workloads, a
+/// `sampleInterval` greater than 1 may be specified, in which case
+/// only one in every `sampleInterval` processes on each thread is
+/// timed. The sampled process is chosen at random from each block
+/// of `sampleInterval` processes, so that the sampling can't alias
+/// with regular patterns in the work being monitored. Counts remain
+/// exact, but durations become estimates - the durations of the
+/// sampled processes are scaled by the interval, and time spent in
+/// unsampled processes is excluded from their ancestors. Likewise, only sampled processes are recorded
+/// as events. The overhead of each mode may be measured using
+/// `GafferTest::testPerformanceMonitorOverhead()`.
 class PerformanceMonitor : public Monitor
 {
 
 	public :
 
-		PerformanceMonitor();
+		PerformanceMonitor( bool recordEvents = false, size_t sampleInterval = 1 );
 		virtual ~PerformanceMonitor();
 
 		struct Statistics
@@ -90,6 +110,38 @@ class PerformanceMonitor : public Monitor
 		const StatisticsMap &allStatistics() const;
 		const Statistics &plugStatistics( const Plug *plug ) const;
 
+		/// A record of a single hash or compute process, as captured
+		/// when the monitor was constructed with `recordEvents = true`.
+		/// Times are measured relative to the construction of the monitor.
+		struct Event
+		{
+
+			ConstPlugPtr plug;
+			IECore::InternedString type;
+			/// The value of `Process::id()` for the process.
+			size_t processId;
+			/// The id of the nearest ancestor hash or compute
+			/// process, or 0 if there was none.
+			size_t parentProcessId;
+			/// A small index identifying the thread the process
+			/// ran on. Indices are unique to this monitor, and are
+			/// allocated in the order that threads are first seen.
+			size_t thread;
+			boost::chrono::nanoseconds start;
+			boost::chrono::nanoseconds end;
+
+		};
+
+		typedef std::vector<Event> Events;
+
+		bool getRecordEvents() const;
+		size_t getSampleInterval() const;
+
+		/// Returns all the events recorded so far, sorted by
+		/// start time. Events are only recorded once their process
+		/// has finished.
+		const Events &events() const;
+
 	protected :
 
 		virtual void processStarted( const Process *process );
@@ -101,22 +153,65 @@ class PerformanceMonitor : public Monitor
 		// thread local storage while computations are running.
 		struct ThreadData
 		{
+			ThreadData();
 			// Stores the per-plug statistics captured by this thread.
 			StatisticsMap statistics;
+			// Fixed size direct-mapped cache of entries in the statistics
+			// map, keyed by raw pointer. This spares us from hashing and
+			// reference counting a ConstPlugPtr for every process. Entries
+			// remain valid because the map never moves its elements and
+			// holds a reference to each plug.
+			struct CacheEntry
+			{
+				const Plug *plug;
+				Statistics *statistics;
+			};
+			static const size_t cacheSize = 256;
+			CacheEntry cache[cacheSize];
+			Statistics &plugStatistics( const Plug *plug );
+			void clearStatistics();
 			// Stack of durations pointing into the statistics map.
 			// The top of the stack is the duration we're billing the
-			// current chunk of time to.
-			typedef std::stack<boost::chrono::nanoseconds *> DurationStack;
-			DurationStack durationStack;
+			// current chunk of time to. Unsampled processes bill to
+			// NULL, and if they interrupted a timed parent, they record
+			// that they paused it so it can be resumed when they finish.
+			struct StackEntry
+			{
+				boost::chrono::nanoseconds *duration;
+				bool sampled;
+				bool pausedParent;
+			};
+			std::vector<StackEntry> durationStack;
 			// The last time measurement we made.
 			boost::chrono::high_resolution_clock::time_point then;
+			// Sampling state. Processes are considered in blocks of
+			// `sampleInterval`, with a single randomly chosen process
+			// from each block being sampled.
+			bool sample( size_t sampleInterval );
+			size_t blockPosition;
+			size_t sampledPosition;
+			boost::uint32_t randomState;
+			// Events for processes which are still running, and those
+			// which have completed. Only used when recording events.
+			Events pendingEvents;
+			Events events;
+			// Index used to identify this thread in events, or -1
+			// if not yet allocated.
+			size_t thread;
 		};
 
 		tbb::enumerable_thread_specific<ThreadData, tbb::cache_aligned_allocator<ThreadData>, tbb::ets_key_per_instance> m_threadData;
 
-		// Then when we want to query it, we collate it into m_statistics.
+		const bool m_recordEvents;
+		const size_t m_sampleInterval;
+		const boost::chrono::high_resolution_clock::time_point m_startTime;
+		tbb::atomic<size_t> m_threadCount;
+
+		// Then when we want to query it, we collate it into m_statistics
+		// and m_events.
 		void collate() const;
 		mutable StatisticsMap m_statistics;
+		mutable Events m_events;
 
 };
 
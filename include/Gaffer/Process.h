@@ -69,16 +69,46 @@ class Process : public boost::noncopyable
 		const Plug *plug() const { return m_plug; }
 
 		/// Returns the parent process for this process - that
-		/// is, the process that invoked this one.
-		/// \todo Currently this does not track parent/child
-		/// relationships correctly when a parent process spawns
-		/// child processes on separate threads.
+		/// is, the process that invoked this one. This may be
+		/// running on a different thread, provided that the
+		/// code which spawned the work used a Process::Scope
+		/// to transfer it.
 		const Process *parent() const { return m_parent; }
 
+		/// Returns an identifier for this process, unique for
+		/// the lifetime of the application. Unlike the address
+		/// of the process, this may be used to identify it after
+		/// it has completed, allowing monitors to reconstruct the
+		/// process tree from recorded parent/child ids.
+		size_t id() const { return m_id; }
+
 		/// Returns the Process currently being performed on
 		/// this thread, or NULL if there is no such process.
 		static const Process *current();
 
+		/// Makes a process current for the calling thread, so that
+		/// it becomes the parent of any processes started on that
+		/// thread. Code which spawns TBB tasks from within a process
+		/// should capture `Process::current()` and use a Scope in
+		/// each task, in the same way as it does for Context::current().
+		class Scope : boost::noncopyable
+		{
+
+			public :
+
+				/// It is valid to pass a NULL process, in which case
+				/// `Process::current()` returns NULL until the Scope
+				/// is destroyed, and any processes started within it
+				/// have no parent.
+				Scope( const Process *process );
+				~Scope();
+
+			private :
+
+				const Plug *m_previousErrorSource;
+
+		};
+
 	protected :
 
 		/// Protected constructor for use by derived classes only.
@@ -111,6 +141,7 @@ class Process : public boost::noncopyable
 		const Plug *m_plug;
 		const Plug *m_downstream;
 		const Process *m_parent;
+		size_t m_id;
 		ThreadData *m_threadData;
 
 		static tbb::enumerable_thread_specific<ThreadData, tbb::cache_aligned_allocator<Process::ThreadData>, tbb::ets_key_per_instance> g_threadData;
@@ -60,6 +60,7 @@ IE_CORE_FORWARDDECLARE( Context );
 IE_CORE_FORWARDDECLARE( StandardSet );
 IE_CORE_FORWARDDECLARE( CompoundDataPlug );
 IE_CORE_FORWARDDECLARE( StringPlug );
+IE_CORE_FORWARDDECLARE( ThreadBudget );
 
 typedef Container<GraphComponent, ScriptNode> ScriptContainer;
 IE_CORE_DECLAREPTR( ScriptContainer );
@@ -221,6 +222,14 @@ class ScriptNode : public Node
 		/// in the context.
 		CompoundDataPlug *variablesPlug();
 		const CompoundDataPlug *variablesPlug() const;
+		/// Limits the threads used by background work performed on behalf
+		/// of the script, such as interactive render updates and tasks run by
+		/// the execute app. This is a property of the host process rather than
+		/// the script, so it is not serialised. Defaults to NULL, meaning that
+		/// no limit other than the application's own is imposed.
+		void setThreadBudget( ThreadBudgetPtr threadBudget );
+		ThreadBudget *getThreadBudget();
+		const ThreadBudget *getThreadBudget() const;
 		//@}
 
 		//! @name Frame range
@@ -290,6 +299,7 @@ class ScriptNode : public Node
 		// =================
 
 		ContextPtr m_context;
+		ThreadBudgetPtr m_threadBudget;
 
 		void plugSet( Plug *plug );
 
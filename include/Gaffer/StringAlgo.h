@@ -39,6 +39,7 @@
 #define GAFFER_STRINGALGO_H
 
 #include <string>
+#include <vector>
 
 namespace Gaffer
 {
@@ -64,6 +65,56 @@ inline bool match( const char *s, const char *pattern );
 inline bool matchMultiple( const std::string &s, const MatchPattern &patterns );
 inline bool matchMultiple( const char *s, const char *patterns );
 
+/// A MatchPattern which has been preprocessed for repeated matching. Literal
+/// prefixes and suffixes are tested with direct comparisons, and the literal
+/// sections between wildcards are located with a substring search rather than
+/// by backtracking. Several patterns may be compiled together, in which case
+/// a string matches if it matches any one of them, and all are tested in a
+/// single call. Prefer this to match() when the same patterns are tested
+/// against many strings.
+class CompiledMatchPattern
+{
+
+	public :
+
+		/// Matches nothing.
+		CompiledMatchPattern();
+		/// Matches as match() would. If `multiple` is true, the pattern is
+		/// treated as a space separated list of patterns, as for matchMultiple().
+		explicit CompiledMatchPattern( const MatchPattern &pattern, bool multiple = false );
+		/// Matches strings which match any of the patterns.
+		explicit CompiledMatchPattern( const std::vector<MatchPattern> &patterns );
+
+		inline bool match( const std::string &s ) const;
+		inline bool match( const char *s ) const;
+		inline bool match( const char *s, size_t length ) const;
+
+	private :
+
+		void addPattern( const char *begin, const char *end );
+
+		struct Pattern
+		{
+			// When `wildcard` is false, the pattern is matched
+			// exactly, and is stored entirely in `prefix`.
+			bool wildcard;
+			std::string prefix;
+			std::string suffix;
+			// Literal sections between wildcards, in order.
+			std::vector<std::string> infixes;
+			size_t minLength;
+
+			inline bool match( const char *s, size_t length ) const;
+		};
+
+		std::vector<Pattern> m_patterns;
+
+};
+
+/// Returns true if the string matches the compiled pattern and false otherwise.
+inline bool match( const std::string &s, const CompiledMatchPattern &pattern );
+inline bool match( const char *s, const CompiledMatchPattern &pattern );
+
 /// Returns true if the specified pattern contains characters which
 /// have special meaning to the match() function.
 inline bool hasWildcards( const MatchPattern &pattern );
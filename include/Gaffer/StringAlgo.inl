@@ -40,78 +40,87 @@
 
 #include <string.h>
 
+#include <algorithm>
+
 namespace Gaffer
 {
 
 namespace Detail
 {
 
-inline bool matchInternal( const char * const ss, const char *pattern, bool multiple = false )
+// Matches a single pattern, which ends either at '\0' or at
+// `terminator`. Consecutive wildcards are equivalent to a single
+// one, and a wildcard may match an empty remainder.
+inline bool matchPattern( const char *s, const char *pattern, char terminator )
 {
 	char c;
-	const char *s = ss;
 	while( true )
 	{
-		switch( c = *pattern++ )
+		c = *pattern++;
+		if( c == '\0' || c == terminator )
 		{
-			case '\0' :
-
-				return *s == c;
+			return *s == '\0';
+		}
+		else if( c == '*' )
+		{
+			while( *pattern == '*' )
+			{
+				pattern++;
+			}
 
-			case '*' :
+			if( *pattern == '\0' || *pattern == terminator )
+			{
+				// optimisation for when pattern
+				// ends with '*'.
+				return true;
+			}
 
-				if( *pattern == '\0' || ( multiple && *pattern == ' ' ) )
+			// general case - recurse.
+			while( true )
+			{
+				if( matchPattern( s, pattern, terminator ) )
 				{
-					// optimisation for when pattern
-					// ends with '*'.
 					return true;
 				}
-
-				// general case - recurse.
-				while( *s != '\0' )
+				if( *s == '\0' )
 				{
-					if( matchInternal( s, pattern, multiple ) )
-					{
-						return true;
-					}
-					s++;
+					return false;
 				}
-				return false;
+				s++;
+			}
+		}
+		else if( c == *s )
+		{
+			s++;
+		}
+		else
+		{
+			return false;
+		}
+	}
+}
 
-			default :
+inline bool matchInternal( const char *s, const char *pattern, bool multiple = false )
+{
+	if( !multiple )
+	{
+		return matchPattern( s, pattern, '\0' );
+	}
 
-				if( c == *s )
-				{
-					s++;
-				}
-				else if( !multiple )
-				{
-					return false;
-				}
-				else
-				{
-					if( c == ' ' && *s == '\0' )
-					{
-						// space terminates sub-patterns, so we've
-						// found a match.
-						return true;
-					}
-					else
-					{
-						// no match in this pattern. reset to start
-						// of string, and advance to next pattern.
-						s = ss;
-						while( c != ' ' )
-						{
-							if( c == '\0' )
-							{
-								return false;
-							}
-							c = *pattern++;
-						}
-					}
-				}
+	// Each sub-pattern is matched against the whole
+	// string, independently of any that failed before it.
+	while( true )
+	{
+		if( matchPattern( s, pattern, ' ' ) )
+		{
+			return true;
 		}
+		pattern = strchr( pattern, ' ' );
+		if( !pattern )
+		{
+			return false;
+		}
+		pattern++;
 	}
 }
 
@@ -140,6 +149,78 @@ inline bool matchMultiple( const char *s, const char *patterns )
 	return Detail::matchInternal( s, patterns, /* multiple = */ true );
 }
 
+inline bool CompiledMatchPattern::match( const std::string &s ) const
+{
+	return match( s.c_str(), s.size() );
+}
+
+inline bool CompiledMatchPattern::match( const char *s ) const
+{
+	return match( s, strlen( s ) );
+}
+
+inline bool CompiledMatchPattern::match( const char *s, size_t length ) const
+{
+	for( std::vector<Pattern>::const_iterator it = m_patterns.begin(), eIt = m_patterns.end(); it != eIt; ++it )
+	{
+		if( it->match( s, length ) )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+inline bool CompiledMatchPattern::Pattern::match( const char *s, size_t length ) const
+{
+	if( !wildcard )
+	{
+		return length == prefix.size() && memcmp( s, prefix.c_str(), length ) == 0;
+	}
+
+	if( length < minLength )
+	{
+		return false;
+	}
+
+	if( memcmp( s, prefix.c_str(), prefix.size() ) != 0 )
+	{
+		return false;
+	}
+
+	const char *end = s + length - suffix.size();
+	if( memcmp( end, suffix.c_str(), suffix.size() ) != 0 )
+	{
+		return false;
+	}
+
+	// Because "*" is the only wildcard, taking the first
+	// occurrence of each infix can never prevent a match
+	// that a later occurrence would have allowed.
+	const char *c = s + prefix.size();
+	for( std::vector<std::string>::const_iterator it = infixes.begin(), eIt = infixes.end(); it != eIt; ++it )
+	{
+		c = std::search( c, end, it->begin(), it->end() );
+		if( c == end )
+		{
+			return false;
+		}
+		c += it->size();
+	}
+
+	return true;
+}
+
+inline bool match( const std::string &s, const CompiledMatchPattern &pattern )
+{
+	return pattern.match( s );
+}
+
+inline bool match( const char *s, const CompiledMatchPattern &pattern )
+{
+	return pattern.match( s );
+}
+
 inline bool hasWildcards( const std::string &pattern )
 {
 	return hasWildcards( pattern.c_str() );
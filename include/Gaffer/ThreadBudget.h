@@ -0,0 +1,147 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2016, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef GAFFER_THREADBUDGET_H
+#define GAFFER_THREADBUDGET_H
+
+#include "tbb/task_arena.h"
+
+#include "IECore/RefCounted.h"
+
+#include "Gaffer/Context.h"
+#include "Gaffer/Process.h"
+
+namespace Gaffer
+{
+
+/// Limits the number of threads available to a body of work, such as the
+/// computations for a particular ScriptNode. Work is run in a dedicated
+/// tbb::task_arena, so parallel algorithms launched from within it are
+/// confined to the budget, and can't occupy every thread in the process.
+/// Note that this is a cap and not a reservation : the arena's worker
+/// threads are drawn from the process-wide pool as they become free, so
+/// the work may still have to wait for threads busy elsewhere.
+class ThreadBudget : public IECore::RefCounted
+{
+
+	public :
+
+		/// A value of 0 for maxThreads causes the number
+		/// of threads to be chosen automatically.
+		ThreadBudget( int maxThreads = 0 );
+		virtual ~ThreadBudget();
+
+		IE_CORE_DECLAREMEMBERPTR( ThreadBudget )
+
+		int maxThreads() const;
+
+		/// Calls `f()` within the budget, and waits for it to complete.
+		/// The call is made with the caller's current Context, Process
+		/// and Context::AccessRecorder, but may be made on a different
+		/// thread. Any exception thrown by `f()` is propagated to the
+		/// caller.
+		template<typename F>
+		void execute( const F &f );
+
+		/// As above, but simply calls `f()` directly if
+		/// budget is NULL.
+		template<typename F>
+		static void execute( ThreadBudget *budget, const F &f );
+
+	private :
+
+		template<typename F>
+		struct ScopedCall;
+
+		const int m_maxThreads;
+		tbb::task_arena m_arena;
+
+};
+
+template<typename F>
+struct ThreadBudget::ScopedCall
+{
+
+	ScopedCall( const F &f )
+		:	m_f( f ),
+			m_context( Context::current() ),
+			m_process( Process::current() ),
+			m_accessRecorder( Context::AccessRecorder::current() )
+	{
+	}
+
+	void operator()() const
+	{
+		Context::Scope scopedContext( m_context );
+		Process::Scope scopedProcess( m_process );
+		Context::AccessRecorder::Scope scopedAccessRecorder( m_accessRecorder );
+		m_f();
+	}
+
+	private :
+
+		const F &m_f;
+		const Context *m_context;
+		const Process *m_process;
+		Context::AccessRecorder *m_accessRecorder;
+
+};
+
+template<typename F>
+void ThreadBudget::execute( const F &f )
+{
+	m_arena.execute( ScopedCall<F>( f ) );
+}
+
+template<typename F>
+void ThreadBudget::execute( ThreadBudget *budget, const F &f )
+{
+	if( budget )
+	{
+		budget->execute( f );
+	}
+	else
+	{
+		f();
+	}
+}
+
+IE_CORE_DECLAREPTR( ThreadBudget );
+
+} // namespace Gaffer
+
+#endif // GAFFER_THREADBUDGET_H
@@ -38,15 +38,24 @@
 #ifndef GAFFER_VALUEPLUG_H
 #define GAFFER_VALUEPLUG_H
 
+#include <map>
+
 #include "IECore/Object.h"
 
 #include "Gaffer/Plug.h"
+#include "Gaffer/Future.h"
 
 namespace Gaffer
 {
 
 IE_CORE_FORWARDDECLARE( DependencyNode )
 
+template<typename BaseType>
+class Loop;
+
+template<typename T>
+class TypedObjectPlug;
+
 /// The Plug base class defines the concept of a connection
 /// point with direction. The ValuePlug class extends this concept
 /// to allow the connections to pass values between connection
@@ -99,6 +108,10 @@ class ValuePlug : public Plug
 		virtual IECore::MurmurHash hash() const;
 		/// Convenience function to append the hash to h.
 		void hash( IECore::MurmurHash &h ) const;
+		/// Launches hash() on the TBB thread pool, returning a Future
+		/// for the result. See getValueAsync() for the constraints on
+		/// its use.
+		Future<IECore::MurmurHash>::Ptr hashAsync() const;
 
 		/// @name Cache management
 		/// ValuePlug optimises repeated computation by storing a cache of
@@ -106,16 +119,117 @@ class ValuePlug : public Plug
 		/// of the cache.
 		////////////////////////////////////////////////////////////////////
 		//@{
+		/// Policies for caching the results of computations. A policy is
+		/// chosen for each output plug by ComputeNode::computeCachePolicy().
+		enum CachePolicy
+		{
+			/// Neither hashes nor values are cached, so every request
+			/// results in calls to ComputeNode::hash() and ComputeNode::compute().
+			Uncached,
+			/// Hashes are cached but values are never stored, so every
+			/// request for a value results in a call to ComputeNode::compute().
+			/// Suitable for values which are trivially cheap to recompute,
+			/// such as pass-throughs, so that they don't evict more
+			/// expensive values from the cache.
+			HashOnly,
+			/// Hashes and values are cached. When several threads request
+			/// the same uncached value concurrently, each computes it
+			/// independently.
+			Standard,
+			/// As for Standard, but when several threads request the same
+			/// uncached value concurrently, only the first computes it. The
+			/// others wait for the result, helping to execute any TBB tasks
+			/// spawned by the computation. This carries some additional
+			/// overhead, so should be reserved for expensive computes.
+			TaskCollaboration
+		};
+
 		/// Returns the maximum amount of memory in bytes to use for the cache.
 		static size_t getCacheMemoryLimit();
 		/// Sets the maximum amount of memory the cache may use in bytes.
 		static void setCacheMemoryLimit( size_t bytes );
-		/// Returns the current memory usage of the cache in bytes.
+		/// Returns the current memory usage of the cache in bytes. Buffers
+		/// shared between several cached values are only counted once.
 		static size_t cacheMemoryUsage();
+		typedef std::map<std::string, size_t> CacheMemoryUsageByPlug;
+		/// Returns a breakdown of cacheMemoryUsage(), mapping from the full
+		/// name of each plug to the memory used by the values it computed.
+		/// Buffers which are still shared by cached values after the value
+		/// originally charged for them has been removed are not included.
+		static CacheMemoryUsageByPlug cacheMemoryUsageByPlug();
 		/// Clears the cache.
 		static void clearCache();
 		//@}
 
+		/// @name Persistent cache management
+		/// Computed values may also be stored in a persistent cache on disk,
+		/// so that they can be reused by subsequent processes, such as other
+		/// tasks running on a render farm. Only values for plugs where
+		/// ComputeNode::persistentCacheable() returns true are stored. The
+		/// persistent cache is disabled by default, and may be enabled either
+		/// by calling setPersistentCacheDirectory() or by setting the
+		/// GAFFER_PERSISTENT_CACHE_DIRECTORY environment variable.
+		///
+		/// > Caution : Values are reused for as long as their hash remains
+		/// > the same, so files read by nodes such as the SceneReader must
+		/// > not be modified in place while the cache is in use.
+		////////////////////////////////////////////////////////////////////
+		//@{
+		/// Returns the directory used to store the persistent cache, or
+		/// the empty string if the persistent cache is disabled.
+		static std::string getPersistentCacheDirectory();
+		/// Sets the directory used to store the persistent cache. It may be
+		/// shared by many processes concurrently. Passing the empty string
+		/// disables the persistent cache.
+		static void setPersistentCacheDirectory( const std::string &directory );
+		/// Returns the maximum size in bytes of the files in the persistent cache.
+		static size_t getPersistentCacheSizeLimit();
+		/// Sets the maximum size in bytes of the files in the persistent cache.
+		/// When the limit is exceeded, the least recently used files are removed.
+		static void setPersistentCacheSizeLimit( size_t bytes );
+		/// Removes all values from the persistent cache.
+		static void clearPersistentCache();
+		//@}
+
+		/// @name Hash cache management
+		/// ValuePlug also stores a cache of recently computed hashes, indexed
+		/// by plug and context. This is shared by all threads, and is
+		/// limited to a maximum number of entries, above which the least
+		/// recently used entries are evicted. The context variables accessed
+		/// by each hash are recorded using a Context::AccessRecorder, and
+		/// only those variables contribute to the index, so a hash may be
+		/// shared by all contexts which differ only in other variables.
+		////////////////////////////////////////////////////////////////////
+		//@{
+		/// Returns the maximum number of entries in the hash cache.
+		static size_t getHashCacheSizeLimit();
+		/// Sets the maximum number of entries in the hash cache, evicting
+		/// entries as necessary to meet the new limit.
+		static void setHashCacheSizeLimit( size_t maxEntries );
+		/// Returns the number of entries currently in the hash cache.
+		static size_t hashCacheSize();
+		/// Clears the hash cache.
+		static void clearHashCache();
+
+		struct HashCacheStatistics
+		{
+			HashCacheStatistics();
+			/// Number of hashes retrieved from the cache.
+			size_t hits;
+			/// Number of hashes which had to be computed.
+			size_t misses;
+			/// Number of entries removed from the cache, either to
+			/// meet the size limit or by clearHashCache().
+			size_t evictions;
+		};
+
+		/// Returns the statistics accumulated since the last call to
+		/// resetHashCacheStatistics(). These are useful in choosing an
+		/// appropriate size limit.
+		static HashCacheStatistics hashCacheStatistics();
+		static void resetHashCacheStatistics();
+		//@}
+
 	protected :
 
 		/// This constructor must be used by all derived classes which wish
@@ -164,9 +278,23 @@ class ValuePlug : public Plug
 		class HashProcess;
 		class ComputeProcess;
 		class SetValueAction;
+		class SetValuesAction;
+		class BatchEdits;
+
+		// Loop evaluates its iterations in order using getObjectValue(), and
+		// uses setObjectValue() to reuse the result of the previous iteration.
+		template<typename BaseType>
+		friend class Loop;
 
 		void setValueInternal( IECore::ConstObjectPtr value, bool propagateDirtiness );
 		void childAddedOrRemoved();
+
+		static void pushBatchEditScope();
+		static void popBatchEditScope();
+		// Called by BatchEditScope, which is the public
+		// interface to these methods.
+		friend class BatchEditScope;
+
 		// Emits the appropriate Node::plugSetSignal() for this plug and all its
 		// ancestors, then does the same for its output plugs.
 		void emitPlugSet();
@@ -174,6 +302,9 @@ class ValuePlug : public Plug
 		IECore::ConstObjectPtr m_defaultValue;
 		// For holding the value of input plugs with no input connections.
 		IECore::ConstObjectPtr m_staticValue;
+		// Updated from a global counter each time the plug is dirtied,
+		// and used to index into the hash cache.
+		size_t m_dirtyCount;
 
 };
 
@@ -187,6 +318,70 @@ typedef FilteredRecursiveChildIterator<PlugPredicate<Plug::Invalid, ValuePlug>,
 typedef FilteredRecursiveChildIterator<PlugPredicate<Plug::In, ValuePlug>, PlugPredicate<> > RecursiveInputValuePlugIterator;
 typedef FilteredRecursiveChildIterator<PlugPredicate<Plug::Out, ValuePlug>, PlugPredicate<> > RecursiveOutputValuePlugIterator;
 
+namespace Detail
+{
+
+template<typename PlugType>
+struct GetValueCall
+{
+
+	typedef typename PlugType::ValueType ResultType;
+
+	GetValueCall( const PlugType *plug )
+		:	m_plug( plug )
+	{
+	}
+
+	ResultType operator()() const
+	{
+		return static_cast<const PlugType *>( m_plug.get() )->getValue();
+	}
+
+	private :
+
+		// Held by reference count so that the plug outlives the Future.
+		ConstValuePlugPtr m_plug;
+
+};
+
+template<typename T>
+struct GetValueCall<TypedObjectPlug<T> >
+{
+
+	typedef typename T::ConstPtr ResultType;
+
+	GetValueCall( const TypedObjectPlug<T> *plug )
+		:	m_plug( plug )
+	{
+	}
+
+	ResultType operator()() const
+	{
+		return static_cast<const TypedObjectPlug<T> *>( m_plug.get() )->getValue();
+	}
+
+	private :
+
+		// Held by reference count so that the plug outlives the Future.
+		ConstValuePlugPtr m_plug;
+
+};
+
+} // namespace Detail
+
+/// Launches `plug->getValue()` on the TBB thread pool, returning a Future
+/// for the result. The value is computed in a copy of the current context,
+/// and is shared with synchronous getValue() calls via the usual caches.
+/// The Future keeps the plug alive, but the graph must not be edited until
+/// the Future is done() - use FutureBase::cancel() and FutureBase::wait() to
+/// abandon the work promptly beforehand.
+template<typename PlugType>
+typename Future<typename Detail::GetValueCall<PlugType>::ResultType>::Ptr getValueAsync( const PlugType *plug )
+{
+	typedef Detail::GetValueCall<PlugType> Call;
+	return Future<typename Call::ResultType>::launch( Call( plug ) );
+}
+
 } // namespace Gaffer
 
 #endif // GAFFER_VALUEPLUG_H
@@ -40,6 +40,8 @@
 
 #include "boost/python.hpp"
 
+#include "tbb/atomic.h"
+
 #include "IECorePython/ScopedGILLock.h"
 
 #include "Gaffer/ComputeNode.h"
@@ -62,18 +64,21 @@ class ComputeNodeWrapper : public DependencyNodeWrapper<WrappedType>
 		ComputeNodeWrapper( PyObject *self, const std::string &name )
 			:	DependencyNodeWrapper<WrappedType>( self, name )
 		{
+			initOverrideStates();
 		}
 
 		template<typename Arg1, typename Arg2>
 		ComputeNodeWrapper( PyObject *self, Arg1 arg1, Arg2 arg2 )
 			:	DependencyNodeWrapper<WrappedType>( self, arg1, arg2 )
 		{
+			initOverrideStates();
 		}
 
 		template<typename Arg1, typename Arg2, typename Arg3>
 		ComputeNodeWrapper( PyObject *self, Arg1 arg1, Arg2 arg2, Arg3 arg3 )
 			:	DependencyNodeWrapper<WrappedType>( self, arg1, arg2, arg3 )
 		{
+			initOverrideStates();
 		}
 
 		virtual void hash( const Gaffer::ValuePlug *output, const Gaffer::Context *context, IECore::MurmurHash &h ) const
@@ -129,6 +134,89 @@ class ComputeNodeWrapper : public DependencyNodeWrapper<WrappedType>
 			WrappedType::compute( output, context );
 		}
 
+		virtual Gaffer::ValuePlug::CachePolicy computeCachePolicy( const Gaffer::ValuePlug *output ) const
+		{
+			if( this->isSubclassed() && hasOverride( "computeCachePolicy", m_computeCachePolicyOverride ) )
+			{
+				IECorePython::ScopedGILLock gilLock;
+				try
+				{
+					boost::python::object f = this->methodOverride( "computeCachePolicy" );
+					if( f )
+					{
+						boost::python::object result = f( Gaffer::ValuePlugPtr( const_cast<Gaffer::ValuePlug *>( output ) ) );
+						return boost::python::extract<Gaffer::ValuePlug::CachePolicy>( result );
+					}
+				}
+				catch( const boost::python::error_already_set &e )
+				{
+					ExceptionAlgo::translatePythonException();
+				}
+			}
+			return WrappedType::computeCachePolicy( output );
+		}
+
+		virtual bool persistentCacheable( const Gaffer::ValuePlug *output ) const
+		{
+			if( this->isSubclassed() && hasOverride( "persistentCacheable", m_persistentCacheableOverride ) )
+			{
+				IECorePython::ScopedGILLock gilLock;
+				try
+				{
+					boost::python::object f = this->methodOverride( "persistentCacheable" );
+					if( f )
+					{
+						return boost::python::extract<bool>( f( Gaffer::ValuePlugPtr( const_cast<Gaffer::ValuePlug *>( output ) ) ) );
+					}
+				}
+				catch( const boost::python::error_already_set &e )
+				{
+					ExceptionAlgo::translatePythonException();
+				}
+			}
+			return WrappedType::persistentCacheable( output );
+		}
+
+	private :
+
+		// computeCachePolicy() and persistentCacheable() are queried for
+		// every hash() and getValue(), but are rarely overridden. So we
+		// resolve the existence of each override once, on first use, and
+		// only take the GIL to call it if it exists. Overrides are assumed
+		// not to be added to or removed from the class after that point.
+		enum OverrideState
+		{
+			Unresolved,
+			Absent,
+			Present
+		};
+
+		void initOverrideStates()
+		{
+			m_computeCachePolicyOverride = Unresolved;
+			m_persistentCacheableOverride = Unresolved;
+		}
+
+		bool hasOverride( const char *name, tbb::atomic<int> &state ) const
+		{
+			if( state == Unresolved )
+			{
+				IECorePython::ScopedGILLock gilLock;
+				try
+				{
+					state = this->methodOverride( name ) ? Present : Absent;
+				}
+				catch( const boost::python::error_already_set &e )
+				{
+					ExceptionAlgo::translatePythonException();
+				}
+			}
+			return state == Present;
+		}
+
+		mutable tbb::atomic<int> m_computeCachePolicyOverride;
+		mutable tbb::atomic<int> m_persistentCacheableOverride;
+
 };
 
 } // namespace GafferBindings
@@ -0,0 +1,96 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2016, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef GAFFERBINDINGS_FUTUREBINDING_H
+#define GAFFERBINDINGS_FUTUREBINDING_H
+
+#include "boost/python.hpp"
+
+#include "Gaffer/ValuePlug.h"
+
+namespace GafferBindings
+{
+
+/// Provides Python access to a Gaffer::Future, converting
+/// the result to Python when it is requested.
+class PythonFuture
+{
+
+	public :
+
+		typedef boost::python::object (*ResultFunction)( const Gaffer::FutureBase *future );
+
+		PythonFuture( Gaffer::FutureBasePtr future, ResultFunction resultFunction );
+
+		bool done() const;
+		void wait() const;
+		void cancel();
+		bool cancelled() const;
+		boost::python::object result() const;
+
+	private :
+
+		Gaffer::FutureBasePtr m_future;
+		ResultFunction m_resultFunction;
+
+};
+
+namespace Detail
+{
+
+template<typename T>
+boost::python::object futureResult( const Gaffer::FutureBase *future )
+{
+	return boost::python::object( static_cast<const Gaffer::Future<T> *>( future )->get() );
+}
+
+} // namespace Detail
+
+/// Launches `plug->getValue()` asynchronously, for binding as
+/// the `getValueAsync()` method of a plug class.
+template<typename PlugType>
+PythonFuture getValueAsync( const PlugType *plug )
+{
+	typedef typename Gaffer::Detail::GetValueCall<PlugType>::ResultType ResultType;
+	return PythonFuture( Gaffer::getValueAsync( plug ), &Detail::futureResult<ResultType> );
+}
+
+void bindFuture();
+
+} // namespace GafferBindings
+
+#endif // GAFFERBINDINGS_FUTUREBINDING_H
@@ -40,6 +40,8 @@
 
 #include "IECorePython/ScopedGILRelease.h"
 
+#include "GafferBindings/FutureBinding.h"
+
 namespace GafferBindings
 {
 
@@ -97,6 +99,24 @@ IECore::ObjectPtr getValue( typename T::Ptr p, const IECore::MurmurHash *precomp
 	return NULL;
 }
 
+// The result is copied for the same reasons as in getValue().
+template<typename T>
+boost::python::object futureObjectResult( const Gaffer::FutureBase *future )
+{
+	typename T::ConstValuePtr v = static_cast<const Gaffer::Future<typename T::ConstValuePtr> *>( future )->get();
+	if( v )
+	{
+		return boost::python::object( IECore::ObjectPtr( v->copy() ) );
+	}
+	return boost::python::object();
+}
+
+template<typename T>
+PythonFuture getValueAsync( const T *plug )
+{
+	return PythonFuture( Gaffer::getValueAsync( plug ), &futureObjectResult<T> );
+}
+
 template<typename T>
 typename T::ValuePtr defaultValue( typename T::Ptr p, bool copy )
 {
@@ -143,6 +163,7 @@ TypedObjectPlugClass<T, TWrapper>::TypedObjectPlugClass( const char *docString )
 	this->def( "defaultValue", &Detail::defaultValue<T>, ( boost::python::arg_( "_copy" ) = true ) );
 	this->def( "setValue", Detail::setValue<T>, ( boost::python::arg_( "value" ), boost::python::arg_( "_copy" ) = true ) );
 	this->def( "getValue", Detail::getValue<T>, ( boost::python::arg_( "_precomputedHash" ) = boost::python::object(), boost::python::arg_( "_copy" ) = true ) );
+	this->def( "getValueAsync", &Detail::getValueAsync<T> );
 
 	boost::python::scope s = *this;
 
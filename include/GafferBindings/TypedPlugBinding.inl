@@ -39,6 +39,8 @@
 
 #include "IECorePython/ScopedGILRelease.h"
 
+#include "GafferBindings/FutureBinding.h"
+
 namespace GafferBindings
 {
 
@@ -84,6 +86,7 @@ TypedPlugClass<T, TWrapper>::TypedPlugClass( const char *docString )
 	this->def( "defaultValue", &T::defaultValue, boost::python::return_value_policy<boost::python::copy_const_reference>() );
 	this->def( "setValue", &Detail::setValue<T> );
 	this->def( "getValue", &Detail::getValue<T>, ( boost::python::arg( "_precomputedHash" ) = boost::python::object() ) );
+	this->def( "getValueAsync", &GafferBindings::getValueAsync<T> );
 }
 
 } // namespace GafferBindings
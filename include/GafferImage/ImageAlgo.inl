@@ -41,6 +41,7 @@
 #include "boost/tuple/tuple.hpp"
 
 #include "Gaffer/Context.h"
+#include "Gaffer/Process.h"
 #include "GafferImage/ImagePlug.h"
 #include "GafferImage/BufferAlgo.h"
 
@@ -50,6 +51,16 @@ namespace GafferImage
 namespace Detail
 {
 
+// Rethrows the current exception, for use in a catch block following
+// a parallel loop. TBB may not preserve the type of exceptions thrown by
+// other threads, so we throw Cancelled in place of the exception if
+// the current context has been cancelled.
+inline void rethrow()
+{
+	Gaffer::Canceller::check( Gaffer::Context::current()->canceller() );
+	throw;
+}
+
 template <class ThreadableFunctor>
 class ProcessTiles
 {
@@ -63,7 +74,9 @@ class ProcessTiles
 				m_functor( functor ),
 				m_imagePlug( imagePlug ),
 				m_tilesOrigin( tilesOrigin ),
-				m_parentContext( context )
+				m_parentContext( context ),
+				m_parentProcess( Gaffer::Process::current() ),
+				m_parentAccessRecorder( Gaffer::Context::AccessRecorder::current() )
 		{}
 
 		ProcessTiles(
@@ -77,13 +90,16 @@ class ProcessTiles
 				m_imagePlug( imagePlug ),
 				m_channelNames( channelNames ),
 				m_tilesOrigin( tilesOrigin ),
-				m_parentContext( context )
+				m_parentContext( context ),
+				m_parentProcess( Gaffer::Process::current() ),
+				m_parentAccessRecorder( Gaffer::Context::AccessRecorder::current() )
 		{}
 
 		void operator()( const tbb::blocked_range2d<size_t>& r ) const
 		{
-			Gaffer::ContextPtr context = new Gaffer::Context( *m_parentContext, Gaffer::Context::Borrowed );
-			Gaffer::Context::Scope scope( context.get() );
+			Gaffer::Context::EditableScope scope( m_parentContext );
+			Gaffer::Process::Scope processScope( m_parentProcess );
+			Gaffer::Context::AccessRecorder::Scope accessRecorderScope( m_parentAccessRecorder );
 
 			Imath::V2i tileId;
 			Imath::V2i tileIdMax( r.rows().end(), r.cols().end() );
@@ -93,8 +109,9 @@ class ProcessTiles
 				for( tileId.y = r.cols().begin(); tileId.y < tileIdMax.y; ++tileId.y )
 				{
 					Imath::V2i tileOrigin = m_tilesOrigin + ( tileId * ImagePlug::tileSize() );
-					context->set( ImagePlug::tileOriginContextName, tileOrigin );
+					scope.set( ImagePlug::tileOriginContextName, tileOrigin );
 
+					Gaffer::Canceller::check( m_parentContext->canceller() );
 					m_functor( m_imagePlug, tileOrigin );
 				}
 			}
@@ -102,8 +119,9 @@ class ProcessTiles
 
 		void operator()( const tbb::blocked_range3d<size_t>& r ) const
 		{
-			Gaffer::ContextPtr context = new Gaffer::Context( *m_parentContext, Gaffer::Context::Borrowed );
-			Gaffer::Context::Scope scope( context.get() );
+			Gaffer::Context::EditableScope scope( m_parentContext );
+			Gaffer::Process::Scope processScope( m_parentProcess );
+			Gaffer::Context::AccessRecorder::Scope accessRecorderScope( m_parentAccessRecorder );
 
 			Imath::V2i tileId;
 			Imath::V2i tileIdMax( r.rows().end(), r.cols().end() );
@@ -113,12 +131,13 @@ class ProcessTiles
 				for( tileId.y = r.cols().begin(); tileId.y < tileIdMax.y; ++tileId.y )
 				{
 					Imath::V2i tileOrigin = m_tilesOrigin + ( tileId * ImagePlug::tileSize() );
-					context->set( ImagePlug::tileOriginContextName, tileOrigin );
+					scope.set( ImagePlug::tileOriginContextName, tileOrigin );
 
 					for( size_t channelIndex = r.pages().begin(); channelIndex < r.pages().end(); ++channelIndex )
 					{
-						context->set( ImagePlug::channelNameContextName, m_channelNames[channelIndex] );
+						scope.set( ImagePlug::channelNameContextName, m_channelNames[channelIndex] );
 
+						Gaffer::Canceller::check( m_parentContext->canceller() );
 						m_functor( m_imagePlug, m_channelNames[channelIndex], tileOrigin );
 					}
 				}
@@ -131,6 +150,8 @@ class ProcessTiles
 		const std::vector<std::string> m_channelNames; // Don't declare as a reference, as it may not be set in the constructor
 		const Imath::V2i &m_tilesOrigin;
 		const Gaffer::Context *m_parentContext;
+		const Gaffer::Process *m_parentProcess;
+		Gaffer::Context::AccessRecorder *m_parentAccessRecorder;
 };
 
 class TileInputIterator
@@ -297,7 +318,9 @@ class TileFunctorFilter
 				m_functor( functor ),
 				m_imagePlug( imagePlug ),
 				m_tilesOrigin( tilesOrigin ),
-				m_parentContext( context )
+				m_parentContext( context ),
+				m_parentProcess( Gaffer::Process::current() ),
+				m_parentAccessRecorder( Gaffer::Context::AccessRecorder::current() )
 		{}
 
 		TileFunctorFilter(
@@ -311,17 +334,22 @@ class TileFunctorFilter
 				m_imagePlug( imagePlug ),
 				m_channelNames( channelNames ),
 				m_tilesOrigin( tilesOrigin ),
-				m_parentContext( context )
+				m_parentContext( context ),
+				m_parentProcess( Gaffer::Process::current() ),
+				m_parentAccessRecorder( Gaffer::Context::AccessRecorder::current() )
 		{}
 
 		boost::tuple<size_t, Imath::V2i, typename TileFunctor::Result> operator()( boost::tuple<size_t, Imath::V2i> &it ) const
 		{
-			Gaffer::ContextPtr context = new Gaffer::Context( *m_parentContext, Gaffer::Context::Borrowed );
-			Gaffer::Context::Scope scope( context.get() );
+			Gaffer::Canceller::check( m_parentContext->canceller() );
+
+			Gaffer::Context::EditableScope scope( m_parentContext );
+			Gaffer::Process::Scope processScope( m_parentProcess );
+			Gaffer::Context::AccessRecorder::Scope accessRecorderScope( m_parentAccessRecorder );
 
 			const Imath::V2i tileOrigin = m_tilesOrigin + ( boost::get<1>( it ) * ImagePlug::tileSize() );
-			context->set( ImagePlug::tileOriginContextName, tileOrigin );
-			context->set( ImagePlug::channelNameContextName, m_channelNames[boost::get<0>( it )] );
+			scope.set( ImagePlug::tileOriginContextName, tileOrigin );
+			scope.set( ImagePlug::channelNameContextName, m_channelNames[boost::get<0>( it )] );
 
 			typename TileFunctor::Result result = m_functor( m_imagePlug, m_channelNames[boost::get<0>( it )], tileOrigin );
 
@@ -330,11 +358,14 @@ class TileFunctorFilter
 
 		boost::tuple<Imath::V2i, typename TileFunctor::Result> operator()( boost::tuple<Imath::V2i> &it ) const
 		{
-			Gaffer::ContextPtr context = new Gaffer::Context( *m_parentContext, Gaffer::Context::Borrowed );
-			Gaffer::Context::Scope scope( context.get() );
+			Gaffer::Canceller::check( m_parentContext->canceller() );
+
+			Gaffer::Context::EditableScope scope( m_parentContext );
+			Gaffer::Process::Scope processScope( m_parentProcess );
+			Gaffer::Context::AccessRecorder::Scope accessRecorderScope( m_parentAccessRecorder );
 
 			const Imath::V2i tileOrigin = m_tilesOrigin + ( boost::get<0>( it ) * ImagePlug::tileSize() );
-			context->set( ImagePlug::tileOriginContextName, tileOrigin );
+			scope.set( ImagePlug::tileOriginContextName, tileOrigin );
 
 			typename TileFunctor::Result result = m_functor( m_imagePlug, tileOrigin );
 
@@ -347,6 +378,8 @@ class TileFunctorFilter
 		const std::vector<std::string> m_channelNames; // Don't declare as a reference, as it may not be set in the constructor
 		const Imath::V2i &m_tilesOrigin;
 		const Gaffer::Context *m_parentContext;
+		const Gaffer::Process *m_parentProcess;
+		Gaffer::Context::AccessRecorder *m_parentAccessRecorder;
 };
 
 template<class GatherFunctor, class TileFunctor>
@@ -362,7 +395,9 @@ class GatherFunctorFilter
 				m_functor( functor ),
 				m_imagePlug( imagePlug ),
 				m_tilesOrigin( tilesOrigin ),
-				m_parentContext( context )
+				m_parentContext( context ),
+				m_parentProcess( Gaffer::Process::current() ),
+				m_parentAccessRecorder( Gaffer::Context::AccessRecorder::current() )
 		{}
 
 		GatherFunctorFilter(
@@ -376,28 +411,32 @@ class GatherFunctorFilter
 				m_imagePlug( imagePlug ),
 				m_channelNames( channelNames ),
 				m_tilesOrigin( tilesOrigin ),
-				m_parentContext( context )
+				m_parentContext( context ),
+				m_parentProcess( Gaffer::Process::current() ),
+				m_parentAccessRecorder( Gaffer::Context::AccessRecorder::current() )
 		{}
 
 		void operator()( boost::tuple<size_t, Imath::V2i, typename TileFunctor::Result> &it ) const
 		{
-			Gaffer::ContextPtr context = new Gaffer::Context( *m_parentContext, Gaffer::Context::Borrowed );
-			Gaffer::Context::Scope scope( context.get() );
+			Gaffer::Context::EditableScope scope( m_parentContext );
+			Gaffer::Process::Scope processScope( m_parentProcess );
+			Gaffer::Context::AccessRecorder::Scope accessRecorderScope( m_parentAccessRecorder );
 
 			const Imath::V2i tileOrigin = m_tilesOrigin + ( boost::get<1>( it ) * ImagePlug::tileSize() );
-			context->set( ImagePlug::tileOriginContextName, tileOrigin );
-			context->set( ImagePlug::channelNameContextName, m_channelNames[boost::get<0>( it )] );
+			scope.set( ImagePlug::tileOriginContextName, tileOrigin );
+			scope.set( ImagePlug::channelNameContextName, m_channelNames[boost::get<0>( it )] );
 
 			m_functor( m_imagePlug, m_channelNames[boost::get<0>( it )], tileOrigin, boost::get<2>( it ) );
 		}
 
 		void operator()( boost::tuple<Imath::V2i, typename TileFunctor::Result> &it ) const
 		{
-			Gaffer::ContextPtr context = new Gaffer::Context( *m_parentContext, Gaffer::Context::Borrowed );
-			Gaffer::Context::Scope scope( context.get() );
+			Gaffer::Context::EditableScope scope( m_parentContext );
+			Gaffer::Process::Scope processScope( m_parentProcess );
+			Gaffer::Context::AccessRecorder::Scope accessRecorderScope( m_parentAccessRecorder );
 
 			const Imath::V2i tileOrigin = m_tilesOrigin + ( boost::get<0>( it ) * ImagePlug::tileSize() );
-			context->set( ImagePlug::tileOriginContextName, tileOrigin );
+			scope.set( ImagePlug::tileOriginContextName, tileOrigin );
 
 			m_functor( m_imagePlug, tileOrigin, boost::get<1>( it ) );
 		}
@@ -408,6 +447,8 @@ class GatherFunctorFilter
 		const std::vector<std::string> m_channelNames; // Don't declare as a reference, as it may not be set in the constructor
 		const Imath::V2i m_tilesOrigin;
 		const Gaffer::Context *m_parentContext;
+		const Gaffer::Process *m_parentProcess;
+		Gaffer::Context::AccessRecorder *m_parentAccessRecorder;
 };
 
 };
@@ -511,8 +552,15 @@ void parallelProcessTiles( const ImagePlug *imagePlug, ThreadableFunctor &functo
 	const Imath::V2i tilesOrigin = ImagePlug::tileOrigin( processWindow.min );
 	const Imath::V2i numTiles = ( ImagePlug::tileOrigin( processWindow.max - Imath::V2i( 1 ) ) - tilesOrigin ) / ImagePlug::tileSize();
 
-	parallel_for( tbb::blocked_range2d<size_t>( 0, numTiles.x, 1, 0, numTiles.y, 1 ),
-			  GafferImage::Detail::ProcessTiles<ThreadableFunctor>( functor, imagePlug, tilesOrigin, Gaffer::Context::current() ) );
+	try
+	{
+		parallel_for( tbb::blocked_range2d<size_t>( 0, numTiles.x, 1, 0, numTiles.y, 1 ),
+				  GafferImage::Detail::ProcessTiles<ThreadableFunctor>( functor, imagePlug, tilesOrigin, Gaffer::Context::current() ) );
+	}
+	catch( ... )
+	{
+		GafferImage::Detail::rethrow();
+	}
 }
 
 template <class ThreadableFunctor>
@@ -531,8 +579,15 @@ void parallelProcessTiles( const ImagePlug *imagePlug, const std::vector<std::st
 	const Imath::V2i tilesOrigin = ImagePlug::tileOrigin( processWindow.min );
 	Imath::V2i numTiles = ( ( ImagePlug::tileOrigin( processWindow.max - Imath::V2i( 1 ) ) - tilesOrigin ) / ImagePlug::tileSize() ) + Imath::V2i( 1 );
 
-	parallel_for( tbb::blocked_range3d<size_t>( 0, channelNames.size(), 1, 0, numTiles.x, 1, 0, numTiles.y, 1 ),
-			  GafferImage::Detail::ProcessTiles<ThreadableFunctor>( functor, imagePlug, channelNames, tilesOrigin, Gaffer::Context::current() ) );
+	try
+	{
+		parallel_for( tbb::blocked_range3d<size_t>( 0, channelNames.size(), 1, 0, numTiles.x, 1, 0, numTiles.y, 1 ),
+				  GafferImage::Detail::ProcessTiles<ThreadableFunctor>( functor, imagePlug, channelNames, tilesOrigin, Gaffer::Context::current() ) );
+	}
+	catch( ... )
+	{
+		GafferImage::Detail::rethrow();
+	}
 }
 
 template <class TileFunctor, class GatherFunctor>
@@ -553,20 +608,27 @@ void parallelGatherTiles( const ImagePlug *imagePlug, TileFunctor &tileFunctor,
 
 	GafferImage::Detail::TileInputIterator inputIterator( numTiles, tileOrder );
 
-	parallel_pipeline( tbb::task_scheduler_init::default_num_threads(),
-		tbb::make_filter<void, boost::tuple<Imath::V2i> >(
-			tbb::filter::serial,
-			GafferImage::Detail::TileInputFilter<GafferImage::Detail::TileInputIterator>( inputIterator )
-		) &
-		tbb::make_filter<boost::tuple<Imath::V2i>, boost::tuple<Imath::V2i, typename TileFunctor::Result> >(
-			tbb::filter::parallel,
-			GafferImage::Detail::TileFunctorFilter<TileFunctor>( tileFunctor, imagePlug, tilesOrigin, Gaffer::Context::current() )
-		) &
-		tbb::make_filter<boost::tuple<Imath::V2i, typename TileFunctor::Result>, void>(
-			tileOrder == Unordered ? tbb::filter::serial_out_of_order : tbb::filter::serial_in_order,
-			GafferImage::Detail::GatherFunctorFilter<GatherFunctor, TileFunctor>( gatherFunctor, imagePlug, tilesOrigin, Gaffer::Context::current() )
-		)
-	);
+	try
+	{
+		parallel_pipeline( tbb::task_scheduler_init::default_num_threads(),
+			tbb::make_filter<void, boost::tuple<Imath::V2i> >(
+				tbb::filter::serial,
+				GafferImage::Detail::TileInputFilter<GafferImage::Detail::TileInputIterator>( inputIterator )
+			) &
+			tbb::make_filter<boost::tuple<Imath::V2i>, boost::tuple<Imath::V2i, typename TileFunctor::Result> >(
+				tbb::filter::parallel,
+				GafferImage::Detail::TileFunctorFilter<TileFunctor>( tileFunctor, imagePlug, tilesOrigin, Gaffer::Context::current() )
+			) &
+			tbb::make_filter<boost::tuple<Imath::V2i, typename TileFunctor::Result>, void>(
+				tileOrder == Unordered ? tbb::filter::serial_out_of_order : tbb::filter::serial_in_order,
+				GafferImage::Detail::GatherFunctorFilter<GatherFunctor, TileFunctor>( gatherFunctor, imagePlug, tilesOrigin, Gaffer::Context::current() )
+			)
+		);
+	}
+	catch( ... )
+	{
+		GafferImage::Detail::rethrow();
+	}
 }
 
 template <class TileFunctor, class GatherFunctor>
@@ -587,20 +649,27 @@ void parallelGatherTiles( const ImagePlug *imagePlug, const std::vector<std::str
 
 	GafferImage::Detail::TileChannelInputIterator inputIterator( channelNames, numTiles, tileOrder );
 
-	parallel_pipeline( tbb::task_scheduler_init::default_num_threads(),
-		tbb::make_filter<void, boost::tuple<size_t, Imath::V2i> >(
-			tbb::filter::serial_in_order,
-			GafferImage::Detail::TileInputFilter<GafferImage::Detail::TileChannelInputIterator>( inputIterator )
-		) &
-		tbb::make_filter<boost::tuple<size_t, Imath::V2i>, boost::tuple<size_t, Imath::V2i, typename TileFunctor::Result> >(
-			tbb::filter::parallel,
-			GafferImage::Detail::TileFunctorFilter<TileFunctor>( tileFunctor, imagePlug, channelNames, tilesOrigin, Gaffer::Context::current() )
-		) &
-		tbb::make_filter<boost::tuple<size_t, Imath::V2i, typename TileFunctor::Result>, void>(
-			tileOrder == Unordered ? tbb::filter::serial_out_of_order : tbb::filter::serial_in_order,
-			GafferImage::Detail::GatherFunctorFilter<GatherFunctor, TileFunctor>( gatherFunctor, imagePlug, channelNames, tilesOrigin, Gaffer::Context::current() )
-		)
-	);
+	try
+	{
+		parallel_pipeline( tbb::task_scheduler_init::default_num_threads(),
+			tbb::make_filter<void, boost::tuple<size_t, Imath::V2i> >(
+				tbb::filter::serial_in_order,
+				GafferImage::Detail::TileInputFilter<GafferImage::Detail::TileChannelInputIterator>( inputIterator )
+			) &
+			tbb::make_filter<boost::tuple<size_t, Imath::V2i>, boost::tuple<size_t, Imath::V2i, typename TileFunctor::Result> >(
+				tbb::filter::parallel,
+				GafferImage::Detail::TileFunctorFilter<TileFunctor>( tileFunctor, imagePlug, channelNames, tilesOrigin, Gaffer::Context::current() )
+			) &
+			tbb::make_filter<boost::tuple<size_t, Imath::V2i, typename TileFunctor::Result>, void>(
+				tileOrder == Unordered ? tbb::filter::serial_out_of_order : tbb::filter::serial_in_order,
+				GafferImage::Detail::GatherFunctorFilter<GatherFunctor, TileFunctor>( gatherFunctor, imagePlug, channelNames, tilesOrigin, Gaffer::Context::current() )
+			)
+		);
+	}
+	catch( ... )
+	{
+		GafferImage::Detail::rethrow();
+	}
 }
 
 } // namespace ImageAlgo
@@ -89,7 +89,7 @@ class Instancer : public BranchCreator
 		Gaffer::ContextPtr instanceContext( const Gaffer::Context *parentContext, const ScenePath &branchPath ) const;
 		// Fills an existing context with the fields needed for evaluating instancePlug()
 		void fillInstanceContext( Gaffer::Context *instanceContext, const ScenePath &branchPath ) const;
-		void fillInstanceContext( Gaffer::Context *instanceContext, const ScenePath &branchPath, int instanceId ) const;
+		void fillInstanceContext( Gaffer::Context::EditableScope &instanceScope, const ScenePath &branchPath, int instanceId ) const;
 		Imath::M44f instanceTransform( const IECore::V3fVectorData *p, int instanceId ) const;
 
 		static size_t g_firstPlugIndex;
@@ -49,6 +49,7 @@ namespace Gaffer
 {
 
 IE_CORE_FORWARDDECLARE( Context )
+IE_CORE_FORWARDDECLARE( ThreadBudget )
 
 } // namespace Gaffer
 
@@ -114,7 +115,8 @@ class InteractiveRender : public Gaffer::Node
 
 		void update();
 
-		static void runPipeline(tbb::pipeline *p);
+		static void runPipeline( tbb::pipeline *p, Gaffer::ThreadBudget *threadBudget );
+		void buildSceneGraph();
 		void outputScene( bool update );
 
 		void updateLights();
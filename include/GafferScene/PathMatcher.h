@@ -40,6 +40,8 @@
 
 #include "IECore/TypedData.h"
 
+#include "Gaffer/StringAlgo.h"
+
 #include "GafferScene/Filter.h"
 
 namespace GafferScene
@@ -158,6 +160,10 @@ class PathMatcher
 
 			const IECore::InternedString name;
 			const unsigned char type;
+			// Compiled form of `name`, for Wildcarded names other
+			// than "...". Like the InternedStrings they are made from,
+			// compiled patterns are shared and never freed.
+			const Gaffer::StringAlgo::CompiledMatchPattern *pattern;
 
 		};
 
@@ -109,6 +109,7 @@ class InteractiveRender : public Gaffer::Node
 		void contextChanged( const IECore::InternedString &name );
 
 		void update();
+		void updateSceneGraphs();
 		void updateEffectiveContext();
 		void updateDefaultCamera();
 		void stop();
@@ -36,6 +36,7 @@
 
 #include "tbb/task.h"
 #include "Gaffer/Context.h"
+#include "Gaffer/Process.h"
 
 namespace GafferScene
 {
@@ -54,7 +55,7 @@ class TraverseTask : public tbb::task
 			const Gaffer::Context *context,
 			ThreadableFunctor &f
 		)
-			:	m_scene( scene ), m_context( context ), m_f( f )
+			:	m_scene( scene ), m_context( context ), m_process( Gaffer::Process::current() ), m_accessRecorder( Gaffer::Context::AccessRecorder::current() ), m_f( f )
 		{
 		}
 
@@ -64,10 +65,12 @@ class TraverseTask : public tbb::task
 
 		virtual task *execute()
 		{
+			Gaffer::Canceller::check( m_context->canceller() );
 
-			Gaffer::ContextPtr context = new Gaffer::Context( *m_context, Gaffer::Context::Borrowed );
-			context->set( ScenePlug::scenePathContextName, m_path );
-			Gaffer::Context::Scope scopedContext( context.get() );
+			Gaffer::Context::EditableScope scopedContext( m_context );
+			scopedContext.set( ScenePlug::scenePathContextName, m_path );
+			Gaffer::Process::Scope scopedProcess( m_process );
+			Gaffer::Context::AccessRecorder::Scope scopedAccessRecorder( m_accessRecorder );
 
 			if( m_f( m_scene, m_path ) )
 			{
@@ -95,6 +98,8 @@ class TraverseTask : public tbb::task
 		TraverseTask( const TraverseTask &other, const ScenePlug::ScenePath &path )
 			:	m_scene( other.m_scene ),
 				m_context( other.m_context ),
+				m_process( other.m_process ),
+				m_accessRecorder( other.m_accessRecorder ),
 				m_f( other.m_f ),
 				m_path( path )
 		{
@@ -104,6 +109,8 @@ class TraverseTask : public tbb::task
 
 		const GafferScene::ScenePlug *m_scene;
 		const Gaffer::Context *m_context;
+		const Gaffer::Process *m_process;
+		Gaffer::Context::AccessRecorder *m_accessRecorder;
 		ThreadableFunctor &m_f;
 		GafferScene::ScenePlug::ScenePath m_path;
 
@@ -174,7 +181,17 @@ void parallelTraverse( const GafferScene::ScenePlug *scene, ThreadableFunctor &f
 	Gaffer::ContextPtr c = new Gaffer::Context( *Gaffer::Context::current(), Gaffer::Context::Borrowed );
 	GafferScene::Filter::setInputScene( c.get(), scene );
 	Detail::TraverseTask<ThreadableFunctor> *task = new( tbb::task::allocate_root() ) Detail::TraverseTask<ThreadableFunctor>( scene, c.get(), f );
-	tbb::task::spawn_root_and_wait( *task );
+	try
+	{
+		tbb::task::spawn_root_and_wait( *task );
+	}
+	catch( ... )
+	{
+		// The exception may have lost its type in transit from
+		// another thread, so check for cancellation explicitly.
+		Gaffer::Canceller::check( c->canceller() );
+		throw;
+	}
 }
 
 template <class ThreadableFunctor>
@@ -82,6 +82,10 @@ class SceneElementProcessor : public FilteredSceneProcessor
 		/// Implemented to call computeProcessedObject() where appropriate.
 		virtual IECore::ConstObjectPtr computeObject( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent ) const;
 
+		/// Reimplemented to return HashOnly for the transform when it is never processed,
+		/// since it is passed through from the input, which has its own cache entries.
+		virtual Gaffer::ValuePlug::CachePolicy computeCachePolicy( const Gaffer::ValuePlug *output ) const;
+
 		/// @name Scene processing methods
 		/// These methods should be reimplemented by derived classes to process the input scene - they will be called as
 		/// appropriate based on the result of the filter applied to the node. To process a particular
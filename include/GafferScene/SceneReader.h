@@ -103,6 +103,11 @@ class SceneReader : public SceneNode
 		virtual IECore::ConstInternedStringVectorDataPtr computeSetNames( const Gaffer::Context *context, const ScenePlug *parent ) const;
 		virtual GafferScene::ConstPathMatcherDataPtr computeSet( const IECore::InternedString &setName, const Gaffer::Context *context, const ScenePlug *parent ) const;
 
+		/// Reimplemented so that concurrent reads of the same object collaborate.
+		virtual Gaffer::ValuePlug::CachePolicy computeCachePolicy( const Gaffer::ValuePlug *output ) const;
+		/// Reimplemented so that objects may be stored in the persistent cache.
+		virtual bool persistentCacheable( const Gaffer::ValuePlug *output ) const;
+
 	private :
 
 		void plugSet( Gaffer::Plug *plug );
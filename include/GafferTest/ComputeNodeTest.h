@@ -37,11 +37,17 @@
 #ifndef GAFFERTEST_COMPUTENODETEST_H
 #define GAFFERTEST_COMPUTENODETEST_H
 
+#include "Gaffer/NumericPlug.h"
+
 namespace GafferTest
 {
 
 void testComputeNodeThreading();
 
+/// Calls `plug->getValue()` the specified number of times,
+/// from many threads in parallel, in the current context.
+void parallelGetValue( const Gaffer::IntPlug *plug, int iterations );
+
 } // namespace GafferTest
 
 #endif // GAFFERTEST_COMPUTENODETEST_H
@@ -41,9 +41,14 @@ namespace GafferTest
 {
 
 void testManyContexts();
+void testManyVariablesHashPerformance();
+void testDeepPathHashPerformance();
 void testManySubstitutions();
 void testManyEnvironmentSubstitutions();
 void testScopingNullContext();
+void testEditableScope();
+void testManyEditableScopes();
+void testAccessRecorderThreading();
 
 } // namespace GafferTest
 
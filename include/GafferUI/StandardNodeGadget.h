@@ -119,7 +119,7 @@ class StandardNodeGadget : public NodeGadget
 
 		static NodeGadgetTypeDescription<StandardNodeGadget> g_nodeGadgetTypeDescription;
 
-		void plugDirtied( const Gaffer::Plug *plug );
+		void plugsDirtied( const std::vector<Gaffer::Plug *> &plugs );
 
 		void enter( Gadget *gadget );
 		void leave( Gadget *gadget );
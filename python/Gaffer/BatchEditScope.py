@@ -0,0 +1,66 @@
+##########################################################################
+#
+#  Copyright (c) 2016, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+
+from _Gaffer import _BatchEditScope
+
+## Groups many calls to `ValuePlug.setValue()` into a single
+# undoable edit, with a single pass of dirty propagation when
+# the scope exits. See the C++ documentation for details.
+#
+# ```
+# with Gaffer.UndoContext( script ) :
+# 	with Gaffer.BatchEditScope() :
+# 		for plug, value in settings.items() :
+# 			plug.setValue( value )
+# ```
+class BatchEditScope( object ) :
+
+	def __enter__( self ) :
+
+		self.__scope = _BatchEditScope()
+
+	def __exit__( self, type, value, traceBack ) :
+
+		try :
+			# Only commit explicitly if no exception is in flight, so
+			# that errors from the commit are raised to the caller
+			# without masking an existing exception. Otherwise the
+			# destructor commits, reporting any errors as messages.
+			if type is None :
+				self.__scope.commit()
+		finally :
+			del self.__scope
@@ -53,7 +53,6 @@ class PythonExpressionEngine( Gaffer.Expression.Engine ) :
 
 		parser = _Parser( expression )
 
-		self.__expression = expression
 		self.__inPlugPaths = list( parser.plugReads )
 		self.__outPlugPaths = list( parser.plugWrites )
 
@@ -61,32 +60,61 @@ class PythonExpressionEngine( Gaffer.Expression.Engine ) :
 		outPlugs.extend( [ self.__plug( node, p ) for p in self.__outPlugPaths ] )
 		contextNames.extend( parser.contextReads )
 
+		# Compile once up front, rather than every time we're executed.
+		self.__code = compile( parser.tree, "<string>", "exec" )
+
+		# Split the plug paths up front too, so that execute() only
+		# needs to build the dictionaries.
+		self.__inPlugKeys = [ p.split( "." ) for p in self.__inPlugPaths ]
+		self.__outPlugKeys = [ p.split( "." ) for p in self.__outPlugPaths ]
+
+		# Simple expressions don't need executing at all. Those which
+		# just assign literals have a result we can compute now, and
+		# those which just copy one plug to another can skip straight
+		# to the copy.
+		self.__constantResult = None
+		if parser.constantValues is not None :
+			try :
+				constantResult = IECore.ObjectVector()
+				for plugPath in self.__outPlugPaths :
+					constantResult.append( parser.constantValues[plugPath] )
+				self.__constantResult = constantResult
+			except Exception :
+				# Leave it to execute() to report the error.
+				pass
+		self.__passThrough = parser.passThrough
+
 	def execute( self, context, inputs ) :
 
+		if self.__constantResult is not None :
+			return self.__constantResult
+		elif self.__passThrough :
+			result = IECore.ObjectVector()
+			result.append( inputs[0].getValue() )
+			return result
+
 		plugDict = {}
-		for plugPath, plug in zip( self.__inPlugPaths, inputs ) :
+		for plugKeys, plug in zip( self.__inPlugKeys, inputs ) :
 			parentDict = plugDict
-			plugPathSplit = plugPath.split( "." )
-			for p in plugPathSplit[:-1] :
+			for p in plugKeys[:-1] :
 				parentDict = parentDict.setdefault( p, {} )
-			parentDict[plugPathSplit[-1]] = plug.getValue()
+			parentDict[plugKeys[-1]] = plug.getValue()
 
-		for plugPath in self.__outPlugPaths :
+		for plugKeys in self.__outPlugKeys :
 			parentDict = plugDict
-			for p in plugPath.split( "." )[:-1] :
+			for p in plugKeys[:-1] :
 				parentDict = parentDict.setdefault( p, {} )
 
 		executionDict = { "IECore" : IECore, "parent" : plugDict, "context" : context }
 
-		exec( self.__expression, executionDict, executionDict )
+		exec( self.__code, executionDict, executionDict )
 
 		result = IECore.ObjectVector()
-		for plugPath in self.__outPlugPaths :
+		for plugKeys in self.__outPlugKeys :
 			parentDict = plugDict
-			plugPathSplit = plugPath.split( "." )
-			for p in plugPathSplit[:-1] :
+			for p in plugKeys[:-1] :
 				parentDict = parentDict[p]
-			result.append( parentDict.get( plugPathSplit[-1], IECore.NullObject.defaultNullObject() ) )
+			result.append( parentDict.get( plugKeys[-1], IECore.NullObject.defaultNullObject() ) )
 
 		return result
 
@@ -224,7 +252,26 @@ class _Parser( ast.NodeVisitor ) :
 		self.plugReads = set()
 		self.contextReads = set()
 
-		self.visit( ast.parse( expression ) )
+		self.tree = ast.parse( expression )
+		self.visit( self.tree )
+
+		# Identify simple expressions which the engine can
+		# evaluate without executing any Python.
+
+		self.constantValues = None
+		self.passThrough = False
+
+		assignments = self.__plugAssignments( self.tree )
+		if assignments :
+			try :
+				self.constantValues = dict( [ ( p, ast.literal_eval( v ) ) for p, v in assignments ] )
+			except ValueError :
+				pass
+			if (
+				len( assignments ) == 1 and len( self.plugReads ) == 1 and not self.contextReads and
+				isinstance( assignments[0][1], ast.Subscript ) and self.__plugPath( self.__path( assignments[0][1] ) )
+			) :
+				self.passThrough = True
 
 	def visit_Assign( self, node ) :
 
@@ -268,6 +315,21 @@ class _Parser( ast.NodeVisitor ) :
 
 		ast.NodeVisitor.generic_visit( self, node )
 
+	# Returns a list of ( plugPath, valueNode ) pairs if the expression
+	# consists solely of assignments to plugs, and None otherwise.
+	def __plugAssignments( self, tree ) :
+
+		result = []
+		for statement in tree.body :
+			if not isinstance( statement, ast.Assign ) or len( statement.targets ) != 1 :
+				return None
+			plugPath = self.__plugPath( self.__path( statement.targets[0] ) )
+			if not plugPath :
+				return None
+			result.append( ( plugPath, statement.value ) )
+
+		return result
+
 	def __path( self, node ) :
 
 		result = []
@@ -44,6 +44,7 @@ from WeakMethod import WeakMethod
 from BlockedConnection import BlockedConnection
 from FileNamePathFilter import FileNamePathFilter
 from UndoContext import UndoContext
+from BatchEditScope import BatchEditScope
 from Context import Context
 from InfoPathFilter import InfoPathFilter
 from LazyModule import lazyImport, LazyModule
@@ -114,6 +114,35 @@ class OpenGLShaderTest( GafferSceneTest.SceneTestCase ) :
 		self.assertNotEqual( h3, h2 )
 		self.assertNotEqual( h3, h1 )
 
+	def testHashDependsOnVariablesReadByTiles( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["constant"] = GafferImage.Constant()
+		s["constant"]["format"].setValue( GafferImage.Format( 1000, 1000, 1 ) )
+
+		# The variable only affects the channel data, which imageHash()
+		# hashes on many threads, one tile at a time.
+		s["expression"] = Gaffer.Expression()
+		s["expression"].setExpression( 'parent.constant.color.r = context( "textureRed" )', "native" )
+
+		s["shader"] = GafferScene.OpenGLShader()
+		s["shader"].loadShader( "Texture" )
+		s["shader"]["parameters"]["texture"].setInput( s["constant"]["out"] )
+
+		s["plane"] = GafferScene.Plane()
+		s["assignment"] = GafferScene.ShaderAssignment()
+		s["assignment"]["in"].setInput( s["plane"]["out"] )
+		s["assignment"]["shader"].setInput( s["shader"]["out"] )
+
+		with Gaffer.Context() as c :
+			c["textureRed"] = 0.25
+			h1 = s["assignment"]["out"].attributesHash( "/plane" )
+			c["textureRed"] = 0.5
+			h2 = s["assignment"]["out"].attributesHash( "/plane" )
+
+		self.assertNotEqual( h1, h2 )
+
 if sys.platform == "darwin" :
 	# The Texture shader used in the test provides only a .frag file, which
 	# means that it gets the default vertex shader. The default vertex shader
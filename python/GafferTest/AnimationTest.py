@@ -442,5 +442,88 @@ class AnimationTest( GafferTest.TestCase ) :
 			c.setTime( 1 )
 			self.assertEqual( s["r"]["sum"].getValue(), 3 )
 
+	def testBatchEvaluation( self ) :
+
+		curve = Gaffer.Animation.CurvePlug()
+		for i in range( 0, 20 ) :
+			curve.addKey(
+				Gaffer.Animation.Key(
+					i * 2, ( i * 7 ) % 5,
+					Gaffer.Animation.Type.Step if i % 3 == 0 else Gaffer.Animation.Type.Linear
+				)
+			)
+
+		increasing = [ -2 + i * 0.25 for i in range( 0, 200 ) ]
+		for times in [
+			increasing,
+			list( reversed( increasing ) ),
+			[ 30, 1, 0, 38, 38.5, -1, 12, 12.5, 11.5, 2 ],
+			[],
+		] :
+			values = curve.evaluate( IECore.FloatVectorData( times ) )
+			self.assertTrue( isinstance( values, IECore.FloatVectorData ) )
+			self.assertEqual( len( values ), len( times ) )
+			for t, v in zip( times, values ) :
+				self.assertEqual( v, curve.evaluate( t ) )
+
+	def testEvaluateAfterEditingKeys( self ) :
+
+		curve = Gaffer.Animation.CurvePlug()
+		for i in range( 0, 10 ) :
+			curve.addKey( Gaffer.Animation.Key( i, i ) )
+
+		self.assertEqual( curve.evaluate( 8.5 ), 8.5 )
+
+		for i in range( 5, 10 ) :
+			curve.removeKey( i )
+
+		self.assertEqual( curve.evaluate( 8.5 ), 4 )
+		self.assertEqual( curve.evaluate( 2.5 ), 2.5 )
+
+		curve.addKey( Gaffer.Animation.Key( 3, 10 ) )
+		self.assertEqual( curve.evaluate( 2.5 ), 6 )
+
+		# Replacing a key and undoing edits must also
+		# update the keys used for evaluation.
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["user"]["f"] = Gaffer.FloatPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		curve = Gaffer.Animation.acquire( s["n"]["user"]["f"] )
+		curve.addKey( Gaffer.Animation.Key( 0, 0 ) )
+		curve.addKey( Gaffer.Animation.Key( 10, 10 ) )
+		self.assertEqual( curve.evaluate( 5 ), 5 )
+
+		with Gaffer.UndoContext( s ) :
+			curve.addKey( Gaffer.Animation.Key( 10, 20 ) )
+			curve.removeKey( 0 )
+		self.assertEqual( curve.evaluate( 5 ), 20 )
+
+		s.undo()
+		self.assertEqual( curve.evaluate( 5 ), 5 )
+
+	def testEvaluateManyCurves( self ) :
+
+		curves = []
+		for i in range( 0, 10 ) :
+			curve = Gaffer.Animation.CurvePlug()
+			curve.addKey( Gaffer.Animation.Key( 0, i ) )
+			curve.addKey( Gaffer.Animation.Key( 10, i * 2 ) )
+			curves.append( curve )
+
+		for time in ( -1, 0, 2.5, 10, 11 ) :
+			values = Gaffer.Animation.evaluate( curves, time )
+			self.assertTrue( isinstance( values, IECore.FloatVectorData ) )
+			self.assertEqual( list( values ), [ c.evaluate( time ) for c in curves ] )
+
+		self.assertEqual( len( Gaffer.Animation.evaluate( [], 0 ) ), 0 )
+
+	def testEvaluateNone( self ) :
+
+		curve = Gaffer.Animation.CurvePlug()
+		curve.addKey( Gaffer.Animation.Key( 0, 1 ) )
+
+		self.assertRaises( TypeError, curve.evaluate, None )
+		self.assertRaises( TypeError, Gaffer.Animation.evaluate, [ curve, None ], 0 )
+
 if __name__ == "__main__":
 	unittest.main()
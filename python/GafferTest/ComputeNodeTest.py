@@ -35,6 +35,8 @@
 #
 ##########################################################################
 
+import os
+import glob
 import unittest
 import threading
 import time
@@ -484,5 +486,193 @@ class ComputeNodeTest( GafferTest.TestCase ) :
 
 		GafferTest.testComputeNodeThreading()
 
+	def testCachePolicies( self ) :
+
+		class CachePolicyNode( GafferTest.AddNode ) :
+
+			def __init__( self, name = "CachePolicyNode" ) :
+
+				GafferTest.AddNode.__init__( self, name )
+				self.cachePolicy = Gaffer.ValuePlug.CachePolicy.Standard
+
+			def computeCachePolicy( self, output ) :
+
+				return self.cachePolicy
+
+		IECore.registerRunTimeTyped( CachePolicyNode )
+
+		n = CachePolicyNode()
+		n["op1"].setValue( 1 )
+
+		# Standard policy caches both hashes and values.
+
+		for i in range( 0, 2 ) :
+			self.assertEqual( n["sum"].getValue(), 1 )
+		self.assertEqual( n.numHashCalls, 1 )
+		self.assertEqual( n.numComputeCalls, 1 )
+
+		# HashOnly policy caches hashes but not values.
+
+		n.cachePolicy = Gaffer.ValuePlug.CachePolicy.HashOnly
+		n["op1"].setValue( 2 )
+		for i in range( 0, 2 ) :
+			self.assertEqual( n["sum"].hash(), n["sum"].hash() )
+			self.assertEqual( n["sum"].getValue(), 2 )
+		self.assertEqual( n.numHashCalls, 2 )
+		self.assertEqual( n.numComputeCalls, 3 )
+
+		# Uncached policy caches nothing.
+
+		n.cachePolicy = Gaffer.ValuePlug.CachePolicy.Uncached
+		n["op1"].setValue( 3 )
+		for i in range( 0, 2 ) :
+			self.assertEqual( n["sum"].hash(), n["sum"].hash() )
+			self.assertEqual( n["sum"].getValue(), 3 )
+		self.assertEqual( n.numHashCalls, 6 )
+		self.assertEqual( n.numComputeCalls, 5 )
+
+	def testPersistentCache( self ) :
+
+		class PersistentAddNode( GafferTest.AddNode ) :
+
+			def persistentCacheable( self, output ) :
+
+				return True
+
+		IECore.registerRunTimeTyped( PersistentAddNode )
+
+		directory = os.path.join( self.temporaryDirectory(), "persistentCache" )
+		sizeLimit = Gaffer.ValuePlug.getPersistentCacheSizeLimit()
+		Gaffer.ValuePlug.setPersistentCacheDirectory( directory )
+		self.assertEqual( Gaffer.ValuePlug.getPersistentCacheDirectory(), directory )
+
+		def numFiles() :
+			return len( glob.glob( os.path.join( directory, "*", "*.fio" ) ) )
+
+		try :
+
+			n1 = PersistentAddNode()
+			n1["op1"].setValue( 1 )
+			n1["op2"].setValue( 2 )
+
+			self.assertEqual( n1["sum"].getValue(), 3 )
+			self.assertEqual( n1.numComputeCalls, 1 )
+			self.assertEqual( numFiles(), 1 )
+
+			# Clearing the in-memory cache simulates starting a new
+			# process. The value should be loaded from disk rather
+			# than computed again, even for a different node.
+
+			Gaffer.ValuePlug.clearCache()
+
+			n2 = PersistentAddNode()
+			n2["op1"].setValue( 1 )
+			n2["op2"].setValue( 2 )
+
+			self.assertEqual( n2["sum"].getValue(), 3 )
+			self.assertEqual( n2.numComputeCalls, 0 )
+
+			# Clearing both caches should force a recompute.
+
+			Gaffer.ValuePlug.clearCache()
+			Gaffer.ValuePlug.clearPersistentCache()
+			self.assertEqual( numFiles(), 0 )
+
+			self.assertEqual( n1["sum"].getValue(), 3 )
+			self.assertEqual( n1.numComputeCalls, 2 )
+			self.assertEqual( numFiles(), 1 )
+
+			# And the size limit should be respected.
+
+			Gaffer.ValuePlug.setPersistentCacheSizeLimit( 0 )
+			self.assertEqual( numFiles(), 0 )
+
+			n1["op2"].setValue( 3 )
+			self.assertEqual( n1["sum"].getValue(), 4 )
+			self.assertEqual( numFiles(), 0 )
+
+			# Nodes which don't opt in should never use the cache.
+
+			Gaffer.ValuePlug.setPersistentCacheSizeLimit( sizeLimit )
+
+			n3 = GafferTest.AddNode()
+			n3["op1"].setValue( 10 )
+			self.assertEqual( n3["sum"].getValue(), 10 )
+			self.assertEqual( numFiles(), 0 )
+
+		finally :
+
+			Gaffer.ValuePlug.setPersistentCacheDirectory( "" )
+			Gaffer.ValuePlug.setPersistentCacheSizeLimit( sizeLimit )
+
+	def testConcurrentComputesAreNotDuplicated( self ) :
+
+		class CollaborativeAddNode( GafferTest.AddNode ) :
+
+			def computeCachePolicy( self, output ) :
+
+				return Gaffer.ValuePlug.CachePolicy.TaskCollaboration
+
+		IECore.registerRunTimeTyped( CollaborativeAddNode )
+
+		n = CollaborativeAddNode()
+		n["op1"].setValue( 1 )
+		n["op2"].setValue( 2 )
+
+		# Many threads are requesting the same value
+		# concurrently, but only one of them should
+		# perform the compute. The others should wait
+		# for it, or use the result from the cache.
+		GafferTest.parallelGetValue( n["sum"], 10000 )
+		self.assertEqual( n.numComputeCalls, 1 )
+
+	def testConcurrentComputeErrors( self ) :
+
+		class ErroringNode( GafferTest.AddNode ) :
+
+			def computeCachePolicy( self, output ) :
+
+				return Gaffer.ValuePlug.CachePolicy.TaskCollaboration
+
+			def compute( self, plug, context ) :
+
+				raise RuntimeError( "Oops" )
+
+		IECore.registerRunTimeTyped( ErroringNode )
+
+		# Errors must be reported to all threads,
+		# not just the one performing the compute,
+		# and must retain their original message.
+		n = ErroringNode()
+		self.assertRaisesRegexp( RuntimeError, "Oops", GafferTest.parallelGetValue, n["sum"], 1000 )
+		self.assertRaisesRegexp( RuntimeError, "Oops", n["sum"].getValue )
+
+	def testCancellation( self ) :
+
+		n = GafferTest.AddNode()
+		n["op1"].setValue( 1 )
+
+		errors = GafferTest.CapturingSlot( n.errorSignal() )
+
+		canceller = Gaffer.Canceller()
+		with Gaffer.Context( Gaffer.Context(), canceller ) as c :
+			self.assertFalse( c.canceller().cancelled() )
+			# Copies share the canceller.
+			self.assertFalse( Gaffer.Context( c ).canceller() is None )
+			canceller.cancel()
+			self.assertTrue( c.canceller().cancelled() )
+			self.assertRaises( RuntimeError, n["sum"].getValue )
+
+		self.assertEqual( n.numHashCalls, 0 )
+		self.assertEqual( n.numComputeCalls, 0 )
+
+		# Cancellation isn't an error, and nothing should
+		# have been left behind in the caches.
+
+		self.assertEqual( len( errors ), 0 )
+		self.assertEqual( n["sum"].getValue(), 1 )
+		self.assertEqual( n.numComputeCalls, 1 )
+		self.assertTrue( Gaffer.Context().canceller() is None )
+
 if __name__ == "__main__":
 	unittest.main()
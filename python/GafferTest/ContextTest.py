@@ -546,6 +546,72 @@ class ContextTest( GafferTest.TestCase ) :
 		c["ui:test"] = 1
 		self.assertEqual( h, c.hash() )
 
+	def testHashIsIndependentOfOrder( self ) :
+
+		c1 = Gaffer.Context()
+		c1["a"] = 1
+		c1["b"] = "b"
+		c1["c"] = IECore.IntVectorData( [ 1, 2, 3 ] )
+
+		c2 = Gaffer.Context()
+		c2["c"] = IECore.IntVectorData( [ 1, 2, 3 ] )
+		c2["a"] = 10
+		c2["b"] = "b"
+		self.assertNotEqual( c1.hash(), c2.hash() )
+
+		c2["a"] = 1
+		self.assertEqual( c1.hash(), c2.hash() )
+
+		# Adding and removing a variable should restore the original hash.
+
+		h = c2.hash()
+		c2["d"] = 2
+		self.assertNotEqual( c2.hash(), h )
+		c2.remove( "d" )
+		self.assertEqual( c2.hash(), h )
+
+		# As should copying, regardless of ownership.
+
+		for ownership in ( Gaffer.Context.Ownership.Copied, Gaffer.Context.Ownership.Shared, Gaffer.Context.Ownership.Borrowed ) :
+			self.assertEqual( Gaffer.Context( c1, ownership ).hash(), c1.hash() )
+
+	def testHashDependsOnNames( self ) :
+
+		c1 = Gaffer.Context()
+		c1["a"] = 1
+		c1["b"] = 2
+
+		c2 = Gaffer.Context()
+		c2["a"] = 2
+		c2["b"] = 1
+
+		self.assertNotEqual( c1.hash(), c2.hash() )
+
+	def testHashOfNames( self ) :
+
+		c1 = Gaffer.Context()
+		c1["a"] = 1
+		c1["b"] = 2
+
+		c2 = Gaffer.Context()
+		c2["a"] = 1
+		c2["b"] = 3
+
+		self.assertEqual( c1.hash( [ "a" ] ), c2.hash( [ "a" ] ) )
+		self.assertNotEqual( c1.hash( [ "b" ] ), c2.hash( [ "b" ] ) )
+		self.assertNotEqual( c1.hash( [ "a", "b" ] ), c2.hash( [ "a", "b" ] ) )
+		self.assertEqual( c1.hash( [ "a", "b" ] ), c1.hash( [ "b", "a" ] ) )
+		self.assertEqual( c1.hash( [ "a" ] ), c1.hash( [ "a", "c" ] ) )
+		self.assertEqual( c1.hash( [ "a", "c" ] ), c2.hash( [ "a", "c" ] ) )
+
+	def testManyVariablesHashPerformance( self ) :
+
+		GafferTest.testManyVariablesHashPerformance()
+
+	def testDeepPathHashPerformance( self ) :
+
+		GafferTest.testDeepPathHashPerformance()
+
 	def testManySubstitutions( self ) :
 
 		GafferTest.testManySubstitutions()
@@ -554,6 +620,18 @@ class ContextTest( GafferTest.TestCase ) :
 
 		GafferTest.testManyEnvironmentSubstitutions()
 
+	def testEditableScope( self ) :
+
+		GafferTest.testEditableScope()
+
+	def testManyEditableScopes( self ) :
+
+		GafferTest.testManyEditableScopes()
+
+	def testAccessRecorderThreading( self ) :
+
+		GafferTest.testAccessRecorderThreading()
+
 	def testEscapedSubstitutions( self ) :
 
 		c = Gaffer.Context()
@@ -614,5 +614,86 @@ class DependencyNodeTest( GafferTest.TestCase ) :
 
 		s["n2"]["op1"].setInput( s["n1"]["product"] )
 
+	def testPlugsDirtiedSignal( self ) :
+
+		n1 = GafferTest.AddNode()
+		n2 = GafferTest.AddNode()
+		n2["op1"].setInput( n1["sum"] )
+		n2["op2"].setInput( n1["sum"] )
+
+		dirtied1 = GafferTest.CapturingSlot( n1.plugDirtiedSignal() )
+		dirtied2 = GafferTest.CapturingSlot( n2.plugDirtiedSignal() )
+		batched1 = GafferTest.CapturingSlot( n1.plugsDirtiedSignal() )
+		batched2 = GafferTest.CapturingSlot( n2.plugsDirtiedSignal() )
+
+		n1["op1"].setValue( 10 )
+
+		# One emission per node, with the plugs in the
+		# same order as the individual emissions.
+		self.assertEqual( len( batched1 ), 1 )
+		self.assertEqual( len( batched2 ), 1 )
+		self.assertEqual( batched1[0][0], [ x[0] for x in dirtied1 ] )
+		self.assertEqual( batched2[0][0], [ x[0] for x in dirtied2 ] )
+		self.assertEqual( len( batched2[0][0] ), 3 )
+
+	def testPlugsDirtiedSignalOrder( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		# Make several chains, so that the order nodes were signalled
+		# in can't match address order by coincidence.
+		chains = []
+		for i in range( 0, 5 ) :
+			chain = []
+			for j in range( 0, 3 ) :
+				n = GafferTest.AddNode()
+				s.addChild( n )
+				if chain :
+					n["op1"].setInput( chain[-1]["sum"] )
+				chain.append( n )
+			chains.append( chain )
+
+		signalled = []
+		connections = []
+		for chain in chains :
+			for n in chain :
+				connections.append(
+					n.plugsDirtiedSignal().connect( lambda plugs : signalled.append( plugs[0].node() ) )
+				)
+
+		# Nodes are signalled upstream first, in the order
+		# in which they were first dirtied.
+		for chain in chains :
+			del signalled[:]
+			chain[0]["op1"].setValue( 1 )
+			self.assertEqual( signalled, chain )
+
+	def testPlugsDirtiedSignalSlotDeletesNode( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n1"] = GafferTest.AddNode()
+		s["n2"] = GafferTest.AddNode()
+		s["n2"]["op1"].setInput( s["n1"]["sum"] )
+
+		n2 = s["n2"]
+		batched2 = GafferTest.CapturingSlot( n2.plugsDirtiedSignal() )
+
+		def deleteDownstream( plugs ) :
+			if "n2" in s :
+				del s["n2"]
+
+		c = s["n1"].plugsDirtiedSignal().connect( deleteDownstream )
+		del n2
+
+		# The node removed by the first slot must still be
+		# alive when its own signal is emitted.
+		s["n1"]["op1"].setValue( 1 )
+		self.assertNotIn( "n2", s )
+		self.assertEqual( len( batched2 ), 1 )
+
+	def testDirtyPropagationPerformance( self ) :
+
+		GafferTest.testDirtyPropagationPerformance()
+
 if __name__ == "__main__":
 	unittest.main()
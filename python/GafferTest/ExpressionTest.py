@@ -1247,5 +1247,63 @@ class ExpressionTest( GafferTest.TestCase ) :
 		for language in ( "", "latin" ) :
 			self.assertRaisesRegexp( RuntimeError, "Failed to create engine", s["e"].setExpression, "parent.n.user.p = 10", language )
 
+	def testConstantExpression( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["user"]["i"] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n"]["user"]["f"] = Gaffer.FloatPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n"]["user"]["s"] = Gaffer.StringPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n"]["user"]["b"] = Gaffer.BoolPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( inspect.cleandoc(
+			"""
+			parent["n"]["user"]["i"] = -1
+			parent["n"]["user"]["f"] = 2.5
+			parent["n"]["user"]["s"] = "hi"
+			parent["n"]["user"]["b"] = True
+			parent["n"]["user"]["i"] = 10
+			"""
+		) )
+
+		for frame in range( 0, 3 ) :
+			with Gaffer.Context() as c :
+				c.setFrame( frame )
+				self.assertEqual( s["n"]["user"]["i"].getValue(), 10 )
+				self.assertEqual( s["n"]["user"]["f"].getValue(), 2.5 )
+				self.assertEqual( s["n"]["user"]["s"].getValue(), "hi" )
+				self.assertEqual( s["n"]["user"]["b"].getValue(), True )
+
+	def testPassThroughExpression( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["user"]["a"] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n"]["user"]["b"] = Gaffer.FloatPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( 'parent["n"]["user"]["b"] = parent["n"]["user"]["a"]' )
+
+		for i in range( 0, 3 ) :
+			s["n"]["user"]["a"].setValue( i )
+			self.assertEqual( s["n"]["user"]["b"].getValue(), i )
+
+	def testExpressionExecutedRepeatedly( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["user"]["a"] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n"]["user"]["b"] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( 'parent["n"]["user"]["b"] = parent["n"]["user"]["a"] + context.getFrame()' )
+
+		for frame in range( 0, 10 ) :
+			with Gaffer.Context() as c :
+				c.setFrame( frame )
+				s["n"]["user"]["a"].setValue( frame * 2 )
+				self.assertEqual( s["n"]["user"]["b"].getValue(), frame * 3 )
+
 if __name__ == "__main__":
 	unittest.main()
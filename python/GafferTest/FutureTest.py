@@ -0,0 +1,144 @@
+##########################################################################
+#
+#  Copyright (c) 2016, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+
+import unittest
+
+import IECore
+
+import Gaffer
+import GafferTest
+
+class FutureTest( GafferTest.TestCase ) :
+
+	def testGetValueAsync( self ) :
+
+		n = GafferTest.AddNode()
+		n["op1"].setValue( 1 )
+		n["op2"].setValue( 2 )
+
+		f = n["sum"].getValueAsync()
+		self.assertEqual( f.result(), 3 )
+		self.assertTrue( f.done() )
+		self.assertFalse( f.cancelled() )
+
+	def testHashAsync( self ) :
+
+		n = GafferTest.AddNode()
+		n["op1"].setValue( 1 )
+
+		f = n["sum"].hashAsync()
+		self.assertEqual( f.result(), n["sum"].hash() )
+
+	def testContextIsCaptured( self ) :
+
+		n = GafferTest.FrameNode()
+
+		with Gaffer.Context() as c :
+			c.setFrame( 10 )
+			f = n["output"].getValueAsync()
+			c.setFrame( 20 )
+
+		self.assertEqual( f.result(), 10 )
+
+	def testManyConcurrentValues( self ) :
+
+		nodes = []
+		for i in range( 0, 100 ) :
+			n = GafferTest.AddNode()
+			n["op1"].setValue( i )
+			n["op2"].setValue( 1 )
+			nodes.append( n )
+
+		futures = [ n["sum"].getValueAsync() for n in nodes ]
+		self.assertEqual( [ f.result() for f in futures ], range( 1, 101 ) )
+
+	def testValueTypes( self ) :
+
+		n = Gaffer.Node()
+		n["s"] = Gaffer.StringPlug( defaultValue = "test" )
+		n["b"] = Gaffer.BoolPlug( defaultValue = True )
+		n["v"] = Gaffer.V3fPlug( defaultValue = IECore.V3f( 1, 2, 3 ) )
+		n["box"] = Gaffer.Box2iPlug( defaultValue = IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( 10 ) ) )
+		n["o"] = Gaffer.ObjectPlug( defaultValue = IECore.IntVectorData( [ 1, 2, 3 ] ) )
+
+		for name in [ "s", "b", "v", "box", "o" ] :
+			self.assertEqual( n[name].getValueAsync().result(), n[name].getValue() )
+
+	def testErrors( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = GafferTest.AddNode()
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( 'parent["n"]["op1"] = 1 / 0' )
+
+		f = s["n"]["sum"].getValueAsync()
+		f.wait()
+		self.assertTrue( f.done() )
+		self.assertFalse( f.cancelled() )
+		self.assertRaises( RuntimeError, f.result )
+
+	def testCancel( self ) :
+
+		n = GafferTest.AddNode()
+		f = n["sum"].getValueAsync()
+		f.cancel()
+		f.wait()
+
+		self.assertTrue( f.done() )
+		if f.cancelled() :
+			self.assertRaises( RuntimeError, f.result )
+		else :
+			# The work got done before we could cancel it.
+			self.assertEqual( f.result(), 0 )
+
+		# Cancellation doesn't affect subsequent evaluations.
+		self.assertEqual( n["sum"].getValueAsync().result(), 0 )
+
+	def testFutureKeepsPlugAlive( self ) :
+
+		p = Gaffer.IntPlug( defaultValue = 3 )
+		h = p.hash()
+
+		f1 = p.getValueAsync()
+		f2 = p.hashAsync()
+		del p
+
+		self.assertEqual( f1.result(), 3 )
+		self.assertEqual( f2.result(), h )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -760,5 +760,90 @@ class GraphComponentTest( GafferTest.TestCase ) :
 		self.assertRaisesRegexp( KeyError, "'a' is not a child of 'GraphComponent'", g.__getitem__, "a" )
 		self.assertRaisesRegexp( KeyError, "'a' is not a child of 'GraphComponent'", g.__delitem__, "a" )
 
+	def testUniqueNamingWithManyChildren( self ) :
+
+		# Wide parents maintain an index of their children, which
+		# must produce the same names as a search of the siblings.
+
+		p = Gaffer.GraphComponent()
+		for i in range( 0, 100 ) :
+			p.addChild( Gaffer.GraphComponent( "padding" ) )
+
+		c1 = Gaffer.GraphComponent( "a" )
+		c2 = Gaffer.GraphComponent( "a" )
+		c3 = Gaffer.GraphComponent( "a" )
+
+		p.addChild( c1 )
+		self.assertEqual( c1.getName(), "a" )
+		p.addChild( c2 )
+		self.assertEqual( c2.getName(), "a1" )
+		p.addChild( c3 )
+		self.assertEqual( c3.getName(), "a2" )
+
+		c4 = Gaffer.GraphComponent( "a1" )
+		p.addChild( c4 )
+		self.assertEqual( c4.getName(), "a3" )
+
+		c1.setName( "b" )
+		c2.setName( "b" )
+		c3.setName( "b" )
+		c4.setName( "b" )
+
+		self.assertEqual( c1.getName(), "b" )
+		self.assertEqual( c2.getName(), "b1" )
+		self.assertEqual( c3.getName(), "b2" )
+		self.assertEqual( c4.getName(), "b3" )
+
+		# Renaming a child shouldn't take its own suffix into account.
+		c4.setName( "b" )
+		self.assertEqual( c4.getName(), "b3" )
+
+		p.addChild( Gaffer.GraphComponent( "a1somethingElse" ) )
+		c5 = Gaffer.GraphComponent( "a" )
+		p.addChild( c5 )
+		self.assertEqual( c5.getName(), "a" )
+
+		# Suffixes freed by removal are available again.
+		p.removeChild( c4 )
+		p.addChild( Gaffer.GraphComponent( "b" ) )
+		self.assertEqual( p[-1].getName(), "b3" )
+
+	def testGetChildWithManyChildren( self ) :
+
+		p = Gaffer.GraphComponent()
+		children = []
+		for i in range( 0, 1000 ) :
+			c = Gaffer.GraphComponent( "c%d" % i )
+			p.addChild( c )
+			children.append( c )
+
+		for i, c in enumerate( children ) :
+			self.assertTrue( p["c%d" % i].isSame( c ) )
+			self.assertTrue( p.descendant( "c%d" % i ).isSame( c ) )
+
+		children[10].setName( "renamed" )
+		self.assertTrue( "c10" not in p )
+		self.assertTrue( p["renamed"].isSame( children[10] ) )
+
+		p.removeChild( children[20] )
+		self.assertTrue( "c20" not in p )
+		self.assertEqual( children[20].getName(), "c20" )
+
+		p.addChild( children[20] )
+		self.assertTrue( p["c20"].isSame( children[20] ) )
+
+		children[30].setName( "c40" )
+		self.assertEqual( children[30].getName(), "c1000" )
+		self.assertTrue( p["c40"].isSame( children[40] ) )
+		self.assertTrue( p["c1000"].isSame( children[30] ) )
+
+		p.clearChildren()
+		self.assertEqual( len( p ), 0 )
+		self.assertTrue( "c0" not in p )
+
+	def testManyChildrenPerformance( self ) :
+
+		GafferTest.testGraphComponentManyChildren()
+
 if __name__ == "__main__":
 	unittest.main()
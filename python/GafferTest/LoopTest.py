@@ -178,5 +178,78 @@ class LoopTest( GafferTest.TestCase ) :
 
 		self.assertTrue( n.correspondingInput( n["out"] ).isSame( n["in"] ) )
 
+	def testManyIterations( self ) :
+
+		n = self.intLoop()
+		a = GafferTest.AddNode()
+
+		n["in"].setValue( 0 )
+		n["next"].setInput( a["sum"] )
+
+		a["op1"].setInput( n["previous"] )
+		a["op2"].setValue( 1 )
+
+		# Enough iterations to exhaust the stack if each
+		# one were evaluated by recursing into the last.
+		n["iterations"].setValue( 100000 )
+		self.assertEqual( n["out"].getValue(), 100000 )
+
+		a["op2"].setValue( 2 )
+		self.assertEqual( n["out"].getValue(), 200000 )
+
+		n["iterations"].setValue( 100001 )
+		self.assertEqual( n["out"].getValue(), 200002 )
+
+	def testManyIterationsWithoutCaching( self ) :
+
+		n = self.intLoop()
+		a = GafferTest.AddNode()
+
+		n["in"].setValue( 0 )
+		n["next"].setInput( a["sum"] )
+
+		a["op1"].setInput( n["previous"] )
+		a["op2"].setValue( 1 )
+
+		n["iterations"].setValue( 100000 )
+
+		originalHashCacheSizeLimit = Gaffer.ValuePlug.getHashCacheSizeLimit()
+		originalCacheMemoryLimit = Gaffer.ValuePlug.getCacheMemoryLimit()
+		try :
+			# The iterations must not depend on the caches
+			# to avoid recursing through every earlier one.
+			Gaffer.ValuePlug.setHashCacheSizeLimit( 0 )
+			Gaffer.ValuePlug.setCacheMemoryLimit( 0 )
+			self.assertEqual( n["out"].getValue(), 100000 )
+			a["op2"].setValue( 2 )
+			self.assertEqual( n["out"].getValue(), 200000 )
+		finally :
+			Gaffer.ValuePlug.setHashCacheSizeLimit( originalHashCacheSizeLimit )
+			Gaffer.ValuePlug.setCacheMemoryLimit( originalCacheMemoryLimit )
+
+	def testHeldIterationsDontDependOnAllVariables( self ) :
+
+		n = self.intLoop()
+		a = GafferTest.AddNode()
+
+		n["in"].setValue( 0 )
+		n["next"].setInput( a["sum"] )
+
+		a["op1"].setInput( n["previous"] )
+		a["op2"].setValue( 1 )
+
+		n["iterations"].setValue( 10 )
+
+		# Nothing in the loop depends on the frame, so the
+		# hash for one frame should be reused for the next.
+		with Gaffer.PerformanceMonitor() as m :
+			with Gaffer.Context() as c :
+				c.setFrame( 1 )
+				h = n["out"].hash()
+				c.setFrame( 2 )
+				self.assertEqual( n["out"].hash(), h )
+
+		self.assertEqual( m.plugStatistics( n["out"] ).hashCount, 1 )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -1014,5 +1014,59 @@ class MetadataTest( GafferTest.TestCase ) :
 		self.assertEqual( Gaffer.Metadata.registeredValues( n, instanceOnly = True ), [] )
 		self.assertEqual( Gaffer.Metadata.registeredValues( n["op1"], instanceOnly = True ), [] )
 
+	def testRepeatedQueriesSeeNewRegistrations( self ) :
+
+		n = GafferTest.AddNode()
+		self.assertEqual( Gaffer.Metadata.value( n["op1"], "repeatedQueryTest" ), None )
+		self.assertEqual( Gaffer.Metadata.value( n["op2"], "repeatedQueryTest" ), None )
+
+		Gaffer.Metadata.registerValue( Gaffer.Node, "op*", "repeatedQueryTest", "wildcard" )
+		self.assertEqual( Gaffer.Metadata.value( n["op1"], "repeatedQueryTest" ), "wildcard" )
+		self.assertEqual( Gaffer.Metadata.value( n["op2"], "repeatedQueryTest" ), "wildcard" )
+		self.assertEqual( Gaffer.Metadata.value( n["sum"], "repeatedQueryTest" ), None )
+
+		Gaffer.Metadata.registerValue( GafferTest.AddNode, "op2", "repeatedQueryTest", "exact" )
+		self.assertEqual( Gaffer.Metadata.value( n["op1"], "repeatedQueryTest" ), "wildcard" )
+		self.assertEqual( Gaffer.Metadata.value( n["op2"], "repeatedQueryTest" ), "exact" )
+
+		Gaffer.Metadata.deregisterValue( GafferTest.AddNode, "op2", "repeatedQueryTest" )
+		self.assertEqual( Gaffer.Metadata.value( n["op2"], "repeatedQueryTest" ), "wildcard" )
+
+		Gaffer.Metadata.deregisterValue( Gaffer.Node, "op*", "repeatedQueryTest" )
+		self.assertEqual( Gaffer.Metadata.value( n["op1"], "repeatedQueryTest" ), None )
+		self.assertEqual( Gaffer.Metadata.value( n["op2"], "repeatedQueryTest" ), None )
+
+	def testRepeatedQueriesCallValueFunctions( self ) :
+
+		calls = []
+		def f( plug ) :
+			calls.append( plug )
+			return plug.getName()
+
+		Gaffer.Metadata.registerValue( GafferTest.AddNode, "*", "repeatedQueryFunctionTest", f )
+		self.addCleanup( Gaffer.Metadata.deregisterValue, GafferTest.AddNode, "*", "repeatedQueryFunctionTest" )
+
+		n = GafferTest.AddNode()
+		for i in range( 0, 3 ) :
+			self.assertEqual( Gaffer.Metadata.value( n["op1"], "repeatedQueryFunctionTest" ), "op1" )
+			self.assertEqual( Gaffer.Metadata.value( n["op2"], "repeatedQueryFunctionTest" ), "op2" )
+
+		self.assertEqual( len( calls ), 6 )
+
+	def testValueFunctionDeregisteringItself( self ) :
+
+		# Deregistering destroys the registered function and clears
+		# the memoised queries while the function is still running.
+		def f( plug ) :
+			Gaffer.Metadata.deregisterValue( GafferTest.AddNode, "op1", "deregisterSelfTest" )
+			return "a" * 1000
+
+		Gaffer.Metadata.registerValue( GafferTest.AddNode, "op1", "deregisterSelfTest", f )
+		del f
+
+		n = GafferTest.AddNode()
+		self.assertEqual( Gaffer.Metadata.value( n["op1"], "deregisterSelfTest" ), "a" * 1000 )
+		self.assertEqual( Gaffer.Metadata.value( n["op1"], "deregisterSelfTest" ), None )
+
 if __name__ == "__main__":
 	unittest.main()
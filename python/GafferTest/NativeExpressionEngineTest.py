@@ -0,0 +1,392 @@
+##########################################################################
+#
+#  Copyright (c) 2016, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import unittest
+import inspect
+import threading
+
+import IECore
+
+import Gaffer
+import GafferTest
+
+class NativeExpressionEngineTest( GafferTest.TestCase ) :
+
+	def testLanguages( self ) :
+
+		self.assertTrue( "native" in Gaffer.Expression.languages() )
+
+	def testPlugTypes( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		for name, plugType in [ ( "b", Gaffer.BoolPlug ), ( "i", Gaffer.IntPlug ), ( "f", Gaffer.FloatPlug ), ( "s", Gaffer.StringPlug ) ] :
+			s["n"]["user"][name+"In"] = plugType( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+			s["n"]["user"][name+"Out"] = plugType( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression(
+			inspect.cleandoc(
+				"""
+				parent.n.user.bOut = !parent.n.user.bIn;
+				parent.n.user.iOut = parent.n.user.iIn * 2;
+				parent.n.user.fOut = parent.n.user.fIn / 2;
+				parent.n.user.sOut = parent.n.user.sIn + "!";
+				"""
+			),
+			"native"
+		)
+
+		s["n"]["user"]["bIn"].setValue( True )
+		s["n"]["user"]["iIn"].setValue( 3 )
+		s["n"]["user"]["fIn"].setValue( 3 )
+		s["n"]["user"]["sIn"].setValue( "hi" )
+
+		self.assertEqual( s["n"]["user"]["bOut"].getValue(), False )
+		self.assertEqual( s["n"]["user"]["iOut"].getValue(), 6 )
+		self.assertEqual( s["n"]["user"]["fOut"].getValue(), 1.5 )
+		self.assertEqual( s["n"]["user"]["sOut"].getValue(), "hi!" )
+
+	def testUnsupportedPlugs( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["user"]["c"] = Gaffer.Color3fPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		s["e"] = Gaffer.Expression()
+		self.assertRaisesRegexp( RuntimeError, "Unsupported plug type", s["e"].setExpression, "parent.n.user.c = 1", "native" )
+		self.assertEqual( s["e"].identifier( s["n"]["user"]["c"] ), "" )
+		self.assertEqual( Gaffer.Expression.defaultExpression( s["n"]["user"]["c"], "native" ), "" )
+
+	def testArithmetic( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["user"]["f"] = Gaffer.FloatPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n"]["user"]["i"] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		s["e"] = Gaffer.Expression()
+
+		for expression, expected in [
+			( "parent.n.user.i = 1 + 2 * 3", 7 ),
+			( "parent.n.user.i = ( 1 + 2 ) * 3", 9 ),
+			( "parent.n.user.i = 7 / 2", 3 ),
+			( "parent.n.user.i = 7 % 4", 3 ),
+			( "parent.n.user.i = -2 * 3", -6 ),
+			( "parent.n.user.i = abs( -2 )", 2 ),
+			( "parent.n.user.i = min( 2, 3 ) + max( 2, 3 )", 5 ),
+			( "parent.n.user.i = clamp( 10, 0, 5 )", 5 ),
+			( "parent.n.user.i = int( \"12\" )", 12 ),
+			( "parent.n.user.i = 2 > 1 && 1 > 2", 0 ),
+			( "parent.n.user.i = 2 > 1 || 1 > 2", 1 ),
+			( "parent.n.user.f = 7 / 2.0", 3.5 ),
+			( "parent.n.user.f = floor( 1.5 ) + ceil( 1.5 )", 3 ),
+			( "parent.n.user.f = pow( 2, 3 ) + sqrt( 4 )", 10 ),
+		] :
+			s["e"].setExpression( expression, "native" )
+			plug = s["n"]["user"]["i"] if ".i =" in expression else s["n"]["user"]["f"]
+			self.assertEqual( plug.getValue(), expected, expression )
+
+	def testContext( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["user"]["f"] = Gaffer.FloatPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n"]["user"]["s"] = Gaffer.StringPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n"]["user"]["i"] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression(
+			inspect.cleandoc(
+				"""
+				parent.n.user.f = context( "frame" ) * 0.5 + 3;
+				parent.n.user.s = format( "%s_%03d", context( "shot", "default" ), int( context( "frame" ) ) );
+				parent.n.user.i = context( "frame" ) > 10 ? 1 : context( "i", 2 );
+				"""
+			),
+			"native"
+		)
+
+		with Gaffer.Context() as c :
+
+			c.setFrame( 4 )
+			self.assertEqual( s["n"]["user"]["f"].getValue(), 5 )
+			self.assertEqual( s["n"]["user"]["s"].getValue(), "default_004" )
+			self.assertEqual( s["n"]["user"]["i"].getValue(), 2 )
+
+			c.setFrame( 20 )
+			c["shot"] = "sh010"
+			c["i"] = 3
+			self.assertEqual( s["n"]["user"]["f"].getValue(), 13 )
+			self.assertEqual( s["n"]["user"]["s"].getValue(), "sh010_020" )
+			self.assertEqual( s["n"]["user"]["i"].getValue(), 1 )
+
+			c.setFrame( 1 )
+			self.assertEqual( s["n"]["user"]["i"].getValue(), 3 )
+
+			c["shot"] = IECore.V3fData( IECore.V3f( 1 ) )
+			self.assertRaisesRegexp( RuntimeError, "unsupported type", s["n"]["user"]["s"].getValue )
+
+	def testMissingContextVariable( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["user"]["i"] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( 'parent.n.user.i = context( "iDontExist" )', "native" )
+
+		self.assertRaisesRegexp( RuntimeError, "Context has no entry named \"iDontExist\"", s["n"]["user"]["i"].getValue )
+
+	def testIntegerOverflow( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["user"]["i"] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		s["e"] = Gaffer.Expression()
+
+		with Gaffer.Context() as c :
+
+			c["min"] = -2147483648
+			c["max"] = 2147483647
+
+			for expression in [
+				'parent.n.user.i = context( "min" ) / -1',
+				'parent.n.user.i = -context( "min" )',
+				'parent.n.user.i = context( "max" ) + 1',
+				'parent.n.user.i = context( "min" ) - 1',
+				'parent.n.user.i = context( "max" ) * 2',
+				'parent.n.user.i = abs( context( "min" ) )',
+				'parent.n.user.i = int( 3e9 )',
+				'parent.n.user.i = int( -3e9 )',
+				'parent.n.user.i = int( pow( 10, 400 ) )',
+				'parent.n.user.i = int( sqrt( -1 ) )',
+				'parent.n.user.i = 3e9',
+				'parent.n.user.i = sqrt( -1 )',
+			] :
+				s["e"].setExpression( expression, "native" )
+				self.assertRaisesRegexp( RuntimeError, "Integer overflow", s["n"]["user"]["i"].getValue )
+
+			for expression, expected in [
+				( 'parent.n.user.i = context( "min" ) % -1', 0 ),
+				( 'parent.n.user.i = context( "max" ) + context( "min" )', -1 ),
+				( 'parent.n.user.i = context( "min" ) / 1', -2147483648 ),
+				( 'parent.n.user.i = abs( context( "max" ) )', 2147483647 ),
+				( 'parent.n.user.i = int( -2147483648.9 )', -2147483648 ),
+				( 'parent.n.user.i = 2147483647.9', 2147483647 ),
+				( 'parent.n.user.i = 2147483647', 2147483647 ),
+			] :
+				s["e"].setExpression( expression, "native" )
+				self.assertEqual( s["n"]["user"]["i"].getValue(), expected, expression )
+
+		for expression in [
+			'parent.n.user.i = 2147483648',
+			'parent.n.user.i = 99999999999999999999999',
+		] :
+			self.assertRaisesRegexp( RuntimeError, "Integer overflow", s["e"].setExpression, expression, "native" )
+
+	def testSyntaxErrors( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["user"]["i"] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( "parent.n.user.i = 1", "native" )
+
+		for expression in [
+			"parent.n.user.i = ",
+			"parent.n.user.i = 1 +",
+			"parent.n.user.i = ( 1",
+			"parent.n.user.i = iDontExist( 1 )",
+			"parent.n.user.i = \"unterminated",
+			"parent.n.user.i = context( 1 )",
+			"parent.n.user.i = min( 1 )",
+			"1 = parent.n.user.i",
+			"parent.n.user.i = 1\nparent.n.user.i = $",
+			"parent.n.user.i = \xc3\xa9",
+		] :
+			self.assertRaisesRegexp( RuntimeError, "Syntax error on line", s["e"].setExpression, expression, "native" )
+			# State should be unchanged.
+			self.assertEqual( s["e"].getExpression(), ( "parent.n.user.i = 1", "native" ) )
+			self.assertEqual( s["n"]["user"]["i"].getValue(), 1 )
+
+		self.assertRaisesRegexp( RuntimeError, ".*does not exist.*", s["e"].setExpression, "parent.notANode.notAPlug = 2", "native" )
+
+	def testDefaultExpression( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["user"]["b"] = Gaffer.BoolPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n"]["user"]["f"] = Gaffer.FloatPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n"]["user"]["i"] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n"]["user"]["s"] = Gaffer.StringPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		s["n"]["user"]["b"].setValue( True )
+		s["n"]["user"]["f"].setValue( 10.5 )
+		s["n"]["user"]["i"].setValue( -10 )
+		s["n"]["user"]["s"].setValue( "a \"quoted\" \\ string" )
+
+		defaultExpressions = [ Gaffer.Expression.defaultExpression( p, "native" ) for p in s["n"]["user"].children() ]
+		expectedValues = [ p.getValue() for p in s["n"]["user"].children() ]
+
+		for p in s["n"]["user"].children() :
+			p.setToDefault()
+
+		s["e"] = Gaffer.Expression()
+		for p, e, v in zip( s["n"]["user"].children(), defaultExpressions, expectedValues ) :
+			s["e"].setExpression( e, "native" )
+			self.assertEqual( p.getValue(), v )
+
+	def testEmptyExpression( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["e"] = Gaffer.Expression()
+
+		s["e"].setExpression( "", "native" )
+		self.assertEqual( s["e"].getExpression(), ( "", "native" ) )
+
+	def testSerialisation( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["user"]["i"] = Gaffer.FloatPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n"]["user"]["o"] = Gaffer.FloatPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( "parent.n.user.o = parent.n.user.i + 1;", "native" )
+
+		s["n"]["user"]["i"].setValue( 1 )
+		self.assertEqual( s["n"]["user"]["o"].getValue(), 2 )
+
+		s2 = Gaffer.ScriptNode()
+		s2.execute( s.serialise() )
+
+		self.assertEqual( s2["n"]["user"]["o"].getValue(), 2 )
+		s2["n"]["user"]["i"].setValue( 2 )
+		self.assertEqual( s2["n"]["user"]["o"].getValue(), 3 )
+
+	def testRenamePlugs( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["user"]["i"] = Gaffer.FloatPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n"]["user"]["ii"] = Gaffer.FloatPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n"]["user"]["o"] = Gaffer.FloatPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( "parent.n.user.o = parent.n.user.i + parent.n.user.ii + 1;", "native" )
+
+		self.assertEqual( s["n"]["user"]["o"].getValue(), 1 )
+
+		s["n"]["user"]["i"].setName( "I" )
+		s["n"]["user"]["o"].setName( "O" )
+
+		self.assertEqual( s["n"]["user"]["O"].getValue(), 1 )
+		self.assertEqual( s["e"].getExpression(), ( "parent.n.user.O = parent.n.user.I + parent.n.user.ii + 1;", "native" ) )
+
+	def testDeletePlugs( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["n1"] = Gaffer.Node()
+		s["n1"]["user"]["f1"] = Gaffer.FloatPlug( defaultValue = 1, flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n1"]["user"]["f2"] = Gaffer.FloatPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		s["n2"] = Gaffer.Node()
+		s["n2"]["user"]["f1"] = Gaffer.FloatPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n2"]["user"]["f2"] = Gaffer.FloatPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression(
+			inspect.cleandoc(
+				"""
+				parent.n2.user.f1 = parent.n1.user.f1 + parent.n1.user.f2;
+				parent.n2.user.f2 = 2;
+				"""
+			),
+			"native"
+		)
+
+		s["n1"]["user"]["f1"].setValue( 2 )
+		s["n1"]["user"]["f2"].setValue( 4 )
+		self.assertEqual( s["n2"]["user"]["f1"].getValue(), 6 )
+
+		del s["n1"]["user"]["f1"]
+		self.assertEqual( s["n2"]["user"]["f1"].getValue(), 5 )
+
+		del s["n2"]["user"]["f2"]
+		self.assertTrue( "_disconnected = 2" in s["e"].getExpression()[0] )
+
+		s["e"].setExpression(
+			"// I should be able to edit a broken expression\n" +
+			s["e"].getExpression()[0],
+			"native"
+		)
+
+		self.assertEqual( s["n2"]["user"]["f1"].getValue(), 5 )
+
+	def testConcurrentEvaluation( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = Gaffer.Node()
+		s["n"]["user"]["f"] = Gaffer.FloatPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+
+		s["e"] = Gaffer.Expression()
+		s["e"].setExpression( 'parent.n.user.f = context( "frame" ) * 2', "native" )
+
+		errors = []
+		def f( frames ) :
+
+			try :
+				with Gaffer.Context() as c :
+					for frame in frames :
+						c.setFrame( frame )
+						self.assertEqual( s["n"]["user"]["f"].getValue(), frame * 2 )
+			except Exception as e :
+				errors.append( e )
+
+		threads = [ threading.Thread( target = f, args = ( range( i, 1000, 4 ), ) ) for i in range( 0, 4 ) ]
+		for t in threads :
+			t.start()
+		for t in threads :
+			t.join()
+
+		self.assertEqual( errors, [] )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -35,6 +35,7 @@
 ##########################################################################
 
 import os
+import json
 import time
 import unittest
 
@@ -43,6 +44,50 @@ import IECore
 import Gaffer
 import GafferTest
 
+class DurationNode( Gaffer.ComputeNode ) :
+
+	def __init__( self, name = "DurationNode" ) :
+
+		Gaffer.ComputeNode.__init__( self, name )
+
+		self["in"] = Gaffer.FloatPlug()
+		self["out"] = Gaffer.FloatPlug( direction = Gaffer.Plug.Direction.Out )
+
+		self["hashDuration"] = Gaffer.FloatPlug()
+		self["computeDuration"] = Gaffer.FloatPlug()
+
+	def affects( self, input ) :
+
+		result = Gaffer.ComputeNode.affects( self, input )
+		if input in ( self["in"], self["hashDuration"], self["computeDuration"] ) :
+			result.append( self["out"] )
+
+		return result
+
+	def hash( self, output, context, h ) :
+
+		if output.isSame( self["out"] ) :
+
+			self["in"].hash( h )
+			self["computeDuration"].hash( h )
+
+			time.sleep( self["hashDuration"].getValue() )
+
+	def compute( self, plug, context ) :
+
+		if plug.isSame( self["out"] ) :
+
+			d = self["computeDuration"].getValue()
+			time.sleep( d )
+
+			self["out"].setValue( self["in"].getValue() + d )
+
+		else :
+
+			ComputeNode.compute( self, plug, context )
+
+IECore.registerRunTimeTyped( DurationNode )
+
 class PerformanceMonitorTest( GafferTest.TestCase ) :
 
 	def testActiveStatus( self ) :
@@ -142,50 +187,6 @@ class PerformanceMonitorTest( GafferTest.TestCase ) :
 
 	def testDurations( self ) :
 
-		class DurationNode( Gaffer.ComputeNode ) :
-
-			def __init__( self, name = "DurationNode" ) :
-
-				Gaffer.ComputeNode.__init__( self, name )
-
-				self["in"] = Gaffer.FloatPlug()
-				self["out"] = Gaffer.FloatPlug( direction = Gaffer.Plug.Direction.Out )
-
-				self["hashDuration"] = Gaffer.FloatPlug()
-				self["computeDuration"] = Gaffer.FloatPlug()
-
-			def affects( self, input ) :
-
-				result = Gaffer.ComputeNode.affects( self, input )
-				if input in ( self["in"], self["hashDuration"], self["computeDuration"] ) :
-					result.append( self["out"] )
-
-				return result
-
-			def hash( self, output, context, h ) :
-
-				if output.isSame( self["out"] ) :
-
-					self["in"].hash( h )
-					self["computeDuration"].hash( h )
-
-					time.sleep( self["hashDuration"].getValue() )
-
-			def compute( self, plug, context ) :
-
-				if plug.isSame( self["out"] ) :
-
-					d = self["computeDuration"].getValue()
-					time.sleep( d )
-
-					self["out"].setValue( self["in"].getValue() + d )
-
-				else :
-
-					ComputeNode.compute( self, plug, context )
-
-		IECore.registerRunTimeTyped( DurationNode )
-
 		n1 = DurationNode( "n1" )
 		n1["hashDuration"].setValue( 0.2 )
 		n1["computeDuration"].setValue( 0.4 )
@@ -217,10 +218,12 @@ class PerformanceMonitorTest( GafferTest.TestCase ) :
 		self.assertAlmostEqual( seconds( m.plugStatistics( n2["out"] ).hashDuration ), 0.1, delta = delta )
 		self.assertAlmostEqual( seconds( m.plugStatistics( n2["out"] ).computeDuration ), 0.2, delta = delta )
 
+		# Force rehash, but not recompute. We can't do this by adding
+		# an unrelated context variable, because the hash cache knows
+		# it can't affect the result.
+		Gaffer.ValuePlug.clearHashCache()
 		with m :
-			with Gaffer.Context() as c :
-				c["test"] = 1 # force rehash, but not recompute
-				n2["out"].getValue()
+			n2["out"].getValue()
 
 		self.assertEqual( m.plugStatistics( n1["out"] ).hashCount, 2 )
 		self.assertEqual( m.plugStatistics( n1["out"] ).computeCount, 1 )
@@ -232,5 +235,153 @@ class PerformanceMonitorTest( GafferTest.TestCase ) :
 		self.assertAlmostEqual( seconds( m.plugStatistics( n2["out"] ).hashDuration ), 0.2, delta = delta )
 		self.assertAlmostEqual( seconds( m.plugStatistics( n2["out"] ).computeDuration ), 0.2, delta = delta )
 
+	def testEventsNotRecordedByDefault( self ) :
+
+		a = GafferTest.AddNode()
+
+		with Gaffer.PerformanceMonitor() as m :
+			a["sum"].getValue()
+
+		self.assertFalse( m.getRecordEvents() )
+		self.assertEqual( m.events(), [] )
+		self.assertEqual( m.plugStatistics( a["sum"] ).computeCount, 1 )
+
+	def testEvents( self ) :
+
+		a1 = GafferTest.AddNode()
+		a2 = GafferTest.AddNode()
+		a2["op1"].setInput( a1["sum"] )
+
+		with Gaffer.PerformanceMonitor( recordEvents = True ) as m :
+			a2["sum"].getValue()
+
+		self.assertTrue( m.getRecordEvents() )
+
+		events = m.events()
+		self.assertEqual(
+			sorted( [ ( e.plug.fullName(), e.type ) for e in events ] ),
+			sorted( [
+				( a1["sum"].fullName(), "computeNode:hash" ),
+				( a1["sum"].fullName(), "computeNode:compute" ),
+				( a2["sum"].fullName(), "computeNode:hash" ),
+				( a2["sum"].fullName(), "computeNode:compute" ),
+			] )
+		)
+
+		self.assertEqual( [ e.start for e in events ], sorted( e.start for e in events ) )
+		for e in events :
+			self.assertGreaterEqual( e.end, e.start )
+			self.assertEqual( e.thread, 0 )
+
+		# The hash and compute for a1 are invoked from those for a2,
+		# so should be parented to them.
+		byKey = { ( e.plug.fullName(), e.type ) : e for e in events }
+		for type in ( "computeNode:hash", "computeNode:compute" ) :
+			parent = byKey[( a2["sum"].fullName(), type )]
+			child = byKey[( a1["sum"].fullName(), type )]
+			self.assertEqual( parent.parentProcessId, 0 )
+			self.assertEqual( child.parentProcessId, parent.processId )
+			self.assertGreaterEqual( child.start, parent.start )
+			self.assertLessEqual( child.end, parent.end )
+
+	def testFormatChromeTrace( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["a"] = GafferTest.AddNode()
+
+		with Gaffer.PerformanceMonitor( recordEvents = True ) as m :
+			s["a"]["sum"].getValue()
+
+		trace = json.loads( Gaffer.MonitorAlgo.formatChromeTrace( m ) )
+		self.assertEqual( len( trace["traceEvents"] ), 2 )
+		for event in trace["traceEvents"] :
+			self.assertEqual( event["name"], "a.sum" )
+			self.assertEqual( event["ph"], "X" )
+			self.assertGreaterEqual( event["dur"], 0 )
+		self.assertEqual(
+			set( [ e["cat"] for e in trace["traceEvents"] ] ),
+			{ "computeNode:hash", "computeNode:compute" }
+		)
+
+	def testFormatFlameGraph( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["a1"] = GafferTest.AddNode()
+		s["a2"] = GafferTest.AddNode()
+		s["a2"]["op1"].setInput( s["a1"]["sum"] )
+
+		with Gaffer.PerformanceMonitor( recordEvents = True ) as m :
+			s["a2"]["sum"].getValue()
+
+		stacks = {}
+		for line in Gaffer.MonitorAlgo.formatFlameGraph( m ).strip().split( "\n" ) :
+			stack, weight = line.rsplit( " ", 1 )
+			stacks[stack] = int( weight )
+
+		self.assertEqual(
+			set( stacks.keys() ),
+			{
+				"a2.sum (computeNode:hash)",
+				"a2.sum (computeNode:hash);a1.sum (computeNode:hash)",
+				"a2.sum (computeNode:compute)",
+				"a2.sum (computeNode:compute);a1.sum (computeNode:compute)",
+			}
+		)
+
+		# Self time excludes the time spent in children.
+		events = { ( e.plug.relativeName( s ), e.type ) : e for e in m.events() }
+		parent = events[( "a2.sum", "computeNode:compute" )]
+		self.assertLessEqual( stacks["a2.sum (computeNode:compute)"], parent.end - parent.start )
+
+	def testSampling( self ) :
+
+		m = Gaffer.PerformanceMonitor( sampleInterval = 10 )
+		self.assertEqual( m.getSampleInterval(), 10 )
+		self.assertEqual( Gaffer.PerformanceMonitor().getSampleInterval(), 1 )
+
+		nodes = [ GafferTest.AddNode() for i in range( 0, 100 ) ]
+		for i, n in enumerate( nodes ) :
+			n["op1"].setValue( i )
+
+		with m :
+			for n in nodes :
+				n["sum"].getValue()
+
+		# Counts are exact even when sampling.
+		for n in nodes :
+			self.assertEqual( m.plugStatistics( n["sum"] ).hashCount, 1 )
+			self.assertEqual( m.plugStatistics( n["sum"] ).computeCount, 1 )
+
+		# A chain of nodes, where each compute is nested
+		# inside the compute for the node downstream.
+		nodes = []
+		for i in range( 0, 20 ) :
+			n = DurationNode()
+			n["computeDuration"].setValue( 0.01 )
+			if nodes :
+				n["in"].setInput( nodes[-1]["out"] )
+			nodes.append( n )
+
+		with Gaffer.PerformanceMonitor( sampleInterval = 2 ) as m :
+			nodes[-1]["out"].getValue()
+
+		for n in nodes :
+			self.assertEqual( m.plugStatistics( n["out"] ).computeCount, 1 )
+
+		# The time spent in unsampled processes must not be
+		# billed to their parents as well as being extrapolated
+		# from the sampled ones, so the total remains close to
+		# the actual time spent.
+		totalComputeDuration = sum( m.plugStatistics( n["out"] ).computeDuration for n in nodes ) / 1000000000.0
+		self.assertAlmostEqual( totalComputeDuration, 0.2, delta = 0.05 if "TRAVIS" not in os.environ else 0.12 )
+
+	def testOverhead( self ) :
+
+		GafferTest.testPerformanceMonitorOverhead()
+
+	def testSamplingAliasing( self ) :
+
+		GafferTest.testPerformanceMonitorSamplingAliasing()
+
 if __name__ == "__main__":
 	unittest.main()
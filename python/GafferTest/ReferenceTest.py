@@ -1067,6 +1067,57 @@ class ReferenceTest( GafferTest.TestCase ) :
 
 		self.assertTrue( s["a"]["op1"].getInput().isSame( s["r"]["color"]["g"] ) )
 
+	def testLoadManyInstances( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["b"] = Gaffer.Box()
+		s["b"]["n"] = GafferTest.AddNode()
+		s["b"]["n"]["op2"].setValue( 2 )
+		s["b"].promotePlug( s["b"]["n"]["op1"] )
+		s["b"].promotePlug( s["b"]["n"]["sum"] )
+		s["b"].exportForReference( self.temporaryDirectory() + "/test.grf" )
+
+		for i in range( 0, 20 ) :
+			s["r%d" % i] = Gaffer.Reference()
+			s["r%d" % i].load( self.temporaryDirectory() + "/test.grf" )
+			s["r%d" % i]["op1"].setValue( i )
+
+		for i in range( 0, 20 ) :
+			r = s["r%d" % i]
+			self.assertEqual( r.keys(), s["r0"].keys() )
+			self.assertTrue( r["n"]["op1"].getInput().isSame( r["op1"] ) )
+			self.assertTrue( r["sum"].getInput().isSame( r["n"]["sum"] ) )
+			self.assertEqual( r["sum"].getValue(), i + 2 )
+
+	def testReloadSeesModifiedFile( self ) :
+
+		s = Gaffer.ScriptNode()
+
+		s["b"] = Gaffer.Box()
+		s["b"]["n"] = GafferTest.AddNode()
+		s["b"]["n"]["op2"].setValue( 2 )
+		s["b"].promotePlug( s["b"]["n"]["sum"] )
+		s["b"].exportForReference( self.temporaryDirectory() + "/test.grf" )
+
+		s["r"] = Gaffer.Reference()
+		s["r"].load( self.temporaryDirectory() + "/test.grf" )
+		self.assertEqual( s["r"]["sum"].getValue(), 2 )
+
+		# Modify the file immediately, so that the modification
+		# time may well be unchanged. We must still see the new
+		# contents.
+
+		s["b"]["n"]["op2"].setValue( 3 )
+		s["b"].exportForReference( self.temporaryDirectory() + "/test.grf" )
+
+		s["r"].load( self.temporaryDirectory() + "/test.grf" )
+		self.assertEqual( s["r"]["sum"].getValue(), 3 )
+
+		s["r2"] = Gaffer.Reference()
+		s["r2"].load( self.temporaryDirectory() + "/test.grf" )
+		self.assertEqual( s["r2"]["sum"].getValue(), 3 )
+
 	def tearDown( self ) :
 
 		GafferTest.TestCase.tearDown( self )
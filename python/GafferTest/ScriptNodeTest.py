@@ -1126,6 +1126,115 @@ class ScriptNodeTest( GafferTest.TestCase ) :
 		s = Gaffer.ScriptNode()
 		self.assertRaisesRegexp( RuntimeError, "Line 2 .* name 'iDontExist' is not defined", s.execute, "a = 10\na=iDontExist" )
 
+	def testExecuteSimpleStatements( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n1"] = Gaffer.Node()
+		s["n1"]["i"] = Gaffer.IntPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n1"]["f"] = Gaffer.FloatPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n1"]["b"] = Gaffer.BoolPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n1"]["s"] = Gaffer.StringPlug( flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n1"]["a"] = Gaffer.ArrayPlug( "a", element = Gaffer.IntPlug( "e0" ), flags = Gaffer.Plug.Flags.Default | Gaffer.Plug.Flags.Dynamic )
+		s["n2"] = GafferTest.AddNode()
+
+		s.execute( "\n".join( [
+			'parent["n1"]["i"].setValue( -10 )',
+			'parent["n1"]["f"].setValue( 2 )',
+			'parent["n1"]["f"].setValue( -1.5 )',
+			'parent["n1"]["b"].setValue( True )',
+			'parent["n1"]["s"].setValue( "a\\tb" )',
+			'parent["n2"]["op1"].setInput( parent["n1"]["i"] )',
+			'parent["n2"]["op2"].setInput( parent["n1"]["a"][-1] )',
+			'parent["n1"]["a"][0].setValue( 20 )',
+			'parent["n1"]["a"]["e0"].setValue( 30 )',
+			'parent.addChild( Gaffer.Node( "n3" ) )',
+			'parent["n3"].addChild( Gaffer.IntPlug( "p" ) )',
+		] ) )
+
+		self.assertEqual( s["n1"]["i"].getValue(), -10 )
+		self.assertEqual( s["n1"]["f"].getValue(), -1.5 )
+		self.assertEqual( s["n1"]["b"].getValue(), True )
+		self.assertEqual( s["n1"]["s"].getValue(), "a\tb" )
+		self.assertTrue( s["n2"]["op1"].getInput().isSame( s["n1"]["i"] ) )
+		self.assertTrue( s["n2"]["op2"].getInput().isSame( s["n1"]["a"]["e0"] ) )
+		self.assertEqual( s["n1"]["a"][0].getValue(), 30 )
+		self.assertIsInstance( s["n3"]["p"], Gaffer.IntPlug )
+		self.assertEqual( s["n2"]["sum"].getValue(), 20 )
+
+		s.execute( 'parent["n2"]["op1"].setInput( None )' )
+		self.assertEqual( s["n2"]["op1"].getInput(), None )
+
+	def testExecuteFutureImports( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = GafferTest.AddNode()
+
+		# Future imports must apply to all subsequent statements,
+		# even though they are compiled separately.
+		for continueOnError in ( False, True ) :
+			s.execute(
+				"from __future__ import division\n"
+				"a = 1 / 2\n"
+				"parent['n']['op1'].setValue( int( a * 10 ) )\n",
+				continueOnError = continueOnError
+			)
+			self.assertEqual( s["n"]["op1"].getValue(), 5 )
+			s["n"]["op1"].setValue( 0 )
+
+		# And must still be placed at the start.
+		self.assertRaisesRegexp(
+			RuntimeError, "Line 2 .*beginning of the file",
+			s.execute, "a = 1\nfrom __future__ import division\n"
+		)
+
+	def testExecuteSimpleStatementErrors( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n1"] = GafferTest.AddNode()
+		s["n2"] = GafferTest.AddNode()
+		s["n2"]["op1"].setInput( s["n1"]["sum"] )
+		s["n3"] = Gaffer.Node()
+		s["n3"]["s"] = Gaffer.StringPlug( direction = Gaffer.Plug.Direction.Out )
+
+		# Errors from statements which look simple must be reported
+		# in the same way as any other.
+
+		self.assertRaisesRegexp( RuntimeError, "Line 2 .*", s.execute, 'parent["n1"]["op1"].setValue( 1 )\nparent["n1"]["op1"].setValue( "x" )' )
+		self.assertRaisesRegexp( RuntimeError, "Line 1 .*", s.execute, 'parent["n2"]["op1"].setValue( 1 )' )
+		self.assertRaisesRegexp( RuntimeError, "Line 1 .*", s.execute, 'parent["n1"]["op1"].setInput( parent["n3"]["s"] )' )
+		self.assertRaisesRegexp( RuntimeError, "Line 1 .*", s.execute, 'parent["iDontExist"]["op1"].setValue( 1 )' )
+
+		with IECore.CapturingMessageHandler() as c :
+			self.assertEqual(
+				s.execute( 'parent["n1"]["op1"].setValue( 2.5 )\nparent["n1"]["op2"].setValue( 3 )', continueOnError = True ),
+				True
+			)
+
+		self.assertEqual( len( c.messages ), 1 )
+		self.assertTrue( "Line 1" in c.messages[0].context )
+		self.assertEqual( s["n1"]["op1"].getValue(), 1 )
+		self.assertEqual( s["n1"]["op2"].getValue(), 3 )
+
+	def testLoadPerformanceWithManyValues( self ) :
+
+		s = Gaffer.ScriptNode()
+		for i in range( 0, 100 ) :
+			n = GafferTest.AddNode( "n%d" % i )
+			n["op1"].setValue( i )
+			n["op2"].setValue( i + 1 )
+			if i :
+				n["op1"].setInput( s["n%d" % ( i - 1 )]["sum"] )
+			s.addChild( n )
+
+		serialisation = s.serialise()
+
+		s2 = Gaffer.ScriptNode()
+		s2.execute( serialisation )
+
+		for i in range( 0, 100 ) :
+			self.assertEqual( s2["n%d" % i]["op2"].getValue(), i + 1 )
+		self.assertEqual( s2["n99"]["sum"].getValue(), s["n99"]["sum"].getValue() )
+
 	def testFileVersioning( self ) :
 
 		s = Gaffer.ScriptNode()
@@ -53,6 +53,9 @@ class StringAlgoTest( GafferTest.TestCase ) :
 			( "dog collar", "dog co*", True ),
 			( "dog collar", "dog *", True ),
 			( "dog collar", "dog*", True ),
+			( "a", "a**", True ),
+			( "", "**", True ),
+			( "a", "a*a", False ),
 		] :
 
 			self.assertEqual( Gaffer.StringAlgo.match( s, p ), r )
@@ -75,6 +78,10 @@ class StringAlgoTest( GafferTest.TestCase ) :
 			( "dogcollar", "dog *fish", False ),
 			( "dogcollar", "dog collar", False ),
 			( "a1", "*1 b2", True ),
+			( "group5", "group*7 group5", True ),
+			( "ab", "a*x ab", True ),
+			( "cc", "*x c", False ),
+			( "a", "a** b", True ),
 		] :
 
 			self.assertEqual( Gaffer.StringAlgo.matchMultiple( s, p ), r )
@@ -93,5 +100,67 @@ class StringAlgoTest( GafferTest.TestCase ) :
 
 			self.assertEqual( Gaffer.StringAlgo.hasWildcards( p ), r )
 
+	def testCompiledMatchPattern( self ) :
+
+		for s, p, r in [
+			( "", "", True ),
+			( "a", "a", True ),
+			( "a", "*", True ),
+			( "ab", "a*", True ),
+			( "cat", "dog", False ),
+			( "dogfish", "*fish", True ),
+			( "dogcollar", "*fish", False ),
+			( "dog collar", "dog collar", True ),
+			( "dog collar", "dog co*", True ),
+			( "dogfish", "d*g*sh", True ),
+			( "dogfish", "d*f*g", False ),
+			( "abab", "*ab*ab", True ),
+			( "ab", "a**b", True ),
+		] :
+
+			self.assertEqual( Gaffer.StringAlgo.CompiledMatchPattern( p ).match( s ), r )
+
+		self.assertFalse( Gaffer.StringAlgo.CompiledMatchPattern().match( "" ) )
+
+	def testCompiledMatchPatternMultiple( self ) :
+
+		for s, p, r in [
+			( "", "", True ),
+			( "a", "b a", True ),
+			( "a", "c *", True ),
+			( "ab", "c a*", True ),
+			( "cat", "dog fish", False ),
+			( "cat", "cad cat", True ),
+			( "cat", "cad ", False ),
+			( "cat", "cat ", True ),
+			( "cat", "cadcat", False ),
+			( "dogfish", "cat *fish", True ),
+			( "dogcollar", "dog *fish", False ),
+			( "dogcollar", "dog collar", False ),
+			( "a1", "*1 b2", True ),
+			( "group5", "group*7 group5", True ),
+		] :
+
+			self.assertEqual( Gaffer.StringAlgo.CompiledMatchPattern( p, multiple = True ).match( s ), r )
+
+	def testCompiledMatchPatternEquivalence( self ) :
+
+		strings = [ "", "a", "ab", "aa", "abab", "cc", "abc", "group5", "group57", "dogfish" ]
+		patterns = [
+			"", "*", "**", "a", "a*", "a**", "*a", "**a", "a*a", "a**b", "*ab*ab",
+			"*x c", "a*x ab", "group*7 group5", "c a*", "cad ", "a** b", "d*g*sh",
+		]
+
+		for p in patterns :
+			compiled = Gaffer.StringAlgo.CompiledMatchPattern( p )
+			compiledMultiple = Gaffer.StringAlgo.CompiledMatchPattern( p, multiple = True )
+			for s in strings :
+				self.assertEqual( compiled.match( s ), Gaffer.StringAlgo.match( s, p ), "{0} {1}".format( s, p ) )
+				self.assertEqual( compiledMultiple.match( s ), Gaffer.StringAlgo.matchMultiple( s, p ), "{0} {1}".format( s, p ) )
+
+	def testMatchPatternPerformance( self ) :
+
+		GafferTest.testMatchPatternPerformance()
+
 if __name__ == "__main__":
 	unittest.main()
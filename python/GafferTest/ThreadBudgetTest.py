@@ -0,0 +1,127 @@
+##########################################################################
+#
+#  Copyright (c) 2016, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#      * Redistributions of source code must retain the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer.
+#
+#      * Redistributions in binary form must reproduce the above
+#        copyright notice, this list of conditions and the following
+#        disclaimer in the documentation and/or other materials provided with
+#        the distribution.
+#
+#      * Neither the name of John Haddon nor the names of
+#        any other contributors to this software may be used to endorse or
+#        promote products derived from this software without specific prior
+#        written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import unittest
+
+import Gaffer
+import GafferTest
+
+class ThreadBudgetTest( GafferTest.TestCase ) :
+
+	def testMaxThreads( self ) :
+
+		self.assertEqual( Gaffer.ThreadBudget().maxThreads(), 0 )
+		self.assertEqual( Gaffer.ThreadBudget( 2 ).maxThreads(), 2 )
+		self.assertEqual( Gaffer.ThreadBudget( maxThreads = 3 ).maxThreads(), 3 )
+
+	def testExecute( self ) :
+
+		calls = []
+		Gaffer.ThreadBudget( 1 ).execute( lambda : calls.append( 1 ) )
+		self.assertEqual( calls, [ 1 ] )
+
+	def testExecuteTransfersContext( self ) :
+
+		contexts = []
+		context = Gaffer.Context()
+		context["a"] = 10
+		with context :
+			Gaffer.ThreadBudget( 2 ).execute( lambda : contexts.append( Gaffer.Context.current()["a"] ) )
+
+		self.assertEqual( contexts, [ 10 ] )
+
+	def testExecutePropagatesExceptions( self ) :
+
+		def f() :
+			raise ValueError( "Oops" )
+
+		self.assertRaisesRegexp( ValueError, "Oops", Gaffer.ThreadBudget( 2 ).execute, f )
+
+	def testExecuteComputes( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = GafferTest.AddNode()
+		s["n"]["op1"].setValue( 1 )
+		s["n"]["op2"].setValue( 2 )
+
+		results = []
+		Gaffer.ThreadBudget( 2 ).execute( lambda : results.append( s["n"]["sum"].getValue() ) )
+		self.assertEqual( results, [ 3 ] )
+
+	def testExecuteRecordsContextAccesses( self ) :
+
+		# The hash cache only considers the context variables
+		# which were accessed while computing a hash, so accesses
+		# made within the budget must be recorded too.
+
+		class BudgetedNode( Gaffer.ComputeNode ) :
+
+			def __init__( self, name = "BudgetedNode" ) :
+
+				Gaffer.ComputeNode.__init__( self, name )
+				self["out"] = Gaffer.IntPlug( direction = Gaffer.Plug.Direction.Out )
+
+			def hash( self, output, context, h ) :
+
+				Gaffer.ThreadBudget( 2 ).execute( lambda : h.append( context.get( "budgetTest:x", 0 ) ) )
+
+			def compute( self, output, context ) :
+
+				output.setValue( context.get( "budgetTest:x", 0 ) )
+
+		n = BudgetedNode()
+		with Gaffer.Context() as c :
+			c["budgetTest:x"] = 1
+			self.assertEqual( n["out"].getValue(), 1 )
+			c["budgetTest:x"] = 2
+			self.assertEqual( n["out"].getValue(), 2 )
+
+	def testScriptNodeThreadBudget( self ) :
+
+		s = Gaffer.ScriptNode()
+		self.assertEqual( s.getThreadBudget(), None )
+
+		b = Gaffer.ThreadBudget( 2 )
+		s.setThreadBudget( b )
+		self.assertTrue( s.getThreadBudget().isSame( b ) )
+
+		# The budget belongs to the host process, not the script.
+		s2 = Gaffer.ScriptNode()
+		s2.execute( s.serialise() )
+		self.assertEqual( s2.getThreadBudget(), None )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -626,17 +626,333 @@ class ValuePlugTest( GafferTest.TestCase ) :
 
 		self.failUnless( n["p"] is p )
 
+	def testHashCache( self ) :
+
+		n = GafferTest.AddNode()
+		n["op1"].setValue( 1 )
+
+		Gaffer.ValuePlug.clearHashCache()
+		Gaffer.ValuePlug.resetHashCacheStatistics()
+
+		h1 = n["sum"].hash()
+		self.assertEqual( n.numHashCalls, 1 )
+		self.assertEqual( Gaffer.ValuePlug.hashCacheSize(), 1 )
+
+		s = Gaffer.ValuePlug.hashCacheStatistics()
+		self.assertEqual( s.hits, 0 )
+		self.assertEqual( s.misses, 1 )
+
+		# The second query should be served by the cache.
+
+		self.assertEqual( n["sum"].hash(), h1 )
+		self.assertEqual( n.numHashCalls, 1 )
+
+		s = Gaffer.ValuePlug.hashCacheStatistics()
+		self.assertEqual( s.hits, 1 )
+		self.assertEqual( s.misses, 1 )
+
+		# Dirtying the plug should prevent the stale
+		# entry from being used.
+
+		n["op2"].setValue( 2 )
+		h2 = n["sum"].hash()
+		self.assertNotEqual( h2, h1 )
+		self.assertEqual( n.numHashCalls, 2 )
+
+		s = Gaffer.ValuePlug.hashCacheStatistics()
+		self.assertEqual( s.hits, 1 )
+		self.assertEqual( s.misses, 2 )
+
+		# Entries are shared between contexts which differ
+		# only in variables the hash doesn't depend on.
+
+		with Gaffer.Context() as c :
+			c["myVariable"] = 1
+			self.assertEqual( n["sum"].hash(), h2 )
+
+		self.assertEqual( n.numHashCalls, 2 )
+
+	def testHashCacheSizeLimit( self ) :
+
+		n = GafferTest.FrameNode()
+
+		Gaffer.ValuePlug.clearHashCache()
+		Gaffer.ValuePlug.resetHashCacheStatistics()
+		Gaffer.ValuePlug.setHashCacheSizeLimit( 1 )
+		self.assertEqual( Gaffer.ValuePlug.getHashCacheSizeLimit(), 1 )
+
+		c = Gaffer.Context()
+		for i in range( 0, 10 ) :
+			c.setFrame( i )
+			with c :
+				n["output"].hash()
+
+		self.assertEqual( Gaffer.ValuePlug.hashCacheSize(), 1 )
+		self.assertEqual( Gaffer.ValuePlug.hashCacheStatistics().evictions, 9 )
+
+		Gaffer.ValuePlug.clearHashCache()
+		self.assertEqual( Gaffer.ValuePlug.hashCacheSize(), 0 )
+
+	def testHashCacheIgnoresIrrelevantVariables( self ) :
+
+		class VariableNode( GafferTest.AddNode ) :
+
+			def __init__( self, name = "VariableNode" ) :
+
+				GafferTest.AddNode.__init__( self, name )
+
+			def hash( self, output, context, h ) :
+
+				GafferTest.AddNode.hash( self, output, context, h )
+				h.append( context.get( "myVariable", 0 ) )
+
+			def compute( self, plug, context ) :
+
+				plug.setValue( self["op1"].getValue() + self["op2"].getValue() + context.get( "myVariable", 0 ) )
+
+		IECore.registerRunTimeTyped( VariableNode )
+
+		n1 = GafferTest.AddNode()
+		n2 = VariableNode()
+		n2["op1"].setInput( n1["sum"] )
+		n3 = GafferTest.AddNode()
+		n3["op1"].setInput( n2["sum"] )
+
+		Gaffer.ValuePlug.clearHashCache()
+
+		c = Gaffer.Context()
+		for i in range( 0, 10 ) :
+			c["myVariable"] = i
+			c.setFrame( i )
+			with c :
+				self.assertEqual( n3["sum"].getValue(), i )
+
+		# Only the node which reads the variable needs a
+		# hash for each value, and nothing depends on the
+		# frame at all.
+
+		self.assertEqual( n1.numHashCalls, 1 )
+		self.assertEqual( n2.numHashCalls, 10 )
+
+		# The dependency of n2 is inherited by n3.
+
+		self.assertEqual( n3.numHashCalls, 10 )
+
+		# Differing values for the variable must still
+		# be distinguished.
+
+		with c :
+			c["myVariable"] = 1
+			h1 = n3["sum"].hash()
+			c["myVariable"] = 2
+			h2 = n3["sum"].hash()
+
+		self.assertNotEqual( h1, h2 )
+
+	def testCacheMemoryUsageWithSharedData( self ) :
+
+		class AppendNode( Gaffer.ComputeNode ) :
+
+			def __init__( self, name = "AppendNode" ) :
+
+				Gaffer.ComputeNode.__init__( self, name )
+
+				self["in"] = Gaffer.ObjectPlug( "in", Gaffer.Plug.Direction.In, IECore.CompoundObject() )
+				self["name"] = Gaffer.StringPlug()
+				self["size"] = Gaffer.IntPlug()
+				self["out"] = Gaffer.ObjectPlug( "out", Gaffer.Plug.Direction.Out, IECore.CompoundObject() )
+
+			def affects( self, input ) :
+
+				outputs = Gaffer.ComputeNode.affects( self, input )
+				if input.isSame( self["in"] ) or input.isSame( self["name"] ) or input.isSame( self["size"] ) :
+					outputs.append( self["out"] )
+
+				return outputs
+
+			def hash( self, output, context, h ) :
+
+				self["in"].hash( h )
+				self["name"].hash( h )
+				self["size"].hash( h )
+
+			def compute( self, output, context ) :
+
+				result = self["in"].getValue()
+				result[self["name"].getValue()] = IECore.IntVectorData( range( 0, self["size"].getValue() ) )
+				output.setValue( result )
+
+		n1 = AppendNode()
+		n1["name"].setValue( "big" )
+		n1["size"].setValue( 100000 )
+
+		n2 = AppendNode()
+		n2["in"].setInput( n1["out"] )
+		n2["name"].setValue( "small" )
+		n2["size"].setValue( 1 )
+
+		Gaffer.ValuePlug.clearCache()
+		self.assertEqual( Gaffer.ValuePlug.cacheMemoryUsageByPlug(), {} )
+
+		n1MemoryUsage = n1["out"].getValue().memoryUsage()
+		n2MemoryUsage = n2["out"].getValue().memoryUsage()
+
+		# The output from `n2` shares the big buffer with `n1`,
+		# so it should only be counted once.
+
+		usage = Gaffer.ValuePlug.cacheMemoryUsage()
+		self.assertGreaterEqual( usage, n2MemoryUsage )
+		self.assertLess( usage, n1MemoryUsage + n2MemoryUsage )
+
+		byPlug = Gaffer.ValuePlug.cacheMemoryUsageByPlug()
+		self.assertEqual( set( byPlug.keys() ), set( [ n1["out"].fullName(), n2["out"].fullName() ] ) )
+		self.assertEqual( sum( byPlug.values() ), usage )
+		self.assertGreater( byPlug[n1["out"].fullName()], byPlug[n2["out"].fullName()] )
+
+		Gaffer.ValuePlug.clearCache()
+		self.assertEqual( Gaffer.ValuePlug.cacheMemoryUsage(), 0 )
+		self.assertEqual( Gaffer.ValuePlug.cacheMemoryUsageByPlug(), {} )
+
+		# Lower the limit so that the value from `n1` can't fit. If it is
+		# removed first, the value from `n2` is no longer cheap, because
+		# it is the sole owner of the big buffer. So it must be removed too.
+
+		n1["out"].getValue()
+		n2["out"].getValue()
+
+		Gaffer.ValuePlug.setCacheMemoryLimit( n1MemoryUsage / 2 )
+		self.assertEqual( Gaffer.ValuePlug.getCacheMemoryLimit(), n1MemoryUsage / 2 )
+		self.assertEqual( Gaffer.ValuePlug.cacheMemoryUsage(), 0 )
+		self.assertEqual( Gaffer.ValuePlug.cacheMemoryUsageByPlug(), {} )
+
+	def testBatchEditScope( self ) :
+
+		s = Gaffer.ScriptNode()
+		s["n"] = GafferTest.AddNode()
+
+		dirtied = GafferTest.CapturingSlot( s["n"].plugDirtiedSignal() )
+		plugsSet = GafferTest.CapturingSlot( s["n"].plugSetSignal() )
+
+		with Gaffer.UndoContext( s ) :
+			with Gaffer.BatchEditScope() :
+				for i in range( 0, 10 ) :
+					s["n"]["op1"].setValue( i )
+					s["n"]["op2"].setValue( i * 2 )
+				# Values are available immediately, but
+				# signals are deferred.
+				self.assertEqual( s["n"]["op1"].getValue(), 9 )
+				self.assertEqual( s["n"]["op2"].getValue(), 18 )
+				self.assertEqual( len( plugsSet ), 0 )
+				self.assertEqual( len( dirtied ), 0 )
+
+		self.assertEqual( s["n"]["sum"].getValue(), 27 )
+
+		# Each plug is signalled only once.
+		self.assertEqual( [ x[0] for x in plugsSet ], [ s["n"]["op1"], s["n"]["op2"] ] )
+		dirtiedNames = [ x[0].getName() for x in dirtied ]
+		self.assertEqual( len( dirtiedNames ), len( set( dirtiedNames ) ) )
+		self.assertEqual( set( dirtiedNames ), { "op1", "op2", "sum" } )
+
+		# All the edits are undone in a single step.
+		s.undo()
+		self.assertFalse( s.undoAvailable() )
+		self.assertEqual( s["n"]["op1"].getValue(), 0 )
+		self.assertEqual( s["n"]["op2"].getValue(), 0 )
+		self.assertEqual( s["n"]["sum"].getValue(), 0 )
+
+		s.redo()
+		self.assertEqual( s["n"]["op1"].getValue(), 9 )
+		self.assertEqual( s["n"]["op2"].getValue(), 18 )
+		self.assertEqual( s["n"]["sum"].getValue(), 27 )
+
+	def testNestedBatchEditScopes( self ) :
+
+		n = GafferTest.AddNode()
+		dirtied = GafferTest.CapturingSlot( n.plugDirtiedSignal() )
+
+		with Gaffer.BatchEditScope() :
+			n["op1"].setValue( 1 )
+			with Gaffer.BatchEditScope() :
+				n["op2"].setValue( 2 )
+			self.assertEqual( len( dirtied ), 0 )
+			# A value restored within the scope
+			# isn't considered to have been edited.
+			n["op2"].setValue( 0 )
+
+		self.assertEqual( set( [ x[0].getName() for x in dirtied ] ), { "op1", "sum" } )
+		self.assertEqual( n["sum"].getValue(), 1 )
+
+	def testReadsWithinBatchEditScope( self ) :
+
+		n = GafferTest.AddNode()
+		self.assertEqual( n["sum"].getValue(), 0 )
+
+		with Gaffer.BatchEditScope() :
+			n["op1"].setValue( 5 )
+			self.assertEqual( n["sum"].getValue(), 5 )
+			n["op1"].setValue( 0 )
+			self.assertEqual( n["sum"].getValue(), 0 )
+			n["op1"].setValue( 5 )
+			self.assertEqual( n["sum"].getValue(), 5 )
+			# Restore the original value, so that
+			# no edit is committed.
+			n["op1"].setValue( 0 )
+
+		self.assertEqual( n["sum"].getValue(), 0 )
+
+		n["op2"].setValue( 2 )
+		self.assertEqual( n["sum"].getValue(), 2 )
+
+	def testBatchEditScopeCommitErrors( self ) :
+
+		n = GafferTest.AddNode()
+
+		def raiseError( plug ) :
+			raise RuntimeError( "Commit failed" )
+
+		c = n.plugSetSignal().connect( raiseError )
+
+		# Errors from the commit are raised to the caller.
+		with self.assertRaisesRegexp( RuntimeError, "Commit failed" ) :
+			with Gaffer.BatchEditScope() :
+				n["op1"].setValue( 1 )
+
+		# But they mustn't mask an exception which is already
+		# in flight.
+		with IECore.CapturingMessageHandler() as mh :
+			with self.assertRaisesRegexp( ValueError, "Original error" ) :
+				with Gaffer.BatchEditScope() :
+					n["op1"].setValue( 2 )
+					raise ValueError( "Original error" )
+
+		self.assertEqual( len( mh.messages ), 1 )
+		self.assertEqual( mh.messages[0].level, IECore.Msg.Level.Error )
+
+	def testBatchEditScopeReadOnlyPlug( self ) :
+
+		n = GafferTest.AddNode()
+		n["op1"].setFlags( Gaffer.Plug.Flags.ReadOnly, True )
+
+		with Gaffer.BatchEditScope() :
+			self.assertRaises( RuntimeError, n["op1"].setValue, 1 )
+			n["op2"].setValue( 2 )
+
+		self.assertEqual( n["op1"].getValue(), 0 )
+		self.assertEqual( n["sum"].getValue(), 2 )
+
 	def setUp( self ) :
 
 		GafferTest.TestCase.setUp( self )
 
 		self.__originalCacheMemoryLimit = Gaffer.ValuePlug.getCacheMemoryLimit()
+		self.__originalHashCacheSizeLimit = Gaffer.ValuePlug.getHashCacheSizeLimit()
 
 	def tearDown( self ) :
 
 		GafferTest.TestCase.tearDown( self )
 
 		Gaffer.ValuePlug.setCacheMemoryLimit( self.__originalCacheMemoryLimit )
+		Gaffer.ValuePlug.setHashCacheSizeLimit( self.__originalHashCacheSizeLimit )
 
 if __name__ == "__main__":
 	unittest.main()
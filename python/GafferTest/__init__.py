@@ -89,6 +89,7 @@ from LazyModuleTest import LazyModuleTest
 from NodeBindingTest import NodeBindingTest
 from DictPathTest import DictPathTest
 from ExpressionTest import ExpressionTest
+from NativeExpressionEngineTest import NativeExpressionEngineTest
 from BlockedConnectionTest import BlockedConnectionTest
 from TimeWarpComputeNodeTest import TimeWarpComputeNodeTest
 from TransformPlugTest import TransformPlugTest
@@ -117,6 +118,8 @@ from SerialisationTest import SerialisationTest
 from SwitchTest import SwitchTest
 from MetadataTest import MetadataTest
 from StringAlgoTest import StringAlgoTest
+from ThreadBudgetTest import ThreadBudgetTest
+from FutureTest import FutureTest
 from NodeAlgoTest import NodeAlgoTest
 from DotTest import DotTest
 from ApplicationTest import ApplicationTest
@@ -131,6 +134,7 @@ from DownstreamIteratorTest import DownstreamIteratorTest
 from PerformanceMonitorTest import PerformanceMonitorTest
 from MetadataAlgoTest import MetadataAlgoTest
 from ContextMonitorTest import ContextMonitorTest
+from ProcessTest import ProcessTest
 
 if __name__ == "__main__":
 	import unittest
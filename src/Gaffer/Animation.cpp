@@ -34,6 +34,8 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "boost/bind.hpp"
 
 #include "OpenEXR/ImathFun.h"
@@ -96,6 +98,7 @@ Animation::CurvePlug::CurvePlug( const std::string &name, Direction direction, u
 {
 	addChild( new FloatPlug( "out", Plug::Out ) );
 	outPlug()->setFlags( Plug::Cacheable, false );
+	m_lowerBoundHint = 0;
 }
 
 void Animation::CurvePlug::addKey( const Key &key )
@@ -188,34 +191,79 @@ const Animation::CurvePlug::Keys &Animation::CurvePlug::keys() const
 
 float Animation::CurvePlug::evaluate( float time ) const
 {
-	if( m_keys.empty() )
+	const size_t hint = m_lowerBoundHint;
+	const size_t right = lowerBound( time, hint );
+	if( right != hint )
+	{
+		m_lowerBoundHint = right;
+	}
+	return evaluate( time, right );
+}
+
+void Animation::CurvePlug::evaluate( const std::vector<float> &times, std::vector<float> &values ) const
+{
+	values.resize( times.size() );
+
+	size_t right = 0;
+	for( size_t i = 0, e = times.size(); i < e; ++i )
+	{
+		right = lowerBound( times[i], right );
+		values[i] = evaluate( times[i], right );
+	}
+}
+
+size_t Animation::CurvePlug::lowerBound( float time, size_t hint ) const
+{
+	const size_t size = m_packedKeys.size();
+	if( hint <= size && ( hint == 0 || m_packedKeys[hint-1].time < time ) )
+	{
+		// The result is at or after the hint, which is the common case
+		// when evaluating increasing times. Step forward a few keys in
+		// the hope of finding it nearby, before resorting to a binary
+		// search of the remainder.
+		for( size_t i = 0; i < 4 && hint < size; ++i, ++hint )
+		{
+			if( m_packedKeys[hint].time >= time )
+			{
+				return hint;
+			}
+		}
+		return std::lower_bound( m_packedKeys.begin() + hint, m_packedKeys.end(), Key( time ) ) - m_packedKeys.begin();
+	}
+
+	return std::lower_bound( m_packedKeys.begin(), m_packedKeys.end(), Key( time ) ) - m_packedKeys.begin();
+}
+
+float Animation::CurvePlug::evaluate( float time, size_t lowerBound ) const
+{
+	if( m_packedKeys.empty() )
 	{
 		return 0;
 	}
 
-	Keys::const_iterator right = m_keys.lower_bound( time );
-	if( right == m_keys.end() )
+	if( lowerBound == m_packedKeys.size() )
 	{
-		return m_keys.rbegin()->value;
+		return m_packedKeys.back().value;
 	}
 
-	if( right->time == time || right == m_keys.begin() )
+	const Key &right = m_packedKeys[lowerBound];
+	if( right.time == time || lowerBound == 0 )
 	{
-		return right->value;
+		return right.value;
 	}
 
-	Keys::const_iterator left = right; left--;
-	if( right->type == Linear )
+	const Key &left = m_packedKeys[lowerBound-1];
+	if( right.type == Linear )
 	{
-		const float t = ( time - left->time ) / ( right->time - left->time );
-		return Imath::lerp( left->value, right->value, t );
+		const float t = ( time - left.time ) / ( right.time - left.time );
+		return Imath::lerp( left.value, right.value, t );
 	}
 	else
 	{
 		// Step. We already dealt with the case where we're
 		// exactly at the time of the right keyframe, so we
 		// just return the value of the left keyframe.
-		return left->value;
+		return left.value;
 	}
 }
 
@@ -240,6 +288,27 @@ void Animation::CurvePlug::addOrRemoveKeyInternal( const Key &key )
 		m_keys.erase( key );
 		m_keys.insert( key );
 	}
+
+	// Update the packed keys in place rather than rebuilding them,
+	// so that adding many keys isn't quadratic.
+	std::vector<Key>::iterator it = std::lower_bound( m_packedKeys.begin(), m_packedKeys.end(), key );
+	const bool exists = it != m_packedKeys.end() && !( key < *it );
+	if( !key )
+	{
+		if( exists )
+		{
+			m_packedKeys.erase( it );
+		}
+	}
+	else if( exists )
+	{
+		*it = key;
+	}
+	else
+	{
+		m_packedKeys.insert( it, key );
+	}
+	m_lowerBoundHint = 0;
 	propagateDirtiness( outPlug() );
 }
 
@@ -273,6 +342,15 @@ const Plug *Animation::curvesPlug() const
 	return getChild<Plug>( g_firstPlugIndex );
 }
 
+void Animation::evaluate( const std::vector<const CurvePlug *> &curves, float time, std::vector<float> &values )
+{
+	values.resize( curves.size() );
+	for( size_t i = 0, e = curves.size(); i < e; ++i )
+	{
+		values[i] = curves[i]->evaluate( time );
+	}
+}
+
 bool Animation::canAnimate( const ValuePlug *plug )
 {
 	if( plug->getFlags( Plug::ReadOnly ) )
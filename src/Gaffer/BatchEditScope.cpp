@@ -0,0 +1,78 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2016, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "IECore/MessageHandler.h"
+
+#include "Gaffer/BatchEditScope.h"
+#include "Gaffer/ValuePlug.h"
+
+using namespace Gaffer;
+
+BatchEditScope::BatchEditScope()
+	:	m_committed( false )
+{
+	ValuePlug::pushBatchEditScope();
+}
+
+BatchEditScope::~BatchEditScope()
+{
+	if( m_committed )
+	{
+		return;
+	}
+
+	// We mustn't throw from a destructor, not least because we may
+	// be being destroyed during unwinding, so we report errors instead.
+	try
+	{
+		commit();
+	}
+	catch( const std::exception &e )
+	{
+		IECore::msg( IECore::Msg::Error, "BatchEditScope", e.what() );
+	}
+}
+
+void BatchEditScope::commit()
+{
+	// Exiting the outermost scope enacts the edits, which can
+	// throw from slots connected to the signals it emits. We
+	// mark ourselves as committed first, so that the scope is
+	// never exited twice.
+	m_committed = true;
+	ValuePlug::popBatchEditScope();
+}
@@ -76,3 +76,13 @@ void ComputeNode::hash( const ValuePlug *output, const Context *context, IECore:
 void ComputeNode::compute( ValuePlug *output, const Context *context ) const
 {
 }
+
+ValuePlug::CachePolicy ComputeNode::computeCachePolicy( const ValuePlug *output ) const
+{
+	return output->getFlags( Plug::Cacheable ) ? ValuePlug::Standard : ValuePlug::HashOnly;
+}
+
+bool ComputeNode::persistentCacheable( const ValuePlug *output ) const
+{
+	return false;
+}
@@ -44,6 +44,7 @@ static char **environ = *_NSGetEnviron();
 #include <unistd.h>
 #endif
 
+#include <deque>
 #include <stack>
 
 #include "tbb/enumerable_thread_specific.h"
@@ -119,16 +120,27 @@ static InternedString g_frame( "frame" );
 static InternedString g_framesPerSecond( "framesPerSecond" );
 
 Context::Context()
-	:	m_changedSignal( NULL ), m_hashValid( false )
+	:	m_changedSignal( NULL ), m_canceller( NULL )
 {
 	set( g_frame, 1.0f );
 	set( g_framesPerSecond, 24.0f );
 }
 
 Context::Context( const Context &other, Ownership ownership )
-	:	m_map( other.m_map ), m_changedSignal( NULL ), m_hash( other.m_hash ), m_hashValid( other.m_hashValid )
+	:	m_map( other.m_map ), m_changedSignal( NULL ), m_canceller( other.m_canceller ), m_hash( other.m_hash ), m_accessRecorderLink( other.m_accessRecorderLink )
 {
-	// We used the (shallow) Map copy constructor in our initialiser above
+	copyValues( ownership );
+}
+
+Context::Context( const Context &other, const Canceller &canceller, Ownership ownership )
+	:	m_map( other.m_map ), m_changedSignal( NULL ), m_canceller( &canceller ), m_hash( other.m_hash ), m_accessRecorderLink( other.m_accessRecorderLink )
+{
+	copyValues( ownership );
+}
+
+void Context::copyValues( Ownership ownership )
+{
+	// We used the (shallow) Map copy constructor in our initialisers above
 	// because it offers a big performance win over iterating and inserting copies
 	// ourselves. Now we need to go in and tweak our copies based on the ownership.
 
@@ -154,6 +166,33 @@ Context::Context( const Context &other, Ownership ownership )
 	}
 }
 
+void Context::assignBorrowed( const Context &other )
+{
+	// Assignment reuses our existing storage where it can, which
+	// is where the savings over the copy constructor come from.
+	m_map = other.m_map;
+	copyValues( Borrowed );
+	m_canceller = other.m_canceller;
+	m_hash = other.m_hash;
+	m_accessRecorderLink = other.m_accessRecorderLink;
+}
+
+void Context::setBorrowed( const IECore::InternedString &name, const IECore::Data *data )
+{
+	Storage &s = m_map[name];
+	if( s.data && s.ownership != Borrowed )
+	{
+		s.data->removeRef();
+	}
+	s.data = data;
+	s.ownership = Borrowed;
+	updateHash( name, s );
+	if( m_changedSignal )
+	{
+		(*m_changedSignal)( this, name );
+	}
+}
+
 Context::~Context()
 {
 	for( Map::const_iterator it = m_map.begin(), eIt = m_map.end(); it != eIt; ++it )
@@ -172,8 +211,13 @@ void Context::remove( const IECore::InternedString &name )
 	Map::iterator it = m_map.find( name );
 	if( it != m_map.end() )
 	{
+		if( it->second.ownership != Borrowed )
+		{
+			it->second.data->removeRef();
+		}
+		it->second.data = NULL;
+		updateHash( name, it->second );
 		m_map.erase( it );
-		m_hashValid = false;
 		if( m_changedSignal )
 		{
 			(*m_changedSignal)( this, name );
@@ -183,7 +227,12 @@ void Context::remove( const IECore::InternedString &name )
 
 void Context::changed( const IECore::InternedString &name )
 {
-	m_hashValid = false;
+	Map::iterator it = m_map.find( name );
+	if( it != m_map.end() )
+	{
+		updateHash( name, it->second );
+	}
+
 	if( m_changedSignal )
 	{
 		(*m_changedSignal)( this, name );
@@ -192,6 +241,7 @@ void Context::changed( const IECore::InternedString &name )
 
 void Context::names( std::vector<IECore::InternedString> &names ) const
 {
+	recordAccessToAll();
 	for( Map::const_iterator it = m_map.begin(), eIt = m_map.end(); it != eIt; it++ )
 	{
 		names.push_back( it->first );
@@ -243,35 +293,66 @@ Context::ChangedSignal &Context::changedSignal()
 	return *m_changedSignal;
 }
 
+const Canceller *Context::canceller() const
+{
+	return m_canceller;
+}
+
 IECore::MurmurHash Context::hash() const
 {
-	if( m_hashValid )
-	{
-		return m_hash;
-	}
+	recordAccessToAll();
+	return m_hash;
+}
 
-	m_hash = IECore::MurmurHash();
-	for( Map::const_iterator it = m_map.begin(), eIt = m_map.end(); it != eIt; ++it )
+IECore::MurmurHash Context::hash( const std::vector<IECore::InternedString> &names ) const
+{
+	uint64_t h1 = 0;
+	uint64_t h2 = 0;
+	for( std::vector<IECore::InternedString>::const_iterator it = names.begin(), eIt = names.end(); it != eIt; ++it )
 	{
-		/// \todo Perhaps at some point the UI should use a different container for
-		/// these "not computationally important" values, so we wouldn't have to skip
-		/// them here.
-		// Using a hardcoded comparison of the first three characters because
-		// it's quicker than `string::compare( 0, 3, "ui:" )`.
-		const std::string &name = it->first.string();
-		if(	name.size() > 2 && name[0] == 'u' && name[1] == 'i' && name[2] == ':' )
+		recordAccess( *it );
+		Map::const_iterator mIt = m_map.find( *it );
+		if( mIt != m_map.end() )
 		{
-			continue;
+			h1 += mIt->second.hash.h1();
+			h2 += mIt->second.hash.h2();
 		}
-		m_hash.append( (uint64_t)&name );
-		it->second.data->hash( m_hash );
 	}
-	m_hashValid = true;
-	return m_hash;
+	return IECore::MurmurHash( h1, h2 );
+}
+
+void Context::updateHash( const IECore::InternedString &name, Storage &storage )
+{
+	IECore::MurmurHash h;
+	/// \todo Perhaps at some point the UI should use a different container for
+	/// these "not computationally important" values, so we wouldn't have to skip
+	/// them here.
+	// Using a hardcoded comparison of the first three characters because
+	// it's quicker than `string::compare( 0, 3, "ui:" )`.
+	const std::string &nameString = name.string();
+	if( storage.data && !( nameString.size() > 2 && nameString[0] == 'u' && nameString[1] == 'i' && nameString[2] == ':' ) )
+	{
+		// We hash the name itself rather than the address of the
+		// interned string, so that hashes are stable from one process
+		// to the next.
+		h.append( nameString );
+		storage.data->hash( h );
+	}
+
+	// Replace the old contribution to the total with the new one. We use
+	// addition so that the total doesn't depend on the order in which
+	// entries are combined.
+	m_hash = IECore::MurmurHash(
+		m_hash.h1() - storage.hash.h1() + h.h1(),
+		m_hash.h2() - storage.hash.h2() + h.h2()
+	);
+	storage.hash = h;
 }
 
 bool Context::operator == ( const Context &other ) const
 {
+	recordAccessToAll();
+	other.recordAccessToAll();
 	if( m_map.size() != other.m_map.size() )
 	{
 		return false;
@@ -537,3 +618,299 @@ const Context *Context::current()
 	}
 	return stack.top();
 }
+
+//////////////////////////////////////////////////////////////////////////
+// EditableScope implementation
+//////////////////////////////////////////////////////////////////////////
+
+struct Context::EditableScope::PoolEntry
+{
+	ContextPtr context;
+	// Values set via EditableScope::set(), kept so that they
+	// can be updated in place by subsequent scopes.
+	typedef boost::container::flat_map<IECore::InternedString, IECore::DataPtr> ScratchMap;
+	ScratchMap scratch;
+};
+
+struct Context::EditableScope::Pool
+{
+	Pool() : depth( 0 ) {}
+	// Scopes are strictly nested on any one thread, so we
+	// use one entry per level of nesting. We use a deque because
+	// it doesn't invalidate references to existing entries as it
+	// grows.
+	std::deque<PoolEntry> entries;
+	size_t depth;
+};
+
+Context::EditableScope::EditableScope( const Context *context )
+	:	m_pool( NULL ), m_entry( acquire( context, m_pool ) ), m_context( m_entry->context.get() ), m_scope( m_context )
+{
+}
+
+Context::EditableScope::~EditableScope()
+{
+	if( m_context->refCount() == 1 )
+	{
+		// Drop our borrowed references so nothing dangles
+		// while the entry is unused.
+		m_context->m_map.clear();
+		m_context->m_accessRecorderLink = NULL;
+	}
+	else
+	{
+		// Some badly behaved code has held on to the context beyond
+		// our lifetime. Make sure that the values we set for it stay
+		// alive, and that they won't be reused by subsequent scopes.
+		// The context itself will be replaced in the pool by acquire().
+		for( PoolEntry::ScratchMap::const_iterator it = m_entry->scratch.begin(), eIt = m_entry->scratch.end(); it != eIt; ++it )
+		{
+			Map::iterator mIt = m_context->m_map.find( it->first );
+			if( mIt != m_context->m_map.end() && mIt->second.data == it->second.get() && mIt->second.ownership == Borrowed )
+			{
+				mIt->second.data->addRef();
+				mIt->second.ownership = Shared;
+			}
+		}
+	}
+	m_pool->depth--;
+}
+
+Context::EditableScope::PoolEntry *Context::EditableScope::acquire( const Context *context, Pool *&pool )
+{
+	typedef tbb::enumerable_thread_specific<Pool, tbb::cache_aligned_allocator<Pool>, tbb::ets_key_per_instance> ThreadSpecificPool;
+	static ThreadSpecificPool g_pools;
+
+	pool = &g_pools.local();
+	if( pool->depth == pool->entries.size() )
+	{
+		pool->entries.push_back( PoolEntry() );
+	}
+
+	PoolEntry &entry = pool->entries[pool->depth++];
+	if( !entry.context || entry.context->refCount() > 1 )
+	{
+		// Either this is the first use of the entry, or the context
+		// from a previous scope is still referenced elsewhere, in which
+		// case we leave it be and start afresh.
+		entry.context = new Context( *context, Borrowed );
+	}
+	else
+	{
+		entry.context->assignBorrowed( *context );
+	}
+
+	return &entry;
+}
+
+void Context::EditableScope::setFrame( float frame )
+{
+	set( g_frame, frame );
+}
+
+void Context::EditableScope::setTime( float timeInSeconds )
+{
+	setFrame( timeInSeconds * m_context->getFramesPerSecond() );
+}
+
+void Context::EditableScope::remove( const IECore::InternedString &name )
+{
+	m_context->remove( name );
+}
+
+const Context *Context::EditableScope::context() const
+{
+	return m_context;
+}
+
+IECore::Data *Context::EditableScope::scratch( const IECore::InternedString &name, IECore::TypeId typeId )
+{
+	PoolEntry::ScratchMap::const_iterator it = m_entry->scratch.find( name );
+	if( it == m_entry->scratch.end() )
+	{
+		return NULL;
+	}
+
+	IECore::Data *data = it->second.get();
+	if( data->typeId() != typeId || data->refCount() > 1 )
+	{
+		return NULL;
+	}
+
+	return data;
+}
+
+void Context::EditableScope::setScratch( const IECore::InternedString &name, IECore::Data *data )
+{
+	m_entry->scratch[name] = data;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// AccessRecorder implementation
+//////////////////////////////////////////////////////////////////////////
+
+// The current recorder is queried by every call to Context::get(), so
+// we hold it in native thread-local storage, which costs a single load,
+// rather than in a tbb::enumerable_thread_specific, which costs a key
+// lookup.
+static __thread Context::AccessRecorder *g_accessRecorder = NULL;
+// True when an AccessRecorder::Scope has been used to specify the
+// recorder for the calling thread explicitly, in which case linked
+// contexts are ignored.
+static __thread bool g_accessRecorderScoped = false;
+
+struct Context::AccessRecorder::Link : public IECore::RefCounted
+{
+
+	Link( AccessRecorder *recorder )
+		:	recorder( recorder )
+	{
+	}
+
+	void record( const IECore::InternedString &name )
+	{
+		tbb::spin_mutex::scoped_lock lock( mutex );
+		if( recorder )
+		{
+			recorder->record( name );
+		}
+	}
+
+	void recordAll()
+	{
+		tbb::spin_mutex::scoped_lock lock( mutex );
+		if( recorder )
+		{
+			recorder->recordAll();
+		}
+	}
+
+	tbb::spin_mutex mutex;
+	// NULL once the recorder has been destroyed.
+	AccessRecorder *recorder;
+
+};
+
+Context::AccessRecorder::AccessRecorder()
+	:	m_parent( g_accessRecorder ),
+		m_parentLink( m_parent || g_accessRecorderScoped ? LinkPtr() : Context::current()->m_accessRecorderLink ),
+		m_link( new Link( this ) ),
+		m_scope( Context::current() ),
+		m_all( false )
+{
+	const_cast<Context *>( m_scope.context() )->m_accessRecorderLink = m_link;
+	g_accessRecorder = this;
+}
+
+Context::AccessRecorder::~AccessRecorder()
+{
+	g_accessRecorder = m_parent;
+
+	{
+		// Stop recording accesses made via linked contexts
+		// which outlive us.
+		tbb::spin_mutex::scoped_lock lock( m_link->mutex );
+		m_link->recorder = NULL;
+	}
+
+	if( m_parent )
+	{
+		recordInto( m_parent );
+	}
+	else if( m_parentLink )
+	{
+		tbb::spin_mutex::scoped_lock lock( m_parentLink->mutex );
+		if( m_parentLink->recorder )
+		{
+			recordInto( m_parentLink->recorder );
+		}
+	}
+}
+
+void Context::AccessRecorder::recordInto( AccessRecorder *recorder ) const
+{
+	if( m_all )
+	{
+		recorder->recordAll();
+	}
+	else
+	{
+		for( Names::const_iterator it = m_names.begin(), eIt = m_names.end(); it != eIt; ++it )
+		{
+			recorder->record( *it );
+		}
+	}
+}
+
+bool Context::AccessRecorder::all() const
+{
+	return m_all;
+}
+
+const Context::AccessRecorder::Names &Context::AccessRecorder::names() const
+{
+	return m_names;
+}
+
+Context::AccessRecorder *Context::AccessRecorder::current()
+{
+	return g_accessRecorder;
+}
+
+void Context::AccessRecorder::record( const IECore::InternedString &name )
+{
+	// The lock is only contended when an AccessRecorder::Scope has
+	// been used to share a recorder between several threads.
+	tbb::spin_mutex::scoped_lock lock( m_mutex );
+	if( !m_all )
+	{
+		m_names.insert( name );
+	}
+}
+
+void Context::AccessRecorder::recordAll()
+{
+	tbb::spin_mutex::scoped_lock lock( m_mutex );
+	m_all = true;
+	m_names.clear();
+}
+
+Context::AccessRecorder::Scope::Scope( AccessRecorder *recorder )
+{
+	m_previous = g_accessRecorder;
+	m_previousScoped = g_accessRecorderScoped;
+	g_accessRecorder = recorder;
+	g_accessRecorderScoped = true;
+}
+
+Context::AccessRecorder::Scope::~Scope()
+{
+	g_accessRecorder = m_previous;
+	g_accessRecorderScoped = m_previousScoped;
+}
+
+void Context::recordAccess( const IECore::InternedString &name ) const
+{
+	if( AccessRecorder *recorder = g_accessRecorder )
+	{
+		recorder->record( name );
+	}
+	else if( m_accessRecorderLink && !g_accessRecorderScoped )
+	{
+		// An access from a thread which the recorder wasn't
+		// forwarded to, typically a TBB worker thread.
+		m_accessRecorderLink->record( name );
+	}
+}
+
+void Context::recordAccessToAll() const
+{
+	if( AccessRecorder *recorder = g_accessRecorder )
+	{
+		recorder->recordAll();
+	}
+	else if( m_accessRecorderLink && !g_accessRecorderScoped )
+	{
+		m_accessRecorderLink->recordAll();
+	}
+}
@@ -153,6 +153,9 @@ void ContextMonitor::processStarted( const Process *process )
 	{
 		return;
 	}
+	// Our inspection of the context is not a dependency of the
+	// process being monitored, so mustn't be recorded as one.
+	Context::AccessRecorder::Scope recorderScope( NULL );
 	const Context *context = Context::current();
 	ThreadData &threadData = m_threadData.local();
 	threadData.statistics[process->plug()] += context;
@@ -0,0 +1,173 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2016, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "tbb/task.h"
+
+#include "boost/thread/mutex.hpp"
+#include "boost/thread/condition_variable.hpp"
+
+#include "Gaffer/Future.h"
+
+using namespace Gaffer;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal classes
+//////////////////////////////////////////////////////////////////////////
+
+struct FutureBase::Waiter
+{
+	boost::mutex mutex;
+	boost::condition_variable condition;
+};
+
+class FutureBase::Task : public tbb::task
+{
+
+	public :
+
+		Task( FutureBase *future )
+			:	m_future( future )
+		{
+		}
+
+		virtual tbb::task *execute()
+		{
+			Context::Scope scopedContext( m_future->m_context.get() );
+			try
+			{
+				Canceller::check( &m_future->m_canceller );
+				m_future->run();
+				m_future->finish( Succeeded );
+			}
+			catch( const Cancelled & )
+			{
+				m_future->finish( WasCancelled );
+			}
+			catch( const std::exception &e )
+			{
+				m_future->finish( Failed, e.what() );
+			}
+			catch( ... )
+			{
+				m_future->finish( Failed, "Unknown error" );
+			}
+			return NULL;
+		}
+
+	private :
+
+		// Keeps the future alive until the work is done,
+		// even if the caller has lost interest in it.
+		FutureBasePtr m_future;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// FutureBase
+//////////////////////////////////////////////////////////////////////////
+
+FutureBase::FutureBase()
+	:	m_context( new Context( *Context::current(), m_canceller ) ), m_waiter( new Waiter )
+{
+	m_status = Running;
+}
+
+FutureBase::~FutureBase()
+{
+	delete m_waiter;
+}
+
+bool FutureBase::done() const
+{
+	return m_status != Running;
+}
+
+void FutureBase::wait() const
+{
+	if( done() )
+	{
+		return;
+	}
+
+	boost::unique_lock<boost::mutex> lock( m_waiter->mutex );
+	while( m_status == Running )
+	{
+		m_waiter->condition.wait( lock );
+	}
+}
+
+void FutureBase::cancel()
+{
+	m_canceller.cancel();
+}
+
+bool FutureBase::cancelled() const
+{
+	return m_status == WasCancelled;
+}
+
+void FutureBase::start()
+{
+	// We use enqueue() rather than spawn() because it guarantees
+	// that the task will be run even if the calling thread never
+	// participates in TBB work, as is the case for the UI thread.
+	tbb::task::enqueue( *new( tbb::task::allocate_root() ) Task( this ) );
+}
+
+void FutureBase::check() const
+{
+	wait();
+	switch( m_status )
+	{
+		case WasCancelled :
+			throw Cancelled();
+		case Failed :
+			throw IECore::Exception( m_error );
+		default :
+			break;
+	}
+}
+
+void FutureBase::finish( Status status, const std::string &error )
+{
+	m_error = error;
+	{
+		boost::lock_guard<boost::mutex> lock( m_waiter->mutex );
+		m_status = status;
+	}
+	m_waiter->condition.notify_all();
+}
@@ -41,6 +41,7 @@
 #include "boost/bind.hpp"
 #include "boost/regex.hpp"
 #include "boost/lexical_cast.hpp"
+#include "boost/unordered_map.hpp"
 
 #include "IECore/Exception.h"
 
@@ -53,6 +54,109 @@ using namespace Gaffer;
 using namespace IECore;
 using namespace std;
 
+//////////////////////////////////////////////////////////////////////////
+// ChildIndex
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// The number of children at which a parent starts maintaining
+// a ChildIndex.
+const size_t g_childIndexThreshold = 64;
+
+// Splits a name into a stem and a numeric suffix, matching the
+// stems generated by StringAlgo::numericSuffix() but without the
+// expense of a regex. Names without a numeric suffix are given a
+// suffix of 0, matching the treatment of siblings in setName().
+long splitNumericSuffix( const std::string &name, std::string &stem )
+{
+	size_t stemSize = name.size();
+	while( stemSize && isdigit( (unsigned char)name[stemSize-1] ) )
+	{
+		stemSize--;
+	}
+	stem.assign( name, 0, stemSize );
+	return strtol( name.c_str() + stemSize, NULL, 10 );
+}
+
+} // namespace
+
+struct GraphComponent::ChildIndex
+{
+
+	// Keyed by the address of the interned string, which
+	// is unique to each name.
+	typedef boost::unordered_map<const char *, GraphComponent *> NameMap;
+	NameMap names;
+
+	// The numeric suffixes in use for each stem, so that setName()
+	// can find the next free suffix without visiting every sibling.
+	typedef boost::unordered_map<std::string, std::multiset<long> > SuffixMap;
+	SuffixMap suffixes;
+
+	bool contains( const GraphComponent *child ) const
+	{
+		NameMap::const_iterator it = names.find( child->m_name.c_str() );
+		return it != names.end() && it->second == child;
+	}
+
+	void add( GraphComponent *child )
+	{
+		names[child->m_name.c_str()] = child;
+		std::string stem;
+		const long suffix = splitNumericSuffix( child->m_name.string(), stem );
+		suffixes[stem].insert( suffix );
+	}
+
+	void remove( GraphComponent *child )
+	{
+		if( !contains( child ) )
+		{
+			return;
+		}
+		names.erase( child->m_name.c_str() );
+
+		std::string stem;
+		const long suffix = splitNumericSuffix( child->m_name.string(), stem );
+		SuffixMap::iterator it = suffixes.find( stem );
+		it->second.erase( it->second.find( suffix ) );
+		if( it->second.empty() )
+		{
+			suffixes.erase( it );
+		}
+	}
+
+	// Returns the largest suffix in use by children with the
+	// specified stem, ignoring `exclude`, or -1 if there are none.
+	long maxSuffix( const std::string &stem, const GraphComponent *exclude ) const
+	{
+		SuffixMap::const_iterator it = suffixes.find( stem );
+		if( it == suffixes.end() )
+		{
+			return -1;
+		}
+
+		std::multiset<long>::const_reverse_iterator rIt = it->second.rbegin();
+		if( contains( exclude ) )
+		{
+			std::string excludeStem;
+			const long excludeSuffix = splitNumericSuffix( exclude->m_name.string(), excludeStem );
+			if( excludeStem == stem && excludeSuffix == *rIt )
+			{
+				++rIt;
+			}
+		}
+
+		return rIt != it->second.rend() ? *rIt : -1;
+	}
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// GraphComponent
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( GraphComponent );
 
 GraphComponent::GraphComponent( const std::string &name )
@@ -89,15 +193,8 @@ const IECore::InternedString &GraphComponent::setName( const IECore::InternedStr
 	IECore::InternedString newName = name;
 	if( m_parent )
 	{
-		bool uniqueAlready = true;
-		for( ChildContainer::const_iterator it=m_parent->m_children.begin(), eIt=m_parent->m_children.end(); it != eIt; it++ )
-		{
-			if( *it != this && (*it)->m_name == newName )
-			{
-				uniqueAlready = false;
-				break;
-			}
-		}
+		const GraphComponent *existingChild = m_parent->getChildInternal( newName );
+		const bool uniqueAlready = !existingChild || existingChild == this;
 
 		if( !uniqueAlready )
 		{
@@ -106,21 +203,29 @@ const IECore::InternedString &GraphComponent::setName( const IECore::InternedStr
 			std::string prefix;
 			int suffix = StringAlgo::numericSuffix( newName.value(), 1, &prefix );
 
-			// iterate over all the siblings to find the minimum value for the suffix which
-			// will be greater than any existing suffix.
-			for( ChildContainer::const_iterator it=m_parent->m_children.begin(), eIt=m_parent->m_children.end(); it != eIt; it++ )
+			// find the minimum value for the suffix which will be greater than
+			// any existing suffix, using the index if we have one, and otherwise
+			// iterating over all the siblings.
+			if( m_parent->m_childIndex )
 			{
-				if( *it == this )
-				{
-					continue;
-				}
-				if( (*it)->m_name.value().compare( 0, prefix.size(), prefix ) == 0 )
+				suffix = max( suffix, (int)m_parent->m_childIndex->maxSuffix( prefix, this ) + 1 );
+			}
+			else
+			{
+				for( ChildContainer::const_iterator it=m_parent->m_children.begin(), eIt=m_parent->m_children.end(); it != eIt; it++ )
 				{
-					char *endPtr = 0;
-					long siblingSuffix = strtol( (*it)->m_name.value().c_str() + prefix.size(), &endPtr, 10 );
-					if( *endPtr == '\0' )
+					if( *it == this )
 					{
-						suffix = max( suffix, (int)siblingSuffix + 1 );
+						continue;
+					}
+					if( (*it)->m_name.value().compare( 0, prefix.size(), prefix ) == 0 )
+					{
+						char *endPtr = 0;
+						long siblingSuffix = strtol( (*it)->m_name.value().c_str() + prefix.size(), &endPtr, 10 );
+						if( *endPtr == '\0' )
+						{
+							suffix = max( suffix, (int)siblingSuffix + 1 );
+						}
 					}
 				}
 			}
@@ -148,7 +253,16 @@ const IECore::InternedString &GraphComponent::setName( const IECore::InternedStr
 
 void GraphComponent::setNameInternal( const IECore::InternedString &name )
 {
+	ChildIndex *index = m_parent ? m_parent->m_childIndex.get() : NULL;
+	if( index )
+	{
+		index->remove( this );
+	}
 	m_name = name;
+	if( index )
+	{
+		index->add( this );
+	}
 	nameChangedSignal()( this );
 }
 
@@ -305,6 +419,21 @@ void GraphComponent::addChildInternal( GraphComponentPtr child )
 	m_children.push_back( child );
 	child->m_parent = this;
 	child->setName( child->m_name.value() ); // to force uniqueness
+	if( m_childIndex )
+	{
+		if( !m_childIndex->contains( child.get() ) )
+		{
+			m_childIndex->add( child.get() );
+		}
+	}
+	else if( m_children.size() >= g_childIndexThreshold )
+	{
+		m_childIndex.reset( new ChildIndex );
+		for( ChildContainer::const_iterator it = m_children.begin(), eIt = m_children.end(); it != eIt; ++it )
+		{
+			m_childIndex->add( it->get() );
+		}
+	}
 	childAddedSignal()( this, child.get() );
 	child->parentChangedSignal()( child.get(), previousParent );
 }
@@ -353,8 +482,10 @@ void GraphComponent::removeChildInternal( GraphComponentPtr child, bool emitPare
 	{
 		child->parentChanging( 0 );
 	}
-	ChildContainer::iterator it = std::find( m_children.begin(), m_children.end(), child );
-	if( it == m_children.end() || child->m_parent != this )
+	// search from the back, so that removing children in reverse
+	// order (as clearChildren() does) is linear rather than quadratic.
+	ChildContainer::reverse_iterator rIt = std::find( m_children.rbegin(), m_children.rend(), child );
+	if( rIt == m_children.rend() || child->m_parent != this )
 	{
 		// the public removeChild() method protects against this case, but it's still possible to
 		// arrive here if an Action (which has a direct binding to removeChildInternal) is being replayed
@@ -365,7 +496,11 @@ void GraphComponent::removeChildInternal( GraphComponentPtr child, bool emitPare
 		// recorded and replayed automatically.
 		throw Exception( boost::str( boost::format( "GraphComponent::removeChildInternal : \"%s\" is not a child of \"%s\"." ) % child->fullName() % fullName() ) );
 	}
-	m_children.erase( it );
+	if( m_childIndex )
+	{
+		m_childIndex->remove( child.get() );
+	}
+	m_children.erase( ( rIt + 1 ).base() );
 	child->m_parent = 0;
 	childRemovedSignal()( this, child.get() );
 	if( emitParentChanged )
@@ -379,6 +514,24 @@ const GraphComponent::ChildContainer &GraphComponent::children() const
 	return m_children;
 }
 
+const GraphComponent *GraphComponent::getChildInternal( const IECore::InternedString &name ) const
+{
+	if( m_childIndex )
+	{
+		ChildIndex::NameMap::const_iterator it = m_childIndex->names.find( name.c_str() );
+		return it != m_childIndex->names.end() ? it->second : NULL;
+	}
+
+	for( ChildContainer::const_iterator it=m_children.begin(), eIt=m_children.end(); it!=eIt; it++ )
+	{
+		if( (*it)->m_name==name )
+		{
+			return it->get();
+		}
+	}
+	return NULL;
+}
+
 GraphComponent *GraphComponent::ancestor( IECore::TypeId type )
 {
 	GraphComponent *a = m_parent;
@@ -49,7 +49,7 @@ static IECore::InternedString g_namePropertyName( "name" );
 IE_CORE_DEFINERUNTIMETYPED( MatchPatternPathFilter );
 
 MatchPatternPathFilter::MatchPatternPathFilter( const std::vector<StringAlgo::MatchPattern> &patterns, IECore::InternedString propertyName, bool leafOnly, IECore::CompoundDataPtr userData )
-	:	PathFilter( userData ), m_patterns( patterns ), m_propertyName( propertyName ), m_leafOnly( leafOnly ), m_inverted( false )
+	:	PathFilter( userData ), m_patterns( patterns ), m_compiledPatterns( patterns ), m_propertyName( propertyName ), m_leafOnly( leafOnly ), m_inverted( false )
 {
 }
 
@@ -64,6 +64,7 @@ void MatchPatternPathFilter::setMatchPatterns( const std::vector<StringAlgo::Mat
 		return;
 	}
 	m_patterns = patterns;
+	m_compiledPatterns = StringAlgo::CompiledMatchPattern( m_patterns );
 	changedSignal()( this );
 }
 
@@ -147,12 +148,5 @@ bool MatchPatternPathFilter::remove( PathPtr path ) const
 		propertyValue = &propertyData->readable();
 	}
 
-	for( std::vector<StringAlgo::MatchPattern>::const_iterator it = m_patterns.begin(), eIt = m_patterns.end(); it != eIt; ++it )
-	{
-		if( StringAlgo::match( propertyValue->c_str(), *it ) )
-		{
-			return invert( false );
-		}
-	}
-	return invert( true );
+	return invert( !m_compiledPatterns.match( *propertyValue ) );
 }
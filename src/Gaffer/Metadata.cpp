@@ -43,6 +43,8 @@
 #include "boost/multi_index/ordered_index.hpp"
 #include "boost/multi_index/member.hpp"
 #include "boost/optional.hpp"
+#include "boost/shared_ptr.hpp"
+#include "boost/functional/hash.hpp"
 
 #include "IECore/CompoundData.h"
 #include "IECore/SimpleTypedData.h"
@@ -113,6 +115,38 @@ struct NodeMetadata
 	NodeValues nodeValues;
 	PlugPathsToValues plugPathsToValues;
 
+	// The subset of plugPathsToValues whose paths contain wildcards,
+	// in the same order. Plug paths without wildcards can be found by
+	// direct lookup, so there is no need to visit them when searching
+	// for matches.
+	// Each is stored with its compiled pattern, since
+	// they are matched against on every lookup.
+	typedef vector<pair<PlugPathsToValues::const_iterator, StringAlgo::CompiledMatchPattern> > WildcardPlugPaths;
+	WildcardPlugPaths wildcardPlugPaths;
+
+	PlugValues &plugValues( const StringAlgo::MatchPattern &plugPath )
+	{
+		PlugPathsToValues::iterator it = plugPathsToValues.find( plugPath );
+		if( it != plugPathsToValues.end() )
+		{
+			return it->second;
+		}
+
+		it = plugPathsToValues.insert( PlugPathsToValues::value_type( plugPath, PlugValues() ) ).first;
+		if( StringAlgo::hasWildcards( plugPath ) )
+		{
+			wildcardPlugPaths.clear();
+			for( PlugPathsToValues::const_iterator pIt = plugPathsToValues.begin(), peIt = plugPathsToValues.end(); pIt != peIt; ++pIt )
+			{
+				if( StringAlgo::hasWildcards( pIt->first ) )
+				{
+					wildcardPlugPaths.push_back( WildcardPlugPaths::value_type( pIt, StringAlgo::CompiledMatchPattern( pIt->first ) ) );
+				}
+			}
+		}
+		return it->second;
+	}
+
 };
 
 typedef std::map<IECore::TypeId, NodeMetadata> NodeMetadataMap;
@@ -123,6 +157,150 @@ NodeMetadataMap &nodeMetadataMap()
 	return m;
 }
 
+// The UI queries the same metadata for the same plugs over and over,
+// so we memoise the registration found for each query, rather than
+// repeating the search through all the patterns for each node type.
+// Entries are invalidated whenever plug metadata is registered or
+// deregistered.
+struct PlugValueQuery
+{
+
+	PlugValueQuery( IECore::TypeId typeId, const std::string &plugPath, InternedString key, bool inherit )
+		:	typeId( typeId ), plugPath( plugPath ), key( key ), inherit( inherit )
+	{
+	}
+
+	IECore::TypeId typeId;
+	std::string plugPath;
+	InternedString key;
+	bool inherit;
+
+	bool operator == ( const PlugValueQuery &rhs ) const
+	{
+		return typeId == rhs.typeId && key == rhs.key && inherit == rhs.inherit && plugPath == rhs.plugPath;
+	}
+
+};
+
+struct PlugValueQueryHashCompare
+{
+
+	static size_t hash( const PlugValueQuery &q )
+	{
+		size_t result = boost::hash<std::string>()( q.plugPath );
+		boost::hash_combine( result, (size_t)q.typeId );
+		boost::hash_combine( result, q.key.c_str() );
+		boost::hash_combine( result, q.inherit );
+		return result;
+	}
+
+	static bool equal( const PlugValueQuery &a, const PlugValueQuery &b )
+	{
+		return a == b;
+	}
+
+};
+
+// Maps to a copy of the function registered for the query, or NULL if
+// there is none. We hold copies rather than pointers into the registry,
+// and share ownership of them with the callers, so that a function
+// remains valid even if it is deregistered or the map is cleared while
+// it is being used.
+typedef boost::shared_ptr<const Metadata::PlugValueFunction> PlugValueFunctionPtr;
+typedef concurrent_hash_map<PlugValueQuery, PlugValueFunctionPtr, PlugValueQueryHashCompare> PlugValueQueryMap;
+
+PlugValueQueryMap &plugValueQueryMap()
+{
+	static PlugValueQueryMap m;
+	return m;
+}
+
+// Limits the memory used when many unique plug paths are queried.
+const size_t g_maxPlugValueQueries = 100000;
+
+// `PlugValueQueryMap::clear()` isn't safe to call concurrently with
+// `find()` or `insert()`, so queries hold a reader lock while clearing
+// holds a writer lock. Because a query holds its lock from lookup to
+// insertion, it can't memoise a result computed before a clear.
+typedef spin_rw_mutex PlugValueQueryMutex;
+
+PlugValueQueryMutex &plugValueQueryMutex()
+{
+	static PlugValueQueryMutex m;
+	return m;
+}
+
+const Metadata::PlugValueFunction *plugValueFunction( IECore::TypeId typeId, const std::string &plugPath, InternedString key, bool inherit )
+{
+	while( typeId != InvalidTypeId )
+	{
+		NodeMetadataMap::const_iterator nIt = nodeMetadataMap().find( typeId );
+		if( nIt != nodeMetadataMap().end() )
+		{
+			// First do a direct lookup using the plug path.
+			const NodeMetadata::PlugPathsToValues &plugPathsToValues = nIt->second.plugPathsToValues;
+			NodeMetadata::PlugPathsToValues::const_iterator it = plugPathsToValues.find( plugPath );
+			if( it != plugPathsToValues.end() )
+			{
+				NodeMetadata::PlugValues::const_iterator vIt = it->second.find( key );
+				if( vIt != it->second.end() )
+				{
+					return &vIt->second;
+				}
+			}
+			// And only if the direct lookups fails, do a full search using
+			// wildcard matches.
+			const NodeMetadata::WildcardPlugPaths &wildcardPlugPaths = nIt->second.wildcardPlugPaths;
+			for( NodeMetadata::WildcardPlugPaths::const_iterator wIt = wildcardPlugPaths.begin(), weIt = wildcardPlugPaths.end(); wIt != weIt; ++wIt )
+			{
+				if( wIt->second.match( plugPath ) )
+				{
+					const NodeMetadata::PlugValues &plugValues = wIt->first->second;
+					NodeMetadata::PlugValues::const_iterator vIt = plugValues.find( key );
+					if( vIt != plugValues.end() )
+					{
+						return &vIt->second;
+					}
+				}
+			}
+		}
+		typeId = inherit ? RunTimeTyped::baseTypeId( typeId ) : InvalidTypeId;
+	}
+	return NULL;
+}
+
+PlugValueFunctionPtr memoisedPlugValueFunction( IECore::TypeId typeId, const std::string &plugPath, InternedString key, bool inherit )
+{
+	PlugValueQueryMap &m = plugValueQueryMap();
+	const PlugValueQuery query( typeId, plugPath, key, inherit );
+
+	PlugValueQueryMutex::scoped_lock lock( plugValueQueryMutex(), /* write = */ false );
+	{
+		PlugValueQueryMap::const_accessor readAccessor;
+		if( m.find( readAccessor, query ) )
+		{
+			return readAccessor->second;
+		}
+	}
+
+	PlugValueFunctionPtr result;
+	if( const Metadata::PlugValueFunction *f = plugValueFunction( typeId, plugPath, key, inherit ) )
+	{
+		result.reset( new Metadata::PlugValueFunction( *f ) );
+	}
+	if( m.size() < g_maxPlugValueQueries )
+	{
+		m.insert( PlugValueQueryMap::value_type( query, result ) );
+	}
+	return result;
+}
+
+void clearPlugValueQueries()
+{
+	PlugValueQueryMutex::scoped_lock lock( plugValueQueryMutex(), /* write = */ true );
+	plugValueQueryMap().clear();
+}
+
 struct NamedInstanceValue
 {
 	NamedInstanceValue( InternedString n, ConstDataPtr v, bool p )
@@ -515,7 +693,7 @@ void Metadata::registerPlugValue( IECore::TypeId nodeTypeId, const StringAlgo::M
 void Metadata::registerPlugValue( IECore::TypeId nodeTypeId, const StringAlgo::MatchPattern &plugPath, IECore::InternedString key, PlugValueFunction value )
 {
 	NodeMetadata &nodeMetadata = nodeMetadataMap()[nodeTypeId];
-	NodeMetadata::PlugValues &plugValues = nodeMetadata.plugPathsToValues[plugPath];
+	NodeMetadata::PlugValues &plugValues = nodeMetadata.plugValues( plugPath );
 
 	NodeMetadata::NamedPlugValue namedValue( key, value );
 
@@ -529,6 +707,7 @@ void Metadata::registerPlugValue( IECore::TypeId nodeTypeId, const StringAlgo::M
 		plugValues.replace( it, namedValue );
 	}
 
+	clearPlugValueQueries();
 	plugValueChangedSignal()( nodeTypeId, plugPath, key, NULL );
 }
 
@@ -589,48 +768,14 @@ IECore::ConstDataPtr Metadata::plugValueInternal( const Plug *plug, IECore::Inte
 		return NULL;
 	}
 
-	const string plugPath = plug->relativeName( node );
-
-	IECore::TypeId typeId = node->typeId();
-	while( typeId != InvalidTypeId )
-	{
-		NodeMetadataMap::const_iterator nIt = nodeMetadataMap().find( typeId );
-		if( nIt != nodeMetadataMap().end() )
-		{
-			// First do a direct lookup using the plug path.
-			NodeMetadata::PlugPathsToValues::const_iterator it = nIt->second.plugPathsToValues.find( plugPath );
-			const NodeMetadata::PlugPathsToValues::const_iterator eIt = nIt->second.plugPathsToValues.end();
-			if( it != eIt )
-			{
-				NodeMetadata::PlugValues::const_iterator vIt = it->second.find( key );
-				if( vIt != it->second.end() )
-				{
-					return vIt->second( plug );
-				}
-			}
-			// And only if the direct lookups fails, do a full search using
-			// wildcard matches.
-			for( it = nIt->second.plugPathsToValues.begin(); it != eIt; ++it )
-			{
-				if( StringAlgo::match( plugPath, it->first ) )
-				{
-					NodeMetadata::PlugValues::const_iterator vIt = it->second.find( key );
-					if( vIt != it->second.end() )
-					{
-						return vIt->second( plug );
-					}
-				}
-			}
-		}
-		typeId = inherit ? RunTimeTyped::baseTypeId( typeId ) : InvalidTypeId;
-	}
-	return NULL;
+	PlugValueFunctionPtr f = memoisedPlugValueFunction( node->typeId(), plug->relativeName( node ), key, inherit );
+	return f ? (*f)( plug ) : NULL;
 }
 
 void Metadata::deregisterPlugValue( IECore::TypeId nodeTypeId, const StringAlgo::MatchPattern &plugPath, IECore::InternedString key )
 {
 	NodeMetadata &nodeMetadata = nodeMetadataMap()[nodeTypeId];
-	NodeMetadata::PlugValues &plugValues = nodeMetadata.plugPathsToValues[plugPath];
+	NodeMetadata::PlugValues &plugValues = nodeMetadata.plugValues( plugPath );
 
 	NodeMetadata::PlugValues::const_iterator it = plugValues.find( key );
 	if( it == plugValues.end() )
@@ -639,6 +784,7 @@ void Metadata::deregisterPlugValue( IECore::TypeId nodeTypeId, const StringAlgo:
 	}
 
 	plugValues.erase( it );
+	clearPlugValueQueries();
 	plugValueChangedSignal()( nodeTypeId, plugPath, key, NULL );
 }
 
@@ -35,6 +35,9 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <iomanip>
+#include <map>
+
+#include "boost/unordered_map.hpp"
 
 #include "Gaffer/PerformanceMonitor.h"
 #include "Gaffer/MonitorAlgo.h"
@@ -239,6 +242,11 @@ typename F::ResultType dispatchMetric( const F &f, MonitorAlgo::PerformanceMetri
 namespace
 {
 
+std::string plugName( const Plug *plug )
+{
+	return plug->relativeName( plug->ancestor( (IECore::TypeId)ScriptNodeTypeId ) );
+}
+
 struct PlugAndStatistics
 {
 
@@ -308,7 +316,7 @@ struct FormatStatistics
 			{
 				break;
 			}
-			plugNames.push_back( v[i].plug->relativeName( v[i].plug->ancestor( (IECore::TypeId)ScriptNodeTypeId ) ) );
+			plugNames.push_back( plugName( v[i].plug ) );
 			metrics.push_back( m );
 		}
 
@@ -330,6 +338,39 @@ struct FormatStatistics
 
 };
 
+std::string jsonString( const std::string &s )
+{
+	std::string result = "\"";
+	for( std::string::const_iterator it = s.begin(), eIt = s.end(); it != eIt; ++it )
+	{
+		switch( *it )
+		{
+			case '"' :
+				result += "\\\"";
+				break;
+			case '\\' :
+				result += "\\\\";
+				break;
+			default :
+				if( static_cast<unsigned char>( *it ) < 0x20 )
+				{
+					result += ' ';
+				}
+				else
+				{
+					result += *it;
+				}
+		}
+	}
+	result += "\"";
+	return result;
+}
+
+boost::chrono::duration<double, boost::micro> microseconds( boost::chrono::nanoseconds d )
+{
+	return boost::chrono::duration<double, boost::micro>( d );
+}
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -361,6 +402,89 @@ std::string formatStatistics( const PerformanceMonitor &monitor, PerformanceMetr
 	return dispatchMetric<FormatStatistics>( FormatStatistics( monitor.allStatistics(), maxLines ), metric );
 }
 
+std::string formatChromeTrace( const PerformanceMonitor &monitor )
+{
+	const PerformanceMonitor::Events &events = monitor.events();
+
+	std::stringstream s;
+	s << std::fixed << std::setprecision( 3 );
+	s << "{\"traceEvents\":[";
+	for( PerformanceMonitor::Events::const_iterator it = events.begin(), eIt = events.end(); it != eIt; ++it )
+	{
+		if( it != events.begin() )
+		{
+			s << ",";
+		}
+		s << "\n{";
+		s << "\"name\":" << jsonString( plugName( it->plug.get() ) );
+		s << ",\"cat\":" << jsonString( it->type.string() );
+		s << ",\"ph\":\"X\"";
+		s << ",\"ts\":" << microseconds( it->start ).count();
+		s << ",\"dur\":" << microseconds( it->end - it->start ).count();
+		s << ",\"pid\":0";
+		s << ",\"tid\":" << it->thread;
+		s << ",\"args\":{\"id\":" << it->processId << ",\"parent\":" << it->parentProcessId << "}";
+		s << "}";
+	}
+	s << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+	return s.str();
+}
+
+std::string formatFlameGraph( const PerformanceMonitor &monitor )
+{
+	const PerformanceMonitor::Events &events = monitor.events();
+
+	typedef boost::unordered_map<size_t, const PerformanceMonitor::Event *> EventMap;
+	EventMap eventMap;
+	for( PerformanceMonitor::Events::const_iterator it = events.begin(), eIt = events.end(); it != eIt; ++it )
+	{
+		eventMap[it->processId] = &*it;
+	}
+
+	// Self time is the duration of an event minus the time spent in
+	// children running on the same thread. Children running on other
+	// threads overlap with the parent rather than interrupting it, so
+	// time the parent spends waiting for them remains its own.
+	boost::unordered_map<size_t, boost::chrono::nanoseconds> selfTimes;
+	for( PerformanceMonitor::Events::const_iterator it = events.begin(), eIt = events.end(); it != eIt; ++it )
+	{
+		selfTimes[it->processId] += it->end - it->start;
+		EventMap::const_iterator parentIt = eventMap.find( it->parentProcessId );
+		if( parentIt != eventMap.end() && parentIt->second->thread == it->thread )
+		{
+			selfTimes[it->parentProcessId] -= it->end - it->start;
+		}
+	}
+
+	// Accumulate by stack, since the same stack typically recurs
+	// many times.
+	std::map<std::string, boost::chrono::nanoseconds> stacks;
+	for( PerformanceMonitor::Events::const_iterator it = events.begin(), eIt = events.end(); it != eIt; ++it )
+	{
+		std::string stack;
+		for( const PerformanceMonitor::Event *e = &*it; e; )
+		{
+			const std::string frame = plugName( e->plug.get() ) + " (" + e->type.string() + ")";
+			stack = stack.empty() ? frame : frame + ";" + stack;
+			EventMap::const_iterator parentIt = eventMap.find( e->parentProcessId );
+			e = parentIt != eventMap.end() ? parentIt->second : NULL;
+		}
+		stacks[stack] += std::max( selfTimes[it->processId], boost::chrono::nanoseconds( 0 ) );
+	}
+
+	std::stringstream s;
+	for( std::map<std::string, boost::chrono::nanoseconds>::const_iterator it = stacks.begin(), eIt = stacks.end(); it != eIt; ++it )
+	{
+		if( it->second.count() > 0 )
+		{
+			s << it->first << " " << it->second.count() << "\n";
+		}
+	}
+
+	return s.str();
+}
+
 } // namespace MonitorAlgo
 
 } // namespace Gaffer
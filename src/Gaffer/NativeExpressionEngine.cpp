@@ -0,0 +1,1540 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2016, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include <cmath>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+
+#include "boost/cstdint.hpp"
+#include "boost/format.hpp"
+#include "boost/lexical_cast.hpp"
+
+#include "IECore/SimpleTypedData.h"
+#include "IECore/NullObject.h"
+
+#include "Gaffer/Expression.h"
+#include "Gaffer/NumericPlug.h"
+#include "Gaffer/TypedPlug.h"
+#include "Gaffer/StringPlug.h"
+#include "Gaffer/Context.h"
+
+using namespace std;
+using namespace IECore;
+using namespace Gaffer;
+
+//////////////////////////////////////////////////////////////////////////
+// A small native expression language, supporting arithmetic, comparisons,
+// conditionals, context variable reads and string formatting. For example :
+//
+//     parent.n.user.f = context( "frame" ) * 0.1 + 3;
+//     parent.n.user.s = format( "shot%03d", int( context( "frame" ) ) );
+//     parent.n.user.i = context( "frame", 1 ) > 10 ? parent.n.user.j : 0;
+//
+// Expressions are compiled to bytecode in parse(), and executed by a
+// simple stack machine in execute(). Execution doesn't require Python,
+// so unlike the Python engine, doesn't serialise concurrent evaluations
+// by holding the GIL.
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+//////////////////////////////////////////////////////////////////////////
+// Value. The language has three types - int, float and string.
+//////////////////////////////////////////////////////////////////////////
+
+struct Value
+{
+
+	enum Type
+	{
+		Int,
+		Float,
+		String
+	};
+
+	Value()
+		:	type( Int ), i( 0 ), f( 0 )
+	{
+	}
+
+	Value( int v )
+		:	type( Int ), i( v ), f( 0 )
+	{
+	}
+
+	Value( double v )
+		:	type( Float ), i( 0 ), f( v )
+	{
+	}
+
+	Value( const std::string &v )
+		:	type( String ), i( 0 ), f( 0 ), s( v )
+	{
+	}
+
+	double number( const char *operation ) const
+	{
+		if( type == String )
+		{
+			throw IECore::Exception( boost::str( boost::format( "Unsupported string operand for %s" ) % operation ) );
+		}
+		return type == Int ? i : f;
+	}
+
+	bool truth() const
+	{
+		switch( type )
+		{
+			case Int :
+				return i;
+			case Float :
+				return f != 0.0;
+			default :
+				return !s.empty();
+		}
+	}
+
+	std::string toString() const
+	{
+		switch( type )
+		{
+			case Int :
+				return boost::lexical_cast<std::string>( i );
+			case Float :
+				return boost::str( boost::format( "%g" ) % f );
+			default :
+				return s;
+		}
+	}
+
+	Type type;
+	int i;
+	double f;
+	std::string s;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Tokenising
+//////////////////////////////////////////////////////////////////////////
+
+struct Token
+{
+
+	enum Type
+	{
+		End,
+		Number,
+		String,
+		Identifier,
+		PlugPath,
+		Operator
+	};
+
+	Type type;
+	// Operator characters, identifier name, unescaped string contents,
+	// number literal or plug path (without the "parent." prefix).
+	std::string text;
+	// Location in the source.
+	size_t begin;
+	size_t end;
+	int line;
+
+};
+
+typedef std::vector<Token> Tokens;
+
+void syntaxError( int line, const std::string &message )
+{
+	throw IECore::Exception( boost::str( boost::format( "Syntax error on line %d : %s" ) % line % message ) );
+}
+
+bool isIdentifierStart( char c )
+{
+	return isalpha( (unsigned char)c ) || c == '_';
+}
+
+bool isIdentifierCharacter( char c )
+{
+	return isalnum( (unsigned char)c ) || c == '_';
+}
+
+void tokenise( const std::string &source, Tokens &tokens )
+{
+	static const char *g_twoCharacterOperators[] = { "==", "!=", "<=", ">=", "&&", "||", NULL };
+	static const char *g_oneCharacterOperators = "+-*/%<>!(),?:=;";
+
+	int line = 1;
+	size_t i = 0;
+	const size_t size = source.size();
+	while( true )
+	{
+		// Skip whitespace and comments.
+		while( i < size )
+		{
+			if( source[i] == '\n' )
+			{
+				line++;
+				i++;
+			}
+			else if( isspace( (unsigned char)source[i] ) )
+			{
+				i++;
+			}
+			else if( source.compare( i, 2, "//" ) == 0 )
+			{
+				while( i < size && source[i] != '\n' )
+				{
+					i++;
+				}
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		Token token;
+		token.begin = i;
+		token.line = line;
+
+		if( i == size )
+		{
+			token.type = Token::End;
+			token.end = i;
+			tokens.push_back( token );
+			return;
+		}
+
+		const char c = source[i];
+		if( isdigit( (unsigned char)c ) || ( c == '.' && i + 1 < size && isdigit( (unsigned char)source[i+1] ) ) )
+		{
+			token.type = Token::Number;
+			while( i < size && ( isalnum( (unsigned char)source[i] ) || source[i] == '.' ) )
+			{
+				// Allow signed exponents.
+				if( ( source[i] == 'e' || source[i] == 'E' ) && i + 1 < size && ( source[i+1] == '-' || source[i+1] == '+' ) )
+				{
+					i++;
+				}
+				i++;
+			}
+		}
+		else if( c == '"' )
+		{
+			token.type = Token::String;
+			i++;
+			while( true )
+			{
+				if( i >= size || source[i] == '\n' )
+				{
+					syntaxError( line, "Unterminated string" );
+				}
+				else if( source[i] == '"' )
+				{
+					i++;
+					break;
+				}
+				else if( source[i] == '\\' && i + 1 < size )
+				{
+					switch( source[i+1] )
+					{
+						case 'n' :
+							token.text += '\n';
+							break;
+						case 't' :
+							token.text += '\t';
+							break;
+						default :
+							token.text += source[i+1];
+					}
+					i += 2;
+				}
+				else
+				{
+					token.text += source[i++];
+				}
+			}
+		}
+		else if( isIdentifierStart( c ) )
+		{
+			token.type = Token::Identifier;
+			while( i < size && isIdentifierCharacter( source[i] ) )
+			{
+				i++;
+			}
+			if( source.compare( token.begin, i - token.begin, "parent" ) == 0 )
+			{
+				// Plug path, of the form parent.node.plug
+				token.type = Token::PlugPath;
+				while( i < size && source[i] == '.' )
+				{
+					const size_t nameBegin = ++i;
+					while( i < size && isIdentifierCharacter( source[i] ) )
+					{
+						i++;
+					}
+					if( i == nameBegin )
+					{
+						syntaxError( line, "Expected plug name" );
+					}
+				}
+				if( i == token.begin + 6 )
+				{
+					syntaxError( line, "Expected plug path after \"parent\"" );
+				}
+				token.text = source.substr( token.begin + 7, i - token.begin - 7 );
+				token.end = i;
+				tokens.push_back( token );
+				continue;
+			}
+		}
+		else
+		{
+			token.type = Token::Operator;
+			for( const char **o = g_twoCharacterOperators; *o; ++o )
+			{
+				if( source.compare( i, 2, *o ) == 0 )
+				{
+					i += 2;
+					break;
+				}
+			}
+			if( i == token.begin )
+			{
+				if( !strchr( g_oneCharacterOperators, c ) )
+				{
+					syntaxError( line, boost::str( boost::format( "Unexpected character '%c'" ) % c ) );
+				}
+				i++;
+			}
+		}
+
+		if( token.type != Token::String )
+		{
+			token.text = source.substr( token.begin, i - token.begin );
+		}
+		token.end = i;
+		tokens.push_back( token );
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Bytecode
+//////////////////////////////////////////////////////////////////////////
+
+enum Function
+{
+	Abs,
+	Floor,
+	Ceil,
+	Round,
+	Min,
+	Max,
+	Clamp,
+	Pow,
+	Sqrt,
+	Sin,
+	Cos,
+	ToInt,
+	ToFloat,
+	ToString,
+	Format
+};
+
+struct FunctionDescription
+{
+	const char *name;
+	Function function;
+	int minArguments;
+	int maxArguments;
+};
+
+const FunctionDescription g_functions[] = {
+	{ "abs", Abs, 1, 1 },
+	{ "floor", Floor, 1, 1 },
+	{ "ceil", Ceil, 1, 1 },
+	{ "round", Round, 1, 1 },
+	{ "min", Min, 2, 2 },
+	{ "max", Max, 2, 2 },
+	{ "clamp", Clamp, 3, 3 },
+	{ "pow", Pow, 2, 2 },
+	{ "sqrt", Sqrt, 1, 1 },
+	{ "sin", Sin, 1, 1 },
+	{ "cos", Cos, 1, 1 },
+	{ "int", ToInt, 1, 1 },
+	{ "float", ToFloat, 1, 1 },
+	{ "str", ToString, 1, 1 },
+	{ "format", Format, 1, 16 },
+	{ NULL, Abs, 0, 0 }
+};
+
+struct Instruction
+{
+
+	enum Opcode
+	{
+		// Push constants[operand].
+		PushConstant,
+		// Push the value of input plug `operand`.
+		PushInput,
+		// Push the value of context variable contextNames[operand].
+		PushContext,
+		// As above, but pop a default value to use if the variable
+		// doesn't exist.
+		PushContextWithDefault,
+		// Unary operators, replacing the top of the stack.
+		Negate,
+		Not,
+		Truth,
+		// Binary operators, popping two values and pushing the result.
+		Add,
+		Subtract,
+		Multiply,
+		Divide,
+		Modulo,
+		Equal,
+		NotEqual,
+		Less,
+		LessEqual,
+		Greater,
+		GreaterEqual,
+		// Jump to instruction `operand`.
+		Jump,
+		// Pop a value, and jump to instruction `operand` if it is false.
+		JumpIfFalse,
+		// Pop `argumentCount` arguments and push the result of calling
+		// Function( operand ).
+		Call,
+		// Pop a value and store it as output `operand`, or discard it
+		// if operand is -1.
+		Store
+	};
+
+	Instruction( Opcode o, int a = 0, int n = 0 )
+		:	opcode( o ), operand( a ), argumentCount( n )
+	{
+	}
+
+	Opcode opcode;
+	int operand;
+	int argumentCount;
+
+};
+
+struct Program
+{
+
+	std::vector<Instruction> instructions;
+	std::vector<Value> constants;
+	std::vector<IECore::InternedString> contextNames;
+	std::vector<std::string> inPlugPaths;
+	std::vector<std::string> outPlugPaths;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Compilation
+//////////////////////////////////////////////////////////////////////////
+
+const char *g_disconnected = "_disconnected";
+
+class Compiler
+{
+
+	public :
+
+		Compiler( const std::string &source, Program &program )
+			:	m_program( program ), m_index( 0 )
+		{
+			tokenise( source, m_tokens );
+			while( current().type != Token::End )
+			{
+				statement();
+			}
+		}
+
+	private :
+
+		// Grammar
+		// =======
+
+		void statement()
+		{
+			int output = -1;
+			if( current().type == Token::PlugPath )
+			{
+				output = outputIndex( current().text );
+			}
+			else if( current().type != Token::Identifier || current().text != g_disconnected )
+			{
+				error( "Expected plug to assign to" );
+			}
+			m_index++;
+
+			expect( "=" );
+			expression();
+			emit( Instruction::Store, output );
+
+			accept( ";" );
+		}
+
+		void expression()
+		{
+			logicalOr();
+			if( accept( "?" ) )
+			{
+				const size_t jumpToFalse = emit( Instruction::JumpIfFalse );
+				expression();
+				const size_t jumpToEnd = emit( Instruction::Jump );
+				expect( ":" );
+				patch( jumpToFalse );
+				expression();
+				patch( jumpToEnd );
+			}
+		}
+
+		void logicalOr()
+		{
+			logicalAnd();
+			while( accept( "||" ) )
+			{
+				const size_t jumpToRight = emit( Instruction::JumpIfFalse );
+				emit( Instruction::PushConstant, constant( Value( 1 ) ) );
+				const size_t jumpToEnd = emit( Instruction::Jump );
+				patch( jumpToRight );
+				logicalAnd();
+				emit( Instruction::Truth );
+				patch( jumpToEnd );
+			}
+		}
+
+		void logicalAnd()
+		{
+			equality();
+			while( accept( "&&" ) )
+			{
+				const size_t jumpToFalse = emit( Instruction::JumpIfFalse );
+				equality();
+				emit( Instruction::Truth );
+				const size_t jumpToEnd = emit( Instruction::Jump );
+				patch( jumpToFalse );
+				emit( Instruction::PushConstant, constant( Value( 0 ) ) );
+				patch( jumpToEnd );
+			}
+		}
+
+		void equality()
+		{
+			comparison();
+			while( true )
+			{
+				if( accept( "==" ) )
+				{
+					comparison();
+					emit( Instruction::Equal );
+				}
+				else if( accept( "!=" ) )
+				{
+					comparison();
+					emit( Instruction::NotEqual );
+				}
+				else
+				{
+					return;
+				}
+			}
+		}
+
+		void comparison()
+		{
+			additive();
+			while( true )
+			{
+				Instruction::Opcode opcode;
+				if( accept( "<" ) )
+				{
+					opcode = Instruction::Less;
+				}
+				else if( accept( "<=" ) )
+				{
+					opcode = Instruction::LessEqual;
+				}
+				else if( accept( ">" ) )
+				{
+					opcode = Instruction::Greater;
+				}
+				else if( accept( ">=" ) )
+				{
+					opcode = Instruction::GreaterEqual;
+				}
+				else
+				{
+					return;
+				}
+				additive();
+				emit( opcode );
+			}
+		}
+
+		void additive()
+		{
+			multiplicative();
+			while( true )
+			{
+				if( accept( "+" ) )
+				{
+					multiplicative();
+					emit( Instruction::Add );
+				}
+				else if( accept( "-" ) )
+				{
+					multiplicative();
+					emit( Instruction::Subtract );
+				}
+				else
+				{
+					return;
+				}
+			}
+		}
+
+		void multiplicative()
+		{
+			unary();
+			while( true )
+			{
+				Instruction::Opcode opcode;
+				if( accept( "*" ) )
+				{
+					opcode = Instruction::Multiply;
+				}
+				else if( accept( "/" ) )
+				{
+					opcode = Instruction::Divide;
+				}
+				else if( accept( "%" ) )
+				{
+					opcode = Instruction::Modulo;
+				}
+				else
+				{
+					return;
+				}
+				unary();
+				emit( opcode );
+			}
+		}
+
+		void unary()
+		{
+			if( accept( "-" ) )
+			{
+				unary();
+				emit( Instruction::Negate );
+			}
+			else if( accept( "!" ) )
+			{
+				unary();
+				emit( Instruction::Not );
+			}
+			else
+			{
+				primary();
+			}
+		}
+
+		void primary()
+		{
+			const Token &token = current();
+			switch( token.type )
+			{
+				case Token::Number :
+					emit( Instruction::PushConstant, constant( number( token ) ) );
+					m_index++;
+					break;
+				case Token::String :
+					emit( Instruction::PushConstant, constant( Value( token.text ) ) );
+					m_index++;
+					break;
+				case Token::PlugPath :
+					emit( Instruction::PushInput, inputIndex( token.text ) );
+					m_index++;
+					break;
+				case Token::Identifier :
+					m_index++;
+					if( token.text == "true" || token.text == "false" )
+					{
+						emit( Instruction::PushConstant, constant( Value( token.text == "true" ? 1 : 0 ) ) );
+					}
+					else
+					{
+						call( token.text );
+					}
+					break;
+				default :
+					if( accept( "(" ) )
+					{
+						expression();
+						expect( ")" );
+					}
+					else
+					{
+						error( token.type == Token::End ? "Unexpected end of expression" : "Unexpected \"" + token.text + "\"" );
+					}
+			}
+		}
+
+		void call( const std::string &name )
+		{
+			expect( "(" );
+
+			if( name == "context" )
+			{
+				if( current().type != Token::String )
+				{
+					error( "Context variable name must be a string" );
+				}
+				const int nameIndex = contextNameIndex( current().text );
+				m_index++;
+				if( accept( "," ) )
+				{
+					expression();
+					emit( Instruction::PushContextWithDefault, nameIndex );
+				}
+				else
+				{
+					emit( Instruction::PushContext, nameIndex );
+				}
+				expect( ")" );
+				return;
+			}
+
+			const FunctionDescription *function = g_functions;
+			while( function->name && name != function->name )
+			{
+				function++;
+			}
+			if( !function->name )
+			{
+				error( "Unknown function \"" + name + "\"" );
+			}
+
+			int numArguments = 0;
+			if( !accept( ")" ) )
+			{
+				do
+				{
+					expression();
+					numArguments++;
+				} while( accept( "," ) );
+				expect( ")" );
+			}
+
+			if( numArguments < function->minArguments || numArguments > function->maxArguments )
+			{
+				error( boost::str( boost::format( "Wrong number of arguments to \"%s\"" ) % name ) );
+			}
+
+			emit( Instruction::Call, function->function, numArguments );
+		}
+
+		// Utilities
+		// =========
+
+		const Token &current() const
+		{
+			return m_tokens[m_index];
+		}
+
+		bool accept( const char *op )
+		{
+			if( current().type == Token::Operator && current().text == op )
+			{
+				m_index++;
+				return true;
+			}
+			return false;
+		}
+
+		void expect( const char *op )
+		{
+			if( !accept( op ) )
+			{
+				error( std::string( "Expected \"" ) + op + "\"" );
+			}
+		}
+
+		void error( const std::string &message ) const
+		{
+			syntaxError( current().line, message );
+		}
+
+		Value number( const Token &token ) const
+		{
+			const char *begin = token.text.c_str();
+			char *end = NULL;
+			Value result;
+			if( token.text.find_first_of( ".eE" ) == std::string::npos )
+			{
+				errno = 0;
+				const long l = strtol( begin, &end, 10 );
+				if( errno == ERANGE || l < std::numeric_limits<int>::min() || l > std::numeric_limits<int>::max() )
+				{
+					error( "Integer overflow in \"" + token.text + "\"" );
+				}
+				result = Value( (int)l );
+			}
+			else
+			{
+				result = Value( strtod( begin, &end ) );
+			}
+			if( *end )
+			{
+				error( "Invalid number \"" + token.text + "\"" );
+			}
+			return result;
+		}
+
+		size_t emit( Instruction::Opcode opcode, int operand = 0, int argumentCount = 0 )
+		{
+			m_program.instructions.push_back( Instruction( opcode, operand, argumentCount ) );
+			return m_program.instructions.size() - 1;
+		}
+
+		// Makes the jump instruction at `index` jump to the
+		// next instruction to be emitted.
+		void patch( size_t index )
+		{
+			m_program.instructions[index].operand = m_program.instructions.size();
+		}
+
+		int constant( const Value &value )
+		{
+			m_program.constants.push_back( value );
+			return m_program.constants.size() - 1;
+		}
+
+		static int index( std::vector<std::string> &names, const std::string &name )
+		{
+			std::vector<std::string>::const_iterator it = std::find( names.begin(), names.end(), name );
+			if( it != names.end() )
+			{
+				return it - names.begin();
+			}
+			names.push_back( name );
+			return names.size() - 1;
+		}
+
+		int inputIndex( const std::string &plugPath )
+		{
+			return index( m_program.inPlugPaths, plugPath );
+		}
+
+		int outputIndex( const std::string &plugPath )
+		{
+			return index( m_program.outPlugPaths, plugPath );
+		}
+
+		int contextNameIndex( const std::string &nameString )
+		{
+			const IECore::InternedString name( nameString );
+			std::vector<IECore::InternedString>::const_iterator it = std::find( m_program.contextNames.begin(), m_program.contextNames.end(), name );
+			if( it != m_program.contextNames.end() )
+			{
+				return it - m_program.contextNames.begin();
+			}
+			m_program.contextNames.push_back( name );
+			return m_program.contextNames.size() - 1;
+		}
+
+		Program &m_program;
+		Tokens m_tokens;
+		size_t m_index;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Execution
+//////////////////////////////////////////////////////////////////////////
+
+Value inputValue( const ValuePlug *plug )
+{
+	switch( (Gaffer::TypeId)plug->typeId() )
+	{
+		case BoolPlugTypeId :
+			return Value( static_cast<const BoolPlug *>( plug )->getValue() ? 1 : 0 );
+		case IntPlugTypeId :
+			return Value( static_cast<const IntPlug *>( plug )->getValue() );
+		case FloatPlugTypeId :
+			return Value( (double)static_cast<const FloatPlug *>( plug )->getValue() );
+		case StringPlugTypeId :
+			return Value( static_cast<const StringPlug *>( plug )->getValue() );
+		default :
+			// Shouldn't get here, as parse() rejects other types.
+			throw IECore::Exception( string( "Unsupported plug type \"" ) + plug->typeName() + "\"" );
+	}
+}
+
+Value contextValue( const Context *context, const IECore::InternedString &name, const Value *defaultValue )
+{
+	const Data *data = context->get<Data>( name, NULL );
+	if( !data )
+	{
+		if( defaultValue )
+		{
+			return *defaultValue;
+		}
+		throw IECore::Exception( boost::str( boost::format( "Context has no entry named \"%s\"" ) % name.string() ) );
+	}
+
+	switch( data->typeId() )
+	{
+		case IntDataTypeId :
+			return Value( static_cast<const IntData *>( data )->readable() );
+		case FloatDataTypeId :
+			return Value( (double)static_cast<const FloatData *>( data )->readable() );
+		case BoolDataTypeId :
+			return Value( static_cast<const BoolData *>( data )->readable() ? 1 : 0 );
+		case StringDataTypeId :
+			return Value( static_cast<const StringData *>( data )->readable() );
+		default :
+			throw IECore::Exception( boost::str( boost::format( "Context variable \"%s\" has unsupported type \"%s\"" ) % name.string() % data->typeName() ) );
+	}
+}
+
+// Int arithmetic is performed at 64 bit precision, so that we can detect
+// overflow rather than invoke undefined behaviour (or SIGFPE, in the case
+// of `INT_MIN / -1`).
+Value intValue( boost::int64_t v, const char *name )
+{
+	if( v < std::numeric_limits<int>::min() || v > std::numeric_limits<int>::max() )
+	{
+		throw IECore::Exception( boost::str( boost::format( "Integer overflow in \"%s\"" ) % name ) );
+	}
+	return Value( (int)v );
+}
+
+// Conversion from float truncates towards zero, as in C, but must
+// check the range first because converting an out of range value
+// (including NaN and infinity) is undefined behaviour.
+Value intValue( double v, const char *name )
+{
+	if( !( v > (double)std::numeric_limits<int>::min() - 1.0 && v < (double)std::numeric_limits<int>::max() + 1.0 ) )
+	{
+		throw IECore::Exception( boost::str( boost::format( "Integer overflow in \"%s\"" ) % name ) );
+	}
+	return Value( (int)v );
+}
+
+Value arithmetic( Instruction::Opcode opcode, const Value &a, const Value &b )
+{
+	if( opcode == Instruction::Add && a.type == Value::String && b.type == Value::String )
+	{
+		return Value( a.s + b.s );
+	}
+
+	static const char *g_names[] = { "+", "-", "*", "/", "%" };
+	const char *name = g_names[opcode - Instruction::Add];
+
+	if( a.type == Value::Int && b.type == Value::Int )
+	{
+		const boost::int64_t x = a.i;
+		const boost::int64_t y = b.i;
+		switch( opcode )
+		{
+			case Instruction::Add :
+				return intValue( x + y, name );
+			case Instruction::Subtract :
+				return intValue( x - y, name );
+			case Instruction::Multiply :
+				return intValue( x * y, name );
+			default :
+				if( y == 0 )
+				{
+					throw IECore::Exception( "Division by zero" );
+				}
+				return intValue( opcode == Instruction::Divide ? x / y : x % y, name );
+		}
+	}
+
+	const double x = a.number( name );
+	const double y = b.number( name );
+	switch( opcode )
+	{
+		case Instruction::Add :
+			return Value( x + y );
+		case Instruction::Subtract :
+			return Value( x - y );
+		case Instruction::Multiply :
+			return Value( x * y );
+		default :
+			if( y == 0.0 )
+			{
+				throw IECore::Exception( "Division by zero" );
+			}
+			return Value( opcode == Instruction::Divide ? x / y : fmod( x, y ) );
+	}
+}
+
+Value compare( Instruction::Opcode opcode, const Value &a, const Value &b )
+{
+	int c;
+	if( a.type == Value::String || b.type == Value::String )
+	{
+		if( a.type != b.type )
+		{
+			if( opcode == Instruction::Equal || opcode == Instruction::NotEqual )
+			{
+				return Value( opcode == Instruction::NotEqual ? 1 : 0 );
+			}
+			throw IECore::Exception( "Cannot compare string with number" );
+		}
+		c = a.s.compare( b.s );
+	}
+	else
+	{
+		const double x = a.number( "comparison" );
+		const double y = b.number( "comparison" );
+		c = x < y ? -1 : ( x > y ? 1 : 0 );
+	}
+
+	switch( opcode )
+	{
+		case Instruction::Equal :
+			return Value( c == 0 ? 1 : 0 );
+		case Instruction::NotEqual :
+			return Value( c != 0 ? 1 : 0 );
+		case Instruction::Less :
+			return Value( c < 0 ? 1 : 0 );
+		case Instruction::LessEqual :
+			return Value( c <= 0 ? 1 : 0 );
+		case Instruction::Greater :
+			return Value( c > 0 ? 1 : 0 );
+		default :
+			return Value( c >= 0 ? 1 : 0 );
+	}
+}
+
+Value format( const Value *arguments, int numArguments )
+{
+	if( arguments[0].type != Value::String )
+	{
+		throw IECore::Exception( "First argument to \"format\" must be a string" );
+	}
+
+	try
+	{
+		boost::format f( arguments[0].s );
+		for( int i = 1; i < numArguments; ++i )
+		{
+			switch( arguments[i].type )
+			{
+				case Value::Int :
+					f % arguments[i].i;
+					break;
+				case Value::Float :
+					f % arguments[i].f;
+					break;
+				default :
+					f % arguments[i].s;
+			}
+		}
+		return Value( f.str() );
+	}
+	catch( const boost::io::format_error &e )
+	{
+		throw IECore::Exception( std::string( "Error in \"format\" : " ) + e.what() );
+	}
+}
+
+Value call( Function function, const Value *arguments, int numArguments )
+{
+	const Value &a = arguments[0];
+	switch( function )
+	{
+		case Abs :
+			return a.type == Value::Int ? intValue( a.i < 0 ? -(boost::int64_t)a.i : (boost::int64_t)a.i, "abs" ) : Value( fabs( a.number( "abs" ) ) );
+		case Floor :
+			return Value( floor( a.number( "floor" ) ) );
+		case Ceil :
+			return Value( ceil( a.number( "ceil" ) ) );
+		case Round :
+			return Value( floor( a.number( "round" ) + 0.5 ) );
+		case Min :
+		case Max :
+		{
+			const Value &b = arguments[1];
+			const bool less = a.number( "min/max" ) < b.number( "min/max" );
+			return ( function == Min ) == less ? a : b;
+		}
+		case Clamp :
+		{
+			const double x = a.number( "clamp" );
+			if( x < arguments[1].number( "clamp" ) )
+			{
+				return arguments[1];
+			}
+			else if( x > arguments[2].number( "clamp" ) )
+			{
+				return arguments[2];
+			}
+			return a;
+		}
+		case Pow :
+			return Value( pow( a.number( "pow" ), arguments[1].number( "pow" ) ) );
+		case Sqrt :
+			return Value( sqrt( a.number( "sqrt" ) ) );
+		case Sin :
+			return Value( sin( a.number( "sin" ) ) );
+		case Cos :
+			return Value( cos( a.number( "cos" ) ) );
+		case ToInt :
+			if( a.type == Value::String )
+			{
+				try
+				{
+					return Value( boost::lexical_cast<int>( a.s ) );
+				}
+				catch( const boost::bad_lexical_cast & )
+				{
+					throw IECore::Exception( "Invalid int \"" + a.s + "\"" );
+				}
+			}
+			return a.type == Value::Int ? a : intValue( a.f, "int" );
+		case ToFloat :
+			if( a.type == Value::String )
+			{
+				try
+				{
+					return Value( boost::lexical_cast<double>( a.s ) );
+				}
+				catch( const boost::bad_lexical_cast & )
+				{
+					throw IECore::Exception( "Invalid float \"" + a.s + "\"" );
+				}
+			}
+			return Value( a.number( "float" ) );
+		case ToString :
+			return Value( a.toString() );
+		case Format :
+			return format( arguments, numArguments );
+	}
+
+	return Value();
+}
+
+ObjectPtr resultData( const Value &value )
+{
+	switch( value.type )
+	{
+		case Value::Int :
+			return new IntData( value.i );
+		case Value::Float :
+			return new FloatData( value.f );
+		default :
+			return new StringData( value.s );
+	}
+}
+
+void executeProgram( const Program &program, const Context *context, const std::vector<const ValuePlug *> &inputs, std::vector<Value> &outputs )
+{
+	std::vector<Value> stack;
+	stack.reserve( 16 );
+
+	const std::vector<Instruction> &instructions = program.instructions;
+	size_t i = 0;
+	while( i < instructions.size() )
+	{
+		const Instruction &instruction = instructions[i++];
+		switch( instruction.opcode )
+		{
+			case Instruction::PushConstant :
+				stack.push_back( program.constants[instruction.operand] );
+				break;
+			case Instruction::PushInput :
+				stack.push_back( inputValue( inputs[instruction.operand] ) );
+				break;
+			case Instruction::PushContext :
+				stack.push_back( contextValue( context, program.contextNames[instruction.operand], NULL ) );
+				break;
+			case Instruction::PushContextWithDefault :
+				stack.back() = contextValue( context, program.contextNames[instruction.operand], &stack.back() );
+				break;
+			case Instruction::Negate :
+			{
+				Value &a = stack.back();
+				a = a.type == Value::Int ? intValue( -(boost::int64_t)a.i, "-" ) : Value( -a.number( "-" ) );
+				break;
+			}
+			case Instruction::Not :
+				stack.back() = Value( stack.back().truth() ? 0 : 1 );
+				break;
+			case Instruction::Truth :
+				stack.back() = Value( stack.back().truth() ? 1 : 0 );
+				break;
+			case Instruction::Add :
+			case Instruction::Subtract :
+			case Instruction::Multiply :
+			case Instruction::Divide :
+			case Instruction::Modulo :
+			{
+				Value r = arithmetic( instruction.opcode, stack[stack.size()-2], stack.back() );
+				stack.pop_back();
+				stack.back() = r;
+				break;
+			}
+			case Instruction::Equal :
+			case Instruction::NotEqual :
+			case Instruction::Less :
+			case Instruction::LessEqual :
+			case Instruction::Greater :
+			case Instruction::GreaterEqual :
+			{
+				Value r = compare( instruction.opcode, stack[stack.size()-2], stack.back() );
+				stack.pop_back();
+				stack.back() = r;
+				break;
+			}
+			case Instruction::Jump :
+				i = instruction.operand;
+				break;
+			case Instruction::JumpIfFalse :
+				if( !stack.back().truth() )
+				{
+					i = instruction.operand;
+				}
+				stack.pop_back();
+				break;
+			case Instruction::Call :
+			{
+				const size_t firstArgument = stack.size() - instruction.argumentCount;
+				Value r = call( (Function)instruction.operand, &stack[firstArgument], instruction.argumentCount );
+				stack.resize( firstArgument );
+				stack.push_back( r );
+				break;
+			}
+			case Instruction::Store :
+				if( instruction.operand >= 0 )
+				{
+					outputs[instruction.operand] = stack.back();
+				}
+				stack.pop_back();
+				break;
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// NativeExpressionEngine
+//////////////////////////////////////////////////////////////////////////
+
+class NativeExpressionEngine : public Gaffer::Expression::Engine
+{
+
+	public :
+
+		IE_CORE_DECLAREMEMBERPTR( NativeExpressionEngine );
+
+		NativeExpressionEngine()
+		{
+		}
+
+		virtual void parse( Expression *node, const std::string &expression, std::vector<ValuePlug *> &inputs, std::vector<ValuePlug *> &outputs, std::vector<IECore::InternedString> &contextVariables )
+		{
+			// Compile into a temporary, so that we are unchanged
+			// if compilation fails.
+			Program program;
+			Compiler compiler( expression, program );
+
+			for( vector<string>::const_iterator it = program.inPlugPaths.begin(), eIt = program.inPlugPaths.end(); it != eIt; ++it )
+			{
+				inputs.push_back( plug( node, *it ) );
+			}
+			for( vector<string>::const_iterator it = program.outPlugPaths.begin(), eIt = program.outPlugPaths.end(); it != eIt; ++it )
+			{
+				outputs.push_back( plug( node, *it ) );
+			}
+			contextVariables.insert( contextVariables.end(), program.contextNames.begin(), program.contextNames.end() );
+
+			m_program = program;
+		}
+
+		virtual IECore::ConstObjectVectorPtr execute( const Gaffer::Context *context, const std::vector<const Gaffer::ValuePlug *> &proxyInputs ) const
+		{
+			std::vector<Value> outputs( m_program.outPlugPaths.size() );
+			executeProgram( m_program, context, proxyInputs, outputs );
+
+			ObjectVectorPtr result = new ObjectVector;
+			result->members().reserve( outputs.size() );
+			for( std::vector<Value>::const_iterator it = outputs.begin(), eIt = outputs.end(); it != eIt; ++it )
+			{
+				result->members().push_back( resultData( *it ) );
+			}
+
+			return result;
+		}
+
+		virtual void apply( Gaffer::ValuePlug *proxyOutput, const Gaffer::ValuePlug *topLevelProxyOutput, const IECore::Object *value ) const
+		{
+			Value v;
+			switch( value->typeId() )
+			{
+				case IntDataTypeId :
+					v = Value( static_cast<const IntData *>( value )->readable() );
+					break;
+				case FloatDataTypeId :
+					v = Value( (double)static_cast<const FloatData *>( value )->readable() );
+					break;
+				case StringDataTypeId :
+					v = Value( static_cast<const StringData *>( value )->readable() );
+					break;
+				default :
+					// Shouldn't get here, as execute() only returns the types above.
+					proxyOutput->setToDefault();
+					return;
+			}
+
+			switch( (Gaffer::TypeId)proxyOutput->typeId() )
+			{
+				case BoolPlugTypeId :
+					static_cast<BoolPlug *>( proxyOutput )->setValue( v.truth() );
+					break;
+				case IntPlugTypeId :
+					static_cast<IntPlug *>( proxyOutput )->setValue( v.type == Value::Int ? v.i : intValue( v.number( "IntPlug assignment" ), "IntPlug assignment" ).i );
+					break;
+				case FloatPlugTypeId :
+					static_cast<FloatPlug *>( proxyOutput )->setValue( v.number( "FloatPlug assignment" ) );
+					break;
+				case StringPlugTypeId :
+					static_cast<StringPlug *>( proxyOutput )->setValue( v.toString() );
+					break;
+				default :
+					// Shouldn't get here, as parse() rejects other types.
+					assert( false );
+			}
+		}
+
+		virtual std::string identifier( const Expression *node, const ValuePlug *plug ) const
+		{
+			if( !supported( plug ) )
+			{
+				return "";
+			}
+
+			string relativeName;
+			if( node->isAncestorOf( plug ) )
+			{
+				relativeName = plug->relativeName( node );
+			}
+			else
+			{
+				relativeName = plug->relativeName( node->parent<Node>() );
+			}
+
+			return "parent." + relativeName;
+		}
+
+		virtual std::string replace( const Expression *node, const std::string &expression, const std::vector<const ValuePlug *> &oldPlugs, const std::vector<const ValuePlug *> &newPlugs ) const
+		{
+			// We replace whole plug path tokens, so there's no danger of
+			// replacing part of a longer path which shares a prefix.
+			Tokens tokens;
+			tokenise( expression, tokens );
+
+			std::string result;
+			size_t copied = 0;
+			for( Tokens::const_iterator it = tokens.begin(), eIt = tokens.end(); it != eIt; ++it )
+			{
+				if( it->type != Token::PlugPath )
+				{
+					continue;
+				}
+
+				const std::string path = "parent." + it->text;
+				for( size_t i = 0, e = oldPlugs.size(); i < e; ++i )
+				{
+					if( identifier( node, oldPlugs[i] ) != path )
+					{
+						continue;
+					}
+
+					std::string replacement;
+					if( newPlugs[i] )
+					{
+						replacement = identifier( node, newPlugs[i] );
+					}
+					else if( oldPlugs[i]->direction() == Plug::In )
+					{
+						replacement = literal( oldPlugs[i], /* useDefault = */ true );
+					}
+					else
+					{
+						replacement = g_disconnected;
+					}
+
+					result += expression.substr( copied, it->begin - copied ) + replacement;
+					copied = it->end;
+					break;
+				}
+			}
+
+			result += expression.substr( copied );
+			return result;
+		}
+
+		virtual std::string defaultExpression( const ValuePlug *output ) const
+		{
+			const Node *parentNode = output->node() ? output->node()->ancestor<Node>() : NULL;
+			if( !parentNode || !supported( output ) )
+			{
+				return "";
+			}
+
+			return "parent." + output->relativeName( parentNode ) + " = " + literal( output, /* useDefault = */ false ) + ";";
+		}
+
+	private :
+
+		static EngineDescription<NativeExpressionEngine> g_engineDescription;
+
+		static bool supported( const ValuePlug *plug )
+		{
+			switch( (Gaffer::TypeId)plug->typeId() )
+			{
+				case BoolPlugTypeId :
+				case FloatPlugTypeId :
+				case IntPlugTypeId :
+				case StringPlugTypeId :
+					return true;
+				default :
+					return false;
+			}
+		}
+
+		static ValuePlug *plug( Expression *node, const std::string &plugPath )
+		{
+			Node *plugScope = node->parent<Node>();
+			GraphComponent *descendant = plugScope->descendant<GraphComponent>( plugPath );
+			if( !descendant )
+			{
+				throw IECore::Exception( boost::str( boost::format( "\"%s\" does not exist" ) % plugPath ) );
+			}
+
+			ValuePlug *result = runTimeCast<ValuePlug>( descendant );
+			if( !result )
+			{
+				throw IECore::Exception( boost::str( boost::format( "\"%s\" is not a ValuePlug" ) % plugPath ) );
+			}
+
+			if( !supported( result ) )
+			{
+				throw IECore::Exception( string( "Unsupported plug type \"" ) + result->typeName() + "\"" );
+			}
+
+			return result;
+		}
+
+		// Returns a literal for the plug's current or default value.
+		static std::string literal( const ValuePlug *plug, bool useDefault )
+		{
+			switch( (Gaffer::TypeId)plug->typeId() )
+			{
+				case BoolPlugTypeId :
+				{
+					const BoolPlug *p = static_cast<const BoolPlug *>( plug );
+					return ( useDefault ? p->defaultValue() : p->getValue() ) ? "true" : "false";
+				}
+				case FloatPlugTypeId :
+				{
+					const FloatPlug *p = static_cast<const FloatPlug *>( plug );
+					std::string result = boost::lexical_cast<std::string>( useDefault ? p->defaultValue() : p->getValue() );
+					if( result.find_first_of( ".en" ) == std::string::npos )
+					{
+						result += ".0";
+					}
+					return result;
+				}
+				case IntPlugTypeId :
+				{
+					const IntPlug *p = static_cast<const IntPlug *>( plug );
+					return boost::lexical_cast<std::string>( useDefault ? p->defaultValue() : p->getValue() );
+				}
+				case StringPlugTypeId :
+				{
+					const StringPlug *p = static_cast<const StringPlug *>( plug );
+					const std::string value = useDefault ? p->defaultValue() : p->getValue();
+					std::string result = "\"";
+					for( std::string::const_iterator it = value.begin(), eIt = value.end(); it != eIt; ++it )
+					{
+						switch( *it )
+						{
+							case '"' :
+							case '\\' :
+								result += '\\';
+								result += *it;
+								break;
+							case '\n' :
+								result += "\\n";
+								break;
+							case '\t' :
+								result += "\\t";
+								break;
+							default :
+								result += *it;
+						}
+					}
+					return result + "\"";
+				}
+				default :
+					throw IECore::Exception( string( "Unsupported plug type \"" ) + plug->typeName() + "\"" );
+			}
+		}
+
+		// Initialised by parse().
+		Program m_program;
+
+};
+
+Expression::Engine::EngineDescription<NativeExpressionEngine> NativeExpressionEngine::g_engineDescription( "native" );
+
+} // namespace
@@ -34,6 +34,8 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "Gaffer/PerformanceMonitor.h"
 #include "Gaffer/Process.h"
 #include "Gaffer/Plug.h"
@@ -46,6 +48,22 @@ static IECore::InternedString g_hashType( "computeNode:hash" );
 static IECore::InternedString g_computeType( "computeNode:compute" );
 static PerformanceMonitor::Statistics g_emptyStatistics;
 
+namespace
+{
+
+bool monitored( const Process *process )
+{
+	const IECore::InternedString type = process->type();
+	return type == g_hashType || type == g_computeType;
+}
+
+bool eventStartLess( const PerformanceMonitor::Event &lhs, const PerformanceMonitor::Event &rhs )
+{
+	return lhs.start < rhs.start;
+}
+
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 // PerformanceMonitor::Statistics
 //////////////////////////////////////////////////////////////////////////
@@ -83,8 +101,72 @@ bool PerformanceMonitor::Statistics::operator != ( const Statistics &rhs )
 // PerformanceMonitor
 //////////////////////////////////////////////////////////////////////////
 
-PerformanceMonitor::PerformanceMonitor()
+PerformanceMonitor::ThreadData::ThreadData()
+	:	blockPosition( 0 ), sampledPosition( 0 ), thread( -1 )
+{
+	std::fill( cache, cache + cacheSize, CacheEntry() );
+	durationStack.reserve( 64 );
+	// Seed each thread differently. The xorshift generator
+	// must not be seeded with zero.
+	randomState = static_cast<boost::uint32_t>( reinterpret_cast<size_t>( this ) >> 4 ) ^ 2463534242u;
+	if( !randomState )
+	{
+		randomState = 2463534242u;
+	}
+}
+
+bool PerformanceMonitor::ThreadData::sample( size_t sampleInterval )
+{
+	if( sampleInterval == 1 )
+	{
+		return true;
+	}
+
+	if( blockPosition == 0 )
+	{
+		// Start of a new block - choose which process to sample
+		// using a cheap xorshift generator. Every process has an
+		// equal chance of being sampled, so scaling the sampled
+		// durations by the interval gives an unbiased estimate,
+		// even when the processes follow a pattern whose period
+		// matches the interval.
+		randomState ^= randomState << 13;
+		randomState ^= randomState >> 17;
+		randomState ^= randomState << 5;
+		sampledPosition = randomState % sampleInterval;
+	}
+
+	const bool result = blockPosition == sampledPosition;
+	if( ++blockPosition == sampleInterval )
+	{
+		blockPosition = 0;
+	}
+	return result;
+}
+
+PerformanceMonitor::Statistics &PerformanceMonitor::ThreadData::plugStatistics( const Plug *plug )
+{
+	// Plugs are heap allocated, so the low bits of the address
+	// carry little information.
+	CacheEntry &entry = cache[( reinterpret_cast<size_t>( plug ) >> 4 ) % cacheSize];
+	if( entry.plug != plug )
+	{
+		entry.plug = plug;
+		entry.statistics = &statistics[plug];
+	}
+	return *entry.statistics;
+}
+
+void PerformanceMonitor::ThreadData::clearStatistics()
+{
+	statistics.clear();
+	std::fill( cache, cache + cacheSize, CacheEntry() );
+}
+
+PerformanceMonitor::PerformanceMonitor( bool recordEvents, size_t sampleInterval )
+	:	m_recordEvents( recordEvents ), m_sampleInterval( std::max( sampleInterval, (size_t)1 ) ), m_startTime( boost::chrono::high_resolution_clock::now() )
 {
+	m_threadCount = 0;
 }
 
 PerformanceMonitor::~PerformanceMonitor()
@@ -108,61 +190,161 @@ const PerformanceMonitor::Statistics &PerformanceMonitor::plugStatistics( const
 	return it->second;
 }
 
+bool PerformanceMonitor::getRecordEvents() const
+{
+	return m_recordEvents;
+}
+
+size_t PerformanceMonitor::getSampleInterval() const
+{
+	return m_sampleInterval;
+}
+
+const PerformanceMonitor::Events &PerformanceMonitor::events() const
+{
+	collate();
+	return m_events;
+}
+
 void PerformanceMonitor::processStarted( const Process *process )
 {
-	const IECore::InternedString type = process->type();
-	if( type != g_hashType && type != g_computeType )
+	if( !monitored( process ) )
 	{
 		return;
 	}
+	const IECore::InternedString type = process->type();
 
 	ThreadData &threadData = m_threadData.local();
 
+	Statistics &s = threadData.plugStatistics( process->plug() );
+	boost::chrono::nanoseconds *duration;
+	if( type == g_hashType )
+	{
+		s.hashCount++;
+		duration = &s.hashDuration;
+	}
+	else
+	{
+		s.computeCount++;
+		duration = &s.computeDuration;
+	}
+
+	if( !threadData.sample( m_sampleInterval ) )
+	{
+		// Not sampled. Our time is accounted for by scaling the time
+		// of the sampled processes for the same plug, so we mustn't
+		// bill it to our parent as well. If the parent is being timed
+		// we must query the clock to pause it, but otherwise we can
+		// avoid the cost entirely.
+		ThreadData::StackEntry entry = { NULL, false, false };
+		if( !threadData.durationStack.empty() && threadData.durationStack.back().duration )
+		{
+			boost::chrono::high_resolution_clock::time_point now = boost::chrono::high_resolution_clock::now();
+			*(threadData.durationStack.back().duration) += now - threadData.then;
+			entry.pausedParent = true;
+		}
+		threadData.durationStack.push_back( entry );
+		return;
+	}
+
 	boost::chrono::high_resolution_clock::time_point now = boost::chrono::high_resolution_clock::now();
-	if( !threadData.durationStack.empty() )
+	if( !threadData.durationStack.empty() && threadData.durationStack.back().duration )
 	{
-		*(threadData.durationStack.top()) += now - threadData.then;
+		*(threadData.durationStack.back().duration) += now - threadData.then;
 	}
 	threadData.then = now;
 
-	Statistics &s = threadData.statistics[process->plug()];
-	if( type == g_hashType )
+	ThreadData::StackEntry entry = { duration, true, false };
+	threadData.durationStack.push_back( entry );
+
+	if( !m_recordEvents )
 	{
-		s.hashCount++;
-		threadData.durationStack.push( &s.hashDuration );
+		return;
 	}
-	else
+
+	if( threadData.thread == (size_t)-1 )
 	{
-		s.computeCount++;
-		threadData.durationStack.push( &s.computeDuration );
+		threadData.thread = m_threadCount++;
+	}
+
+	// The immediate parent may be some other type of process
+	// that we don't record, so we search for the nearest ancestor
+	// that we do. This may be on another thread.
+	const Process *parent = process->parent();
+	while( parent && !monitored( parent ) )
+	{
+		parent = parent->parent();
 	}
+
+	Event event;
+	event.plug = process->plug();
+	event.type = type;
+	event.processId = process->id();
+	event.parentProcessId = parent ? parent->id() : 0;
+	event.thread = threadData.thread;
+	event.start = now - m_startTime;
+	threadData.pendingEvents.push_back( event );
 }
 
 void PerformanceMonitor::processFinished( const Process *process )
 {
-	const IECore::InternedString type = process->type();
-	if( type != g_hashType && type != g_computeType )
+	if( !monitored( process ) )
 	{
 		return;
 	}
 
 	ThreadData &threadData = m_threadData.local();
+	const ThreadData::StackEntry entry = threadData.durationStack.back();
+	threadData.durationStack.pop_back();
+	if( !entry.sampled )
+	{
+		if( entry.pausedParent )
+		{
+			// Resume timing the parent.
+			threadData.then = boost::chrono::high_resolution_clock::now();
+		}
+		return;
+	}
+
 	boost::chrono::high_resolution_clock::time_point now = boost::chrono::high_resolution_clock::now();
-	*(threadData.durationStack.top()) += now - threadData.then;
-	threadData.durationStack.pop();
+	*(entry.duration) += now - threadData.then;
 	threadData.then = now;
+
+	if( m_recordEvents && !threadData.pendingEvents.empty() )
+	{
+		threadData.events.push_back( threadData.pendingEvents.back() );
+		threadData.pendingEvents.pop_back();
+		threadData.events.back().end = now - m_startTime;
+	}
 }
 
 void PerformanceMonitor::collate() const
 {
+	const size_t numCollatedEvents = m_events.size();
+
 	tbb::enumerable_thread_specific<ThreadData, tbb::cache_aligned_allocator<ThreadData>, tbb::ets_key_per_instance>::iterator it, eIt;
 	for( it = m_threadData.begin(), eIt = m_threadData.end(); it != eIt; ++it )
 	{
-		StatisticsMap &m = it->statistics;
+		const StatisticsMap &m = it->statistics;
 		for( StatisticsMap::const_iterator mIt = m.begin(), meIt = m.end(); mIt != meIt; ++mIt )
 		{
-			m_statistics[mIt->first] += mIt->second;
+			Statistics s = mIt->second;
+			s.hashDuration *= m_sampleInterval;
+			s.computeDuration *= m_sampleInterval;
+			m_statistics[mIt->first] += s;
 		}
-		m.clear();
+		it->clearStatistics();
+
+		m_events.insert( m_events.end(), it->events.begin(), it->events.end() );
+		it->events.clear();
+	}
+
+	if( m_events.size() != numCollatedEvents )
+	{
+		// Events are recorded per thread in order of completion,
+		// so must be sorted before merging with the previously
+		// collated events.
+		std::sort( m_events.begin() + numCollatedEvents, m_events.end(), eventStartLess );
+		std::inplace_merge( m_events.begin(), m_events.begin() + numCollatedEvents, m_events.end(), eventStartLess );
 	}
 }
@@ -791,7 +791,7 @@ class Plug::DirtyPlugs
 		typedef boost::adjacency_list<vecS, vecS, directedS, PlugPtr> Graph;
 		typedef Graph::vertex_descriptor VertexDescriptor;
 
-		typedef std::map<const Plug *, VertexDescriptor> PlugMap;
+		typedef boost::unordered_map<const Plug *, VertexDescriptor> PlugMap;
 
 		// Equivalent to the return type for map::insert - the first
 		// field is the vertex descriptor, and the second field is
@@ -866,32 +866,92 @@ class Plug::DirtyPlugs
 
 			ScopedAssignment<bool> scopedAssignment( m_emitting, true );
 
-			std::vector<VertexDescriptor> sorted;
+			m_sorted.clear();
 			try
 			{
-				topological_sort( m_graph, std::back_inserter( sorted ) );
+				topological_sort( m_graph, std::back_inserter( m_sorted ) );
 			}
 			catch( const std::exception &e )
 			{
 				IECore::msg( IECore::Msg::Error, "Plug dirty propagation", e.what() );
 			}
 
-			for( std::vector<VertexDescriptor>::const_iterator it = sorted.begin(), eIt = sorted.end(); it != eIt; ++it )
+			for( std::vector<VertexDescriptor>::const_iterator it = m_sorted.begin(), eIt = m_sorted.end(); it != eIt; ++it )
 			{
 				Plug *plug = m_graph[*it].get();
 				plug->dirty();
 				if( Node *node = plug->node() )
 				{
-					node->plugDirtiedSignal()( plug );
+					// Emission has a significant cost even when nothing
+					// is connected, and most nodes have no observers
+					// outside of the UI, so we skip it where we can.
+					Node::UnaryPlugSignal &signal = node->plugDirtiedSignal();
+					if( !signal.empty() )
+					{
+						signal( plug );
+					}
+					if( !node->plugsDirtiedSignal().empty() && node->refCount() )
+					{
+						batch( node, plug );
+					}
 				}
 			}
 
+			emitBatched();
+
 			m_graph.clear();
 			m_plugs.clear();
 		}
 
+		// Adds a plug to the batch for its node, starting a new batch
+		// if the node doesn't have one yet.
+		void batch( Node *node, Plug *plug )
+		{
+			std::pair<BatchIndices::iterator, bool> inserted = m_batchIndices.insert(
+				BatchIndices::value_type( node, m_batches.size() )
+			);
+			if( inserted.second )
+			{
+				m_batches.push_back( Batch() );
+				m_batches.back().node = node;
+			}
+			m_batches[inserted.first->second].plugs.push_back( plug );
+		}
+
+		// Emits plugsDirtiedSignal() once for each node, with all its
+		// plugs in the order they were signalled above. Nodes are signalled
+		// in the order in which they were first dirtied, which preserves
+		// the upstream-first ordering of plugDirtiedSignal(). We hold a
+		// reference to each node, because a slot may cause another node to
+		// be deleted before we reach it. The plugs themselves are kept
+		// alive by m_graph.
+		void emitBatched()
+		{
+			for( std::vector<Batch>::const_iterator it = m_batches.begin(), eIt = m_batches.end(); it != eIt; ++it )
+			{
+				it->node->plugsDirtiedSignal()( it->plugs );
+			}
+
+			m_batches.clear();
+			m_batchIndices.clear();
+		}
+
+		struct Batch
+		{
+			NodePtr node;
+			std::vector<Plug *> plugs;
+		};
+
+		// Maps from node to its index in m_batches.
+		typedef boost::unordered_map<const Node *, size_t> BatchIndices;
+
 		Graph m_graph;
 		PlugMap m_plugs;
+		// These are members rather than locals only so that their
+		// storage can be reused from one emission to the next.
+		std::vector<VertexDescriptor> m_sorted;
+		std::vector<Batch> m_batches;
+		BatchIndices m_batchIndices;
 		size_t m_scopeCount;
 		bool m_emitting;
 
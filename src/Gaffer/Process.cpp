@@ -36,12 +36,15 @@
 
 #include <stack>
 
+#include "tbb/atomic.h"
+
 #include "boost/container/flat_set.hpp"
 
 #include "Gaffer/Process.h"
 #include "Gaffer/Plug.h"
 #include "Gaffer/Node.h"
 #include "Gaffer/Monitor.h"
+#include "Gaffer/Canceller.h"
 
 using namespace Gaffer;
 
@@ -51,6 +54,8 @@ namespace
 typedef boost::container::flat_set<Monitor *> Monitors;
 Monitors g_activeMonitors;
 
+tbb::atomic<size_t> g_processCount;
+
 } // namespace
 
 struct Process::ThreadData
@@ -66,7 +71,7 @@ struct Process::ThreadData
 tbb::enumerable_thread_specific<Process::ThreadData, tbb::cache_aligned_allocator<Process::ThreadData>, tbb::ets_key_per_instance> Process::g_threadData;
 
 Process::Process( const IECore::InternedString &type, const Plug *plug, const Plug *downstream )
-	:	m_type( type ), m_plug( plug ), m_downstream( downstream ? downstream : plug ), m_threadData( &g_threadData.local() )
+	:	m_type( type ), m_plug( plug ), m_downstream( downstream ? downstream : plug ), m_id( ++g_processCount ), m_threadData( &g_threadData.local() )
 {
 	ThreadData::Stack &stack = m_threadData->stack;
 	m_parent = stack.size() ? stack.top() : NULL;
@@ -85,8 +90,9 @@ Process::~Process()
 		(*it)->processFinished( this );
 	}
 
-	m_threadData->stack.pop();
-	if( m_threadData->stack.empty() )
+	ThreadData::Stack &stack = m_threadData->stack;
+	stack.pop();
+	if( stack.empty() || !stack.top() )
 	{
 		m_threadData->errorSource = NULL;
 	}
@@ -98,6 +104,25 @@ const Process *Process::current()
 	return stack.size() ? stack.top() : NULL;
 }
 
+Process::Scope::Scope( const Process *process )
+{
+	// We push NULL processes as well, so that they hide any
+	// process already running on this thread. This is necessary
+	// when the thread is running an unrelated task while it
+	// waits for its own work to complete.
+	ThreadData &threadData = g_threadData.local();
+	threadData.stack.push( process );
+	m_previousErrorSource = threadData.errorSource;
+	threadData.errorSource = NULL;
+}
+
+Process::Scope::~Scope()
+{
+	ThreadData &threadData = g_threadData.local();
+	threadData.stack.pop();
+	threadData.errorSource = m_previousErrorSource;
+}
+
 void Process::handleException()
 {
 	try
@@ -106,6 +131,12 @@ void Process::handleException()
 		// so we can examine it.
 		throw;
 	}
+	catch( const Cancelled &e )
+	{
+		// Cancellation isn't an error, so we
+		// just let it propagate.
+		throw;
+	}
 	catch( const std::exception &e )
 	{
 		if( !m_threadData->errorSource )
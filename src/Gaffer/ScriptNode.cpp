@@ -55,6 +55,7 @@
 #include "Gaffer/DependencyNode.h"
 #include "Gaffer/CompoundDataPlug.h"
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/ThreadBudget.h"
 
 using namespace Gaffer;
 
@@ -732,6 +733,21 @@ const Context *ScriptNode::context() const
 	return m_context.get();
 }
 
+void ScriptNode::setThreadBudget( ThreadBudgetPtr threadBudget )
+{
+	m_threadBudget = threadBudget;
+}
+
+ThreadBudget *ScriptNode::getThreadBudget()
+{
+	return m_threadBudget.get();
+}
+
+const ThreadBudget *ScriptNode::getThreadBudget() const
+{
+	return m_threadBudget.get();
+}
+
 void ScriptNode::plugSet( Plug *plug )
 {
 	if( plug == frameStartPlug() )
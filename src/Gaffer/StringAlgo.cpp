@@ -45,6 +45,83 @@ namespace Gaffer
 namespace StringAlgo
 {
 
+//////////////////////////////////////////////////////////////////////////
+// CompiledMatchPattern
+//////////////////////////////////////////////////////////////////////////
+
+CompiledMatchPattern::CompiledMatchPattern()
+{
+}
+
+CompiledMatchPattern::CompiledMatchPattern( const MatchPattern &pattern, bool multiple )
+{
+	const char *begin = pattern.c_str();
+	const char *end = begin + pattern.size();
+	if( !multiple )
+	{
+		addPattern( begin, end );
+		return;
+	}
+
+	while( true )
+	{
+		const char *separator = std::find( begin, end, ' ' );
+		addPattern( begin, separator );
+		if( separator == end )
+		{
+			break;
+		}
+		begin = separator + 1;
+	}
+}
+
+CompiledMatchPattern::CompiledMatchPattern( const std::vector<MatchPattern> &patterns )
+{
+	for( std::vector<MatchPattern>::const_iterator it = patterns.begin(), eIt = patterns.end(); it != eIt; ++it )
+	{
+		addPattern( it->c_str(), it->c_str() + it->size() );
+	}
+}
+
+void CompiledMatchPattern::addPattern( const char *begin, const char *end )
+{
+	Pattern pattern;
+
+	const char *firstWildcard = std::find( begin, end, '*' );
+	pattern.wildcard = firstWildcard != end;
+	pattern.prefix.assign( begin, firstWildcard );
+	pattern.minLength = pattern.prefix.size();
+
+	if( pattern.wildcard )
+	{
+		const char *lastWildcard = end - 1;
+		while( *lastWildcard != '*' )
+		{
+			--lastWildcard;
+		}
+		pattern.suffix.assign( lastWildcard + 1, end );
+		pattern.minLength += pattern.suffix.size();
+
+		const char *infixBegin = firstWildcard + 1;
+		while( infixBegin < lastWildcard )
+		{
+			const char *infixEnd = std::find( infixBegin, lastWildcard, '*' );
+			if( infixEnd != infixBegin )
+			{
+				pattern.infixes.push_back( std::string( infixBegin, infixEnd ) );
+				pattern.minLength += pattern.infixes.back().size();
+			}
+			infixBegin = infixEnd + 1;
+		}
+	}
+
+	m_patterns.push_back( pattern );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// numericSuffix
+//////////////////////////////////////////////////////////////////////////
+
 int numericSuffix( const std::string &s, std::string *stem )
 {
 	static boost::regex g_regex( "^(.*[^0-9]+)([0-9]+)$" );
@@ -35,11 +35,33 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <ctime>
+#include <cstdlib>
+#include <algorithm>
+#include <iterator>
+#include <typeinfo>
+
 #include "tbb/enumerable_thread_specific.h"
+#include "tbb/atomic.h"
+#include "tbb/concurrent_hash_map.h"
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
+#include "tbb/tbb_exception.h"
+#include "tbb/spin_mutex.h"
 
 #include "boost/bind.hpp"
 #include "boost/format.hpp"
+#include "boost/functional/hash.hpp"
+#include "boost/shared_ptr.hpp"
+#include "boost/filesystem.hpp"
 #include "boost/unordered_map.hpp"
+#include "boost/unordered_set.hpp"
+
+#include "IECore/CompoundObject.h"
+#include "IECore/CompoundData.h"
+#include "IECore/Primitive.h"
+#include "IECore/DespatchTypedData.h"
+#include "IECore/FileIndexedIO.h"
 
 #include "Gaffer/Private/IECorePreview/LRUCache.h"
 
@@ -48,6 +70,9 @@
 #include "Gaffer/Context.h"
 #include "Gaffer/Action.h"
 #include "Gaffer/Process.h"
+#include "Gaffer/ScriptNode.h"
+#include "Gaffer/DirtyPropagationScope.h"
+#include "Gaffer/DownstreamIterator.h"
 
 using namespace Gaffer;
 
@@ -77,6 +102,557 @@ inline const ValuePlug *sourcePlug( const ValuePlug *p )
 	return p;
 }
 
+// Key used to index into the hash cache. We include the dirty count
+// of the plug so that we never need to clear the cache when plugs are
+// dirtied - stale entries simply become unreachable, and are evicted
+// in due course by the LRU policy.
+struct HashCacheKey
+{
+
+	HashCacheKey()
+		:	plug( NULL ), dirtyCount( 0 )
+	{
+	}
+
+	HashCacheKey( const ValuePlug *plug, size_t dirtyCount, const IECore::MurmurHash &contextHash )
+		:	plug( plug ), dirtyCount( dirtyCount ), contextHash( contextHash )
+	{
+	}
+
+	bool operator == ( const HashCacheKey &other ) const
+	{
+		return
+			plug == other.plug &&
+			dirtyCount == other.dirtyCount &&
+			contextHash == other.contextHash
+		;
+	}
+
+	const ValuePlug *plug;
+	size_t dirtyCount;
+	IECore::MurmurHash contextHash;
+
+};
+
+size_t hash_value( const HashCacheKey &key )
+{
+	size_t result = 0;
+	boost::hash_combine( result, key.plug );
+	boost::hash_combine( result, key.dirtyCount );
+	boost::hash_combine( result, key.contextHash );
+	return result;
+}
+
+// The context variables a hash has been found to depend on. Instances
+// are interned, so they may be compared by address and referenced
+// from hash cache keys without the overhead of copying the names.
+struct ContextDependencies
+{
+
+	ContextDependencies()
+		:	all( false )
+	{
+	}
+
+	// If true, the hash depends on all variables
+	// and `names` is empty.
+	bool all;
+	// Sorted.
+	std::vector<IECore::InternedString> names;
+
+	bool operator == ( const ContextDependencies &other ) const
+	{
+		return all == other.all && names == other.names;
+	}
+
+	// Returns true if every variable we depend on is also
+	// depended on by `other`.
+	bool isSubsetOf( const ContextDependencies &other ) const
+	{
+		return other.all || ( !all && std::includes( other.names.begin(), other.names.end(), names.begin(), names.end() ) );
+	}
+
+};
+
+struct ContextDependenciesHashCompare
+{
+
+	size_t hash( const ContextDependencies &d ) const
+	{
+		size_t result = d.all;
+		for( std::vector<IECore::InternedString>::const_iterator it = d.names.begin(), eIt = d.names.end(); it != eIt; ++it )
+		{
+			boost::hash_combine( result, it->c_str() );
+		}
+		return result;
+	}
+
+	bool equal( const ContextDependencies &a, const ContextDependencies &b ) const
+	{
+		return a == b;
+	}
+
+};
+
+// Distinct sets of dependencies are few in number, so interned instances
+// are never freed. Elements of a concurrent_hash_map have stable addresses
+// for as long as they are not erased.
+typedef tbb::concurrent_hash_map<ContextDependencies, bool, ContextDependenciesHashCompare> InternedContextDependencies;
+InternedContextDependencies g_internedContextDependencies;
+
+const ContextDependencies *internContextDependencies( const ContextDependencies &dependencies )
+{
+	InternedContextDependencies::const_accessor accessor;
+	g_internedContextDependencies.insert( accessor, dependencies );
+	return &accessor->first;
+}
+
+// Source for ValuePlug::m_dirtyCount. Dirty counts are drawn from a
+// single global counter rather than being incremented per plug, so that
+// a new plug which happens to reuse the address of a deleted one can
+// never be confused with it by the hash cache.
+tbb::atomic<size_t> g_dirtyCount;
+
+size_t newDirtyCount()
+{
+	return ++g_dirtyCount;
+}
+
+// Objects stored in the compute cache frequently share their underlying
+// data. For instance, a ShaderAssignment passes through the input attributes
+// in a new CompoundObject, and a PrimitiveVariables node copies the input
+// primitive, sharing the primitive variable data via copy-on-write. Using
+// Object::memoryUsage() as the cost for each cache entry would count such
+// shared data many times over, so instead we decompose each object into
+// its constituent buffers and account for the memory of each buffer once.
+// A buffer is charged to the first cache entry to reference it. If that
+// entry is removed while other entries still reference the buffer, the
+// buffer becomes "orphaned", and is accounted for separately until another
+// entry adopts it or the last reference is removed.
+
+struct Buffer
+{
+	Buffer( const void *address, size_t size )
+		:	address( address ), size( size ), charged( false )
+	{
+	}
+
+	const void *address;
+	size_t size;
+	// True if this entry is the one being charged for the buffer.
+	bool charged;
+};
+
+typedef std::vector<Buffer> Buffers;
+
+struct BufferAddress
+{
+	typedef const void *ReturnType;
+
+	template<typename T>
+	const void *operator()( T *data )
+	{
+		return &data->readable();
+	}
+};
+
+// Returns the address of the buffer holding the data, which is shared
+// between copies of the data object itself.
+const void *bufferAddress( const IECore::Data *data )
+{
+	try
+	{
+		return IECore::despatchTypedData<BufferAddress, IECore::TypeTraits::IsTypedData>( const_cast<IECore::Data *>( data ) );
+	}
+	catch( const IECore::Exception & )
+	{
+		// A type unknown to despatchTypedData(). We fall
+		// back to treating the object itself as the buffer.
+		return data;
+	}
+}
+
+// Appends the buffers for the leaf data of the object, returning their
+// total size. Object::memoryUsage() is itself recursive, so we only call
+// it on the leaves, to keep the cost linear in the size of the object.
+size_t accumulateLeafBuffers( const IECore::Object *object, Buffers &buffers )
+{
+	size_t result = 0;
+	if( const IECore::CompoundObject *compoundObject = IECore::runTimeCast<const IECore::CompoundObject>( object ) )
+	{
+		for( IECore::CompoundObject::ObjectMap::const_iterator it = compoundObject->members().begin(), eIt = compoundObject->members().end(); it != eIt; ++it )
+		{
+			result += accumulateLeafBuffers( it->second.get(), buffers );
+		}
+	}
+	else if( const IECore::CompoundData *compoundData = IECore::runTimeCast<const IECore::CompoundData>( object ) )
+	{
+		for( IECore::CompoundDataMap::const_iterator it = compoundData->readable().begin(), eIt = compoundData->readable().end(); it != eIt; ++it )
+		{
+			result += accumulateLeafBuffers( it->second.get(), buffers );
+		}
+	}
+	else if( const IECore::Primitive *primitive = IECore::runTimeCast<const IECore::Primitive>( object ) )
+	{
+		for( IECore::PrimitiveVariableMap::const_iterator it = primitive->variables.begin(), eIt = primitive->variables.end(); it != eIt; ++it )
+		{
+			if( it->second.data )
+			{
+				result += accumulateLeafBuffers( it->second.data.get(), buffers );
+			}
+		}
+	}
+	else if( const IECore::Data *data = IECore::runTimeCast<const IECore::Data>( object ) )
+	{
+		const size_t memoryUsage = data->memoryUsage();
+		buffers.push_back( Buffer( bufferAddress( data ), memoryUsage ) );
+		result += memoryUsage;
+	}
+	return result;
+}
+
+// Appends the buffers used by the object.
+void accumulateBuffers( const IECore::Object *object, Buffers &buffers )
+{
+	if( IECore::runTimeCast<const IECore::Data>( object ) && !IECore::runTimeCast<const IECore::CompoundData>( object ) )
+	{
+		// The object is a single buffer.
+		accumulateLeafBuffers( object, buffers );
+		return;
+	}
+
+	const size_t leafMemoryUsage = accumulateLeafBuffers( object, buffers );
+
+	// Whatever isn't accounted for by the leaves belongs to the structure
+	// of the object itself, which we charge as a buffer of its own. Note
+	// that the sum for the leaves may exceed the total when the same leaf
+	// is referenced more than once.
+	const size_t memoryUsage = object->memoryUsage();
+	if( memoryUsage > leafMemoryUsage )
+	{
+		buffers.push_back( Buffer( object, memoryUsage - leafMemoryUsage ) );
+	}
+}
+
+struct BufferUsage
+{
+	// Number of cache entries referencing the buffer.
+	size_t references;
+	// The size the buffer was charged at.
+	size_t size;
+	// False if the buffer is orphaned.
+	bool charged;
+};
+
+typedef tbb::concurrent_hash_map<const void *, BufferUsage> BufferUsages;
+BufferUsages g_bufferUsages;
+
+// Total size of the orphaned buffers.
+tbb::atomic<size_t> g_orphanedBufferMemory;
+
+// Adds a reference to each buffer, returning the memory used by the
+// buffers which are now charged to the new entry. This includes any
+// orphaned buffers, which are adopted by the entry.
+size_t addBufferReferences( Buffers &buffers )
+{
+	size_t result = 0;
+	for( Buffers::iterator it = buffers.begin(), eIt = buffers.end(); it != eIt; ++it )
+	{
+		BufferUsages::accessor accessor;
+		if( g_bufferUsages.insert( accessor, it->address ) )
+		{
+			accessor->second.references = 1;
+			accessor->second.size = it->size;
+			accessor->second.charged = true;
+			it->charged = true;
+			result += it->size;
+		}
+		else
+		{
+			accessor->second.references++;
+			if( !accessor->second.charged )
+			{
+				g_orphanedBufferMemory -= accessor->second.size;
+				accessor->second.size = it->size;
+				accessor->second.charged = true;
+				it->charged = true;
+				result += it->size;
+			}
+		}
+	}
+	return result;
+}
+
+// Removes the entry's reference to each buffer, orphaning any buffers
+// which were charged to it and are still referenced by other entries.
+void removeBufferReferences( const Buffers &buffers )
+{
+	for( Buffers::const_iterator it = buffers.begin(), eIt = buffers.end(); it != eIt; ++it )
+	{
+		BufferUsages::accessor accessor;
+		if( !g_bufferUsages.find( accessor, it->address ) )
+		{
+			continue;
+		}
+
+		if( --accessor->second.references == 0 )
+		{
+			if( !accessor->second.charged )
+			{
+				g_orphanedBufferMemory -= accessor->second.size;
+			}
+			g_bufferUsages.erase( accessor );
+		}
+		else if( it->charged )
+		{
+			accessor->second.charged = false;
+			g_orphanedBufferMemory += accessor->second.size;
+		}
+	}
+}
+
+// A second-level cache for computed values, stored as files in a directory
+// on disk, so that values can be reused by other processes. Each value is
+// stored in its own file, named according to its hash. Files are written to
+// a temporary location and then renamed into place, so that concurrent
+// readers in other processes never see a partially written file. The total
+// size is bounded by removing the least recently used files, with the
+// modification time being updated on each read to provide the ordering.
+// All IO errors are ignored, since the worst consequence is that we must
+// compute the value again.
+class PersistentCache : boost::noncopyable
+{
+
+	public :
+
+		PersistentCache()
+			:	m_sizeLimit( 1024 * 1024 * 1024 * size_t( 10 ) ) // 10 gig
+		{
+			m_enabled = false;
+			m_size = 0;
+			m_sizeValid = false;
+			if( const char *d = getenv( "GAFFER_PERSISTENT_CACHE_DIRECTORY" ) )
+			{
+				setDirectory( d );
+			}
+		}
+
+		bool enabled() const
+		{
+			return m_enabled;
+		}
+
+		std::string getDirectory() const
+		{
+			tbb::spin_mutex::scoped_lock lock( m_directoryMutex );
+			return m_directory.string();
+		}
+
+		void setDirectory( const std::string &directory )
+		{
+			tbb::spin_mutex::scoped_lock lock( m_directoryMutex );
+			m_directory = directory;
+			m_enabled = !directory.empty();
+			m_sizeValid = false;
+		}
+
+		size_t getSizeLimit() const
+		{
+			return m_sizeLimit;
+		}
+
+		void setSizeLimit( size_t bytes )
+		{
+			m_sizeLimit = bytes;
+			limitSize();
+		}
+
+		IECore::ConstObjectPtr get( const IECore::MurmurHash &hash ) const
+		{
+			const boost::filesystem::path path = fileName( hash );
+
+			boost::system::error_code ec;
+			if( !boost::filesystem::exists( path, ec ) )
+			{
+				return NULL;
+			}
+
+			try
+			{
+				IECore::ConstIndexedIOPtr io = new IECore::FileIndexedIO( path.string(), IECore::IndexedIO::rootPath, IECore::IndexedIO::Read );
+				IECore::ConstObjectPtr result = IECore::Object::load( io, "value" );
+				boost::filesystem::last_write_time( path, std::time( NULL ), ec );
+				return result;
+			}
+			catch( ... )
+			{
+				// Most likely a file truncated by a process which
+				// ran out of disk space. Remove it so that it can
+				// be written again.
+				boost::filesystem::remove( path, ec );
+				return NULL;
+			}
+		}
+
+		void set( const IECore::MurmurHash &hash, const IECore::Object *value )
+		{
+			const boost::filesystem::path path = fileName( hash );
+
+			boost::system::error_code ec;
+			if( boost::filesystem::exists( path, ec ) )
+			{
+				// Another process beat us to it.
+				return;
+			}
+
+			boost::filesystem::create_directories( path.parent_path(), ec );
+			const boost::filesystem::path tmpPath = path.parent_path() / boost::filesystem::unique_path( "%%%%-%%%%-%%%%-%%%%.tmp" );
+			try
+			{
+				{
+					IECore::IndexedIOPtr io = new IECore::FileIndexedIO( tmpPath.string(), IECore::IndexedIO::rootPath, IECore::IndexedIO::Write );
+					value->save( io, "value" );
+				}
+				boost::filesystem::rename( tmpPath, path );
+				m_size += boost::filesystem::file_size( path );
+			}
+			catch( ... )
+			{
+				boost::filesystem::remove( tmpPath, ec );
+				return;
+			}
+
+			if( !m_sizeValid || m_size > m_sizeLimit )
+			{
+				limitSize();
+			}
+		}
+
+		void clear()
+		{
+			tbb::spin_mutex::scoped_lock lock( m_limitSizeMutex );
+
+			Files files;
+			scan( files );
+			boost::system::error_code ec;
+			for( Files::const_iterator it = files.begin(), eIt = files.end(); it != eIt; ++it )
+			{
+				boost::filesystem::remove( it->path, ec );
+			}
+			m_size = 0;
+			m_sizeValid = true;
+		}
+
+	private :
+
+		boost::filesystem::path fileName( const IECore::MurmurHash &hash ) const
+		{
+			// We use the first two characters of the hash to choose a
+			// subdirectory, to avoid having a single enormous directory.
+			const std::string h = hash.toString();
+			tbb::spin_mutex::scoped_lock lock( m_directoryMutex );
+			return m_directory / h.substr( 0, 2 ) / ( h.substr( 2 ) + ".fio" );
+		}
+
+		struct File
+		{
+			boost::filesystem::path path;
+			std::time_t time;
+			size_t size;
+
+			bool operator < ( const File &other ) const
+			{
+				return time < other.time;
+			}
+		};
+
+		typedef std::vector<File> Files;
+
+		// Finds all cache files, ignoring anything else which might
+		// have been put in the directory.
+		void scan( Files &files ) const
+		{
+			const boost::filesystem::path directory( getDirectory() );
+			if( directory.empty() )
+			{
+				return;
+			}
+
+			boost::system::error_code ec;
+			for( boost::filesystem::recursive_directory_iterator it( directory, ec ), eIt; it != eIt; it.increment( ec ) )
+			{
+				if( ec )
+				{
+					break;
+				}
+				if( it->path().extension() != ".fio" || !boost::filesystem::is_regular_file( it->status() ) )
+				{
+					continue;
+				}
+				File file;
+				file.path = it->path();
+				file.time = boost::filesystem::last_write_time( file.path, ec );
+				file.size = boost::filesystem::file_size( file.path, ec );
+				if( !ec )
+				{
+					files.push_back( file );
+				}
+			}
+		}
+
+		void limitSize()
+		{
+			tbb::spin_mutex::scoped_lock lock;
+			if( !lock.try_acquire( m_limitSizeMutex ) )
+			{
+				// Another thread is already doing the work.
+				return;
+			}
+
+			// Other processes may have been adding and removing files, so
+			// we rescan the directory to get an accurate size.
+			Files files;
+			scan( files );
+			size_t size = 0;
+			for( Files::const_iterator it = files.begin(), eIt = files.end(); it != eIt; ++it )
+			{
+				size += it->size;
+			}
+
+			if( size > m_sizeLimit )
+			{
+				// Remove the least recently used files until we're comfortably
+				// within the limit, so that we don't need to rescan again for
+				// every subsequent write.
+				const size_t targetSize = m_sizeLimit - m_sizeLimit / 10;
+				std::sort( files.begin(), files.end() );
+				boost::system::error_code ec;
+				for( Files::const_iterator it = files.begin(), eIt = files.end(); it != eIt && size > targetSize; ++it )
+				{
+					if( boost::filesystem::remove( it->path, ec ) )
+					{
+						size -= it->size;
+					}
+				}
+			}
+
+			m_size = size;
+			m_sizeValid = true;
+		}
+
+		boost::filesystem::path m_directory;
+		mutable tbb::spin_mutex m_directoryMutex;
+		tbb::atomic<bool> m_enabled;
+
+		size_t m_sizeLimit;
+		tbb::atomic<size_t> m_size;
+		tbb::atomic<bool> m_sizeValid;
+		tbb::spin_mutex m_limitSizeMutex;
+
+};
+
+PersistentCache g_persistentCache;
+
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -118,60 +694,165 @@ class ValuePlug::HashProcess : public Process
 			// one per context, computed by ComputeNode::hash(). First we see if we can retrieve the hash
 			// from our cache, and if we can't we'll compute it using a HashProcess instance.
 
-			ThreadData &threadData = g_threadData.local();
-			if( !Process::current() )
-			{
-				// Starting a new root computation.
-				if( ++(threadData.cacheClearCount) == 3200 )
-				{
-					// Prevent unbounded growth in the hash cache
-					// if many computations are being performed
-					// without any plugs being dirtied in between,
-					// by clearing it after every Nth computation.
-					// N == 3200 was observed to be 6x faster than
-					// N == 100 for a procedural instancing scene at
-					// a memory cost of about 100 mb.
-					threadData.clearCache = 1;
-				}
-			}
-
-			if( threadData.clearCache )
+			if( cachePolicy( p ) == Uncached )
 			{
-				threadData.cache.clear();
-				threadData.cacheClearCount = 0;
-				threadData.clearCache = 0;
+				return HashProcess( p, plug ).m_result;
 			}
 
-			const CacheKey key( p, Context::current()->hash() );
-			Cache::iterator it = threadData.cache.find( key );
-			if( it != threadData.cache.end() )
+			Statistics &statistics = g_statistics.local();
+			const Context *context = Context::current();
+
+			// Look up the context variables the plug has been found to depend
+			// on, and if there are any, look for a hash computed in a context
+			// with the same values for them. Variables which aren't depended
+			// on don't contribute to the key, so for instance a hash which
+			// doesn't depend on "frame" is shared by all frames. Looking up
+			// the key also records the dependencies with any AccessRecorder
+			// used by a downstream hash.
+			const HashCacheKey dependenciesKey( p, p->m_dirtyCount, IECore::MurmurHash() );
+			const ContextDependencies *dependencies = g_dependenciesCache.get( dependenciesKey );
+			HashCacheKey placeholderKey;
+			if( dependencies )
 			{
-				return it->second;
+				const HashCacheKey key( p, p->m_dirtyCount, contextHash( context, dependencies ) );
+				IECore::MurmurHash result = g_cache.get( key );
+				if( result != IECore::MurmurHash() )
+				{
+					statistics.hits++;
+					return result;
+				}
+				placeholderKey = key;
 			}
 
-			HashProcess process( p, plug );
-			threadData.cache[key] = process.m_result;
-			return process.m_result;
-		}
+			statistics.misses++;
 
-		static void clearCache()
-		{
-			// The docs for enumerable_thread_specific aren't particularly clear
-			// on whether or not it's ok to iterate an e_t_s while concurrently using
-			// local(), which is what we do here. So far in practice it seems to be
-			// OK.
-			tbb::enumerable_thread_specific<ThreadData>::iterator it, eIt;
-			for( it = g_threadData.begin(), eIt = g_threadData.end(); it != eIt; ++it )
+			// Compute the hash, recording the variables it depends on. The
+			// variables read may differ from one context to the next, so we
+			// accumulate them with those recorded previously. The key is
+			// valid for any context which matches on a superset of the variables
+			// actually read, so it doesn't matter if another thread updates
+			// the dependencies concurrently - at worst we lose some hits.
+			ContextDependencies recorded;
+			IECore::MurmurHash result;
+			try
 			{
-				// We can't clear the cache now, because it is most likely
-				// in use by the owning thread. Instead we set this flag to
-				// politely request that the thread clears the cache itself
-				// at its earliest convenience - in the HashProcess constructor.
-				// This delay in clearing is OK, because it is illegal to modify
-				// a graph while a computation is being performed with it, and
-				// we know that the plug requesting the clear will be removed
-				// from the cache before the next computation starts.
-				it->clearCache = 1;
+				Context::AccessRecorder recorder;
+				result = HashProcess( p, plug ).m_result;
+				recorded.all = recorder.all();
+				if( !recorded.all )
+				{
+					recorded.names.assign( recorder.names().begin(), recorder.names().end() );
+				}
+			}
+			catch( ... )
+			{
+				// The lookups above left zero-cost placeholders in the
+				// caches, which would never be evicted if we didn't
+				// remove them.
+				if( placeholderKey.plug )
+				{
+					g_cache.erase( placeholderKey );
+				}
+				if( !dependencies )
+				{
+					g_dependenciesCache.erase( dependenciesKey );
+				}
+				throw;
+			}
+
+			if( !dependencies || !recorded.isSubsetOf( *dependencies ) )
+			{
+				if( dependencies && !recorded.all )
+				{
+					if( dependencies->all )
+					{
+						recorded.all = true;
+						recorded.names.clear();
+					}
+					else
+					{
+						std::vector<IECore::InternedString> names;
+						std::set_union(
+							dependencies->names.begin(), dependencies->names.end(),
+							recorded.names.begin(), recorded.names.end(),
+							std::back_inserter( names )
+						);
+						recorded.names.swap( names );
+					}
+				}
+				dependencies = internContextDependencies( recorded );
+				g_dependenciesCache.set( dependenciesKey, dependencies, 1 );
+			}
+
+			const HashCacheKey key( p, p->m_dirtyCount, contextHash( context, dependencies ) );
+			g_cache.set( key, result, 1 );
+			if( placeholderKey.plug && !( placeholderKey == key ) )
+			{
+				// The dependencies changed, so the placeholder won't
+				// be replaced by the result.
+				g_cache.erase( placeholderKey );
+			}
+			return result;
+		}
+
+		// Returns the cache policy for a plug which has been returned
+		// by sourcePlug(), and which is not a static value.
+		static CachePolicy cachePolicy( const ValuePlug *p )
+		{
+			if( !p->getInput<ValuePlug>() )
+			{
+				if( const ComputeNode *n = p->ancestor<ComputeNode>() )
+				{
+					return n->computeCachePolicy( p );
+				}
+			}
+			// A conversion from an input of a different type. There's
+			// no node involved, so we just use the flags.
+			return p->getFlags( Plug::Cacheable ) ? Standard : HashOnly;
+		}
+
+		static size_t getCacheSizeLimit()
+		{
+			return g_cache.getMaxCost();
+		}
+
+		static void setCacheSizeLimit( size_t maxEntries )
+		{
+			g_cache.setMaxCost( maxEntries );
+			g_dependenciesCache.setMaxCost( maxEntries );
+		}
+
+		static size_t cacheSize()
+		{
+			return g_cache.currentCost();
+		}
+
+		static void clearCache()
+		{
+			g_cache.clear();
+			g_dependenciesCache.clear();
+		}
+
+		static HashCacheStatistics cacheStatistics()
+		{
+			HashCacheStatistics result;
+			for( StatisticsContainer::const_iterator it = g_statistics.begin(), eIt = g_statistics.end(); it != eIt; ++it )
+			{
+				result.hits += it->hits;
+				result.misses += it->misses;
+				result.evictions += it->evictions;
+			}
+			return result;
+		}
+
+		static void resetCacheStatistics()
+		{
+			// As for the ComputeProcess cache, it is only valid to call this
+			// while no computations are being performed, so we are free to
+			// modify the statistics for all threads.
+			for( StatisticsContainer::iterator it = g_statistics.begin(), eIt = g_statistics.end(); it != eIt; ++it )
+			{
+				*it = Statistics();
 			}
 		}
 
@@ -190,275 +871,1059 @@ class ValuePlug::HashProcess : public Process
 					throw IECore::Exception( boost::str( boost::format( "Unable to compute hash for Plug \"%s\" as it has no ComputeNode." ) % plug->fullName() ) );
 				}
 
-				n->hash( plug, Context::current(), m_result );
+				const Context *context = Context::current();
+				Canceller::check( context->canceller() );
+				n->hash( plug, context, m_result );
+
+				if( m_result == IECore::MurmurHash() )
+				{
+					throw IECore::Exception( boost::str( boost::format( "ComputeNode::hash() not implemented for Plug \"%s\"." ) % plug->fullName() ) );
+				}
+			}
+			catch( ... )
+			{
+				handleException();
+			}
+		}
+
+		static IECore::MurmurHash nullGetter( const HashCacheKey &key, size_t &cost )
+		{
+			cost = 0;
+			return IECore::MurmurHash();
+		}
+
+		static void removalCallback( const HashCacheKey &key, const IECore::MurmurHash &value )
+		{
+			// Entries with a default hash are placeholders created by
+			// nullGetter(), and don't count as evictions.
+			if( value != IECore::MurmurHash() )
+			{
+				g_statistics.local().evictions++;
+			}
+		}
+
+		static const ContextDependencies *dependenciesNullGetter( const HashCacheKey &key, size_t &cost )
+		{
+			cost = 0;
+			return NULL;
+		}
+
+		// Returns the hash of the context variables named by `dependencies`,
+		// for use in a hash cache key. The address of the dependencies is
+		// included so that keys are distinct for distinct sets of variables.
+		static IECore::MurmurHash contextHash( const Context *context, const ContextDependencies *dependencies )
+		{
+			IECore::MurmurHash result = dependencies->all ? context->hash() : context->hash( dependencies->names );
+			result.append( (uint64_t)dependencies );
+			return result;
+		}
+
+		// During a single graph evaluation, we actually call ValuePlug::hash()
+		// many times for the same plugs. First hash() is called for the terminating plug,
+		// which will call hash() for all the upstream plugs, and then compute() is called
+		// for the terminating plug, which will call getValue() on the upstream plugs. But
+		// those upstream plugs will need to call their hash() again in getValue(), so their
+		// value can be cached. This ripples on up the chain, leading to quadratic complexity
+		// in the length of the chain of nodes - not good. Thanks is due to David Minor for
+		// being the first to point this out.
+		//
+		// We address this problem by keeping a cache of hashes, indexed by the plug the
+		// hash is for, the dirty count for the plug, and the context the hash was performed
+		// in. The cache is shared between all threads, so that work done by one thread can
+		// be reused by the others, and the LRU policy of the cache prevents unbounded growth.
+		// Each entry is given a cost of 1, so the maximum cost of the cache is the maximum
+		// number of entries.
+		typedef IECorePreview::LRUCache<HashCacheKey, IECore::MurmurHash> Cache;
+		static Cache g_cache;
+
+		// To avoid needlessly distinct entries in g_cache, we also record the
+		// context variables each plug's hash depends on, so that only those
+		// variables contribute to the key. These are cached separately,
+		// indexed by plug and dirty count alone.
+		typedef IECorePreview::LRUCache<HashCacheKey, const ContextDependencies *> DependenciesCache;
+		static DependenciesCache g_dependenciesCache;
+
+		// Statistics are accumulated per thread, to avoid contention on
+		// shared counters, and are summed when queried.
+		struct Statistics
+		{
+			Statistics() : hits( 0 ), misses( 0 ), evictions( 0 ) {}
+			size_t hits;
+			size_t misses;
+			size_t evictions;
+		};
+
+		typedef tbb::enumerable_thread_specific<Statistics, tbb::cache_aligned_allocator<Statistics>, tbb::ets_key_per_instance> StatisticsContainer;
+		static StatisticsContainer g_statistics;
+
+		IECore::MurmurHash m_result;
+
+};
+
+const IECore::InternedString ValuePlug::HashProcess::staticType( "computeNode:hash" );
+ValuePlug::HashProcess::StatisticsContainer ValuePlug::HashProcess::g_statistics;
+ValuePlug::HashProcess::Cache ValuePlug::HashProcess::g_cache( nullGetter, removalCallback, 1000000 );
+ValuePlug::HashProcess::DependenciesCache ValuePlug::HashProcess::g_dependenciesCache( dependenciesNullGetter, 1000000 );
+
+//////////////////////////////////////////////////////////////////////////
+// The ComputeProcess manages the task of calling ComputeNode::compute()
+// and storing a cache of recently computed results.
+//////////////////////////////////////////////////////////////////////////
+
+class ValuePlug::ComputeProcess : public Process
+{
+
+	public :
+
+		static size_t getCacheMemoryLimit()
+		{
+			return g_cacheMemoryLimit;
+		}
+
+		static void setCacheMemoryLimit( size_t bytes )
+		{
+			g_cacheMemoryLimit = bytes;
+			limitCacheMemory();
+		}
+
+		static size_t cacheMemoryUsage()
+		{
+			return g_cache.currentCost() + g_orphanedBufferMemory;
+		}
+
+		static CacheMemoryUsageByPlug cacheMemoryUsageByPlug()
+		{
+			// Plug names are only needed here, so we key the usage by
+			// plug pointer and build the names on demand. Orphaned buffers
+			// are not included, since no plug's cache entry holds them.
+			CacheMemoryUsageByPlug result;
+			tbb::spin_mutex::scoped_lock lock( g_cacheMemoryUsageByPlugMutex );
+			for( PlugMemoryUsage::const_iterator it = g_cacheMemoryUsageByPlug.begin(), eIt = g_cacheMemoryUsageByPlug.end(); it != eIt; ++it )
+			{
+				result[it->first->fullName()] += it->second;
+			}
+			return result;
+		}
+
+		// Called by ~ValuePlug(), so that cacheMemoryUsageByPlug()
+		// never accesses a deleted plug.
+		static void plugDestroyed( const ValuePlug *plug )
+		{
+			tbb::spin_mutex::scoped_lock lock( g_cacheMemoryUsageByPlugMutex );
+			g_cacheMemoryUsageByPlug.erase( plug );
+		}
+
+		static void clearCache()
+		{
+			g_cache.clear();
+		}
+
+		static IECore::ConstObjectPtr value( const ValuePlug *plug, const IECore::MurmurHash *precomputedHash )
+		{
+			const ValuePlug *p = sourcePlug( plug );
+
+			if( !p->getInput<Plug>() )
+			{
+				if( p->direction()==In || !p->ancestor<ComputeNode>() )
+				{
+					// No input connection, and no means of computing
+					// a value. There can only ever be a single value,
+					// which is stored directly on the plug.
+					return p->m_staticValue;
+				}
+			}
+
+			// A plug with an input connection or an output plug on a ComputeNode. There can be many values -
+			// one per context, computed via ComputeNode::compute().
+
+			const CachePolicy cachePolicy = HashProcess::cachePolicy( p );
+			if( cachePolicy == Uncached || cachePolicy == HashOnly )
+			{
+				// Plug has requested no caching, so we compute from scratch every
+				// time.
+				return ComputeProcess( p, plug ).m_result;
+			}
+
+			// First see if we've done this computation already, and reuse the
+			// result if we have.
+			IECore::MurmurHash hash = precomputedHash ? *precomputedHash : p->hash();
+			ConstCacheEntryPtr cacheEntry = g_cache.get( hash );
+			if( cacheEntry )
+			{
+				return cacheEntry->value;
+			}
+
+			// Next see if the value is available from the persistent cache,
+			// having been computed by another process.
+			const bool persistent = g_persistentCache.enabled() && persistentCacheable( p );
+			if( persistent )
+			{
+				if( IECore::ConstObjectPtr result = g_persistentCache.get( hash ) )
+				{
+					storeInCache( p, hash, result );
+					return result;
+				}
+			}
+
+			if( cachePolicy == Standard )
+			{
+				// Otherwise, use a ComputeProcess instance to do the work.
+				// The variables read by the compute are necessarily among
+				// those already recorded by the hash, so we suspend any
+				// recording by a downstream hash to avoid the overhead.
+				// We can't do the same when computing directly above, because
+				// in that case there is no hash.
+				IECore::ConstObjectPtr result;
+				{
+					Context::AccessRecorder::Scope recorderScope( NULL );
+					result = ComputeProcess( p, plug ).m_result;
+				}
+				storeInCache( p, hash, result );
+				if( persistent )
+				{
+					g_persistentCache.set( hash, result.get() );
+				}
+				return result;
+			}
+
+			assert( cachePolicy == TaskCollaboration );
+
+			// See if another thread is already computing the same
+			// value. If it is, we collaborate with it rather than duplicating
+			// the work. If not, we register ourselves as the thread responsible
+			// for the computation, so that others may collaborate with us.
+			InFlightComputePtr inFlightCompute;
+			bool owner = false;
+			{
+				InFlightComputes::accessor accessor;
+				if( g_inFlightComputes.insert( accessor, InFlightKey( p, hash ) ) )
+				{
+					// We're responsible for the computation, so use a ComputeProcess
+					// instance to do the work. We do this inside the task arena for
+					// the computation, so that any TBB tasks it spawns are available
+					// to collaborating threads. The RunFunctor releases the accessor
+					// once the work has been launched.
+					accessor->second.reset( new InFlightCompute );
+					inFlightCompute = accessor->second;
+					owner = true;
+					inFlightCompute->arena.execute(
+						RunFunctor( ComputeFunctor( p, plug, hash, Context::current(), inFlightCompute.get() ), accessor )
+					);
+				}
+				else
+				{
+					inFlightCompute = accessor->second;
+				}
+			}
+
+			if( !owner )
+			{
+				inFlightCompute->wait();
+				if( inFlightCompute->cancelled )
+				{
+					// The computation was cancelled on behalf of the thread
+					// which owned it, but that doesn't mean that we have been
+					// cancelled too. Try again, taking ownership of the
+					// computation if necessary.
+					return value( plug, &hash );
+				}
+			}
+			else if( persistent && inFlightCompute->result )
+			{
+				g_persistentCache.set( hash, inFlightCompute->result.get() );
+			}
+
+			return inFlightCompute->value();
+		}
+
+		static void receiveResult( const ValuePlug *plug, IECore::ConstObjectPtr result )
+		{
+			const Process *process = Process::current();
+			if( !process || process->type() != staticType )
+			{
+				throw IECore::Exception( boost::str( boost::format( "Cannot set value for plug \"%s\" except during computation." ) % plug->fullName() ) );
+			}
+
+			const ComputeProcess *computeProcess = static_cast<const ComputeProcess *>( process );
+			if( computeProcess->plug() != plug )
+			{
+				throw IECore::Exception( boost::str( boost::format( "Cannot set value for plug \"%s\" during computation for plug \"%s\"." ) % plug->fullName() % computeProcess->plug()->fullName() ) );
+			}
+
+			const_cast<ComputeProcess *>( computeProcess )->m_result = result;
+		}
+
+		static const IECore::InternedString staticType;
+
+	private :
+
+		ComputeProcess( const ValuePlug *plug, const ValuePlug *downstream )
+			:	Process( staticType, plug, downstream )
+		{
+			try
+			{
+				Canceller::check( Context::current()->canceller() );
+				if( const ValuePlug *input = plug->getInput<ValuePlug>() )
+				{
+					// Cast is ok, because we know that the resulting setValue() call won't
+					// actually modify the plug, but will just place the value in our m_result.
+					const_cast<ValuePlug *>( plug )->setFrom( input );
+				}
+				else
+				{
+					const ComputeNode *n = plug->ancestor<ComputeNode>();
+					if( !n )
+					{
+						throw IECore::Exception( boost::str( boost::format( "Unable to compute value for Plug \"%s\" as it has no ComputeNode." ) % plug->fullName() ) );
+					}
+					// Cast is ok - see comment above.
+					n->compute( const_cast<ValuePlug *>( plug ), Context::current() );
+				}
+				// The calls above should cause setValue() to be called on the result plug, which in
+				// turn will call ValuePlug::setObjectValue(), which will then store the result in
+				// the current ComputeProcess by calling receiveResult(). If that hasn't happened then
+				// something has gone wrong and we should complain about it.
+				if( !m_result )
+				{
+					throw IECore::Exception( boost::str( boost::format( "Value for Plug \"%s\" not set as expected." ) % plug->fullName() ) );
+				}
+			}
+			catch( ... )
+			{
+				handleException();
+			}
+		}
+
+		// The value stored for each entry in the cache. Alongside the result
+		// itself we store the information needed to update our memory
+		// accounting when the entry is removed.
+		struct CacheEntry
+		{
+			IECore::ConstObjectPtr value;
+			const ValuePlug *plug;
+			Buffers buffers;
+			size_t cost;
+		};
+
+		typedef boost::shared_ptr<const CacheEntry> ConstCacheEntryPtr;
+
+		static bool persistentCacheable( const ValuePlug *p )
+		{
+			if( !p->getInput<ValuePlug>() )
+			{
+				if( const ComputeNode *n = p->ancestor<ComputeNode>() )
+				{
+					return n->persistentCacheable( p );
+				}
+			}
+			return false;
+		}
+
+		static ConstCacheEntryPtr nullGetter( const IECore::MurmurHash &h, size_t &cost )
+		{
+			cost = 0;
+			return ConstCacheEntryPtr();
+		}
+
+		static void removalCallback( const IECore::MurmurHash &hash, const ConstCacheEntryPtr &cacheEntry )
+		{
+			// Null entries are placeholders left by nullGetter().
+			if( cacheEntry )
+			{
+				releaseMemoryUsage( *cacheEntry );
+			}
+		}
+
+		static void releaseMemoryUsage( const CacheEntry &cacheEntry )
+		{
+			removeBufferReferences( cacheEntry.buffers );
+			if( !cacheEntry.cost )
+			{
+				return;
+			}
+
+			tbb::spin_mutex::scoped_lock lock( g_cacheMemoryUsageByPlugMutex );
+			PlugMemoryUsage::iterator it = g_cacheMemoryUsageByPlug.find( cacheEntry.plug );
+			if( it == g_cacheMemoryUsageByPlug.end() )
+			{
+				// The plug has been destroyed.
+				return;
+			}
+			// The plug may not be the one that stored the entry, if it
+			// reuses the address of a destroyed plug, so we can't assume
+			// that its usage includes our cost.
+			it->second -= std::min( it->second, cacheEntry.cost );
+			if( !it->second )
+			{
+				g_cacheMemoryUsageByPlug.erase( it );
+			}
+		}
+
+		// The orphaned buffers aren't charged to any entry in the cache,
+		// so we reduce the cost limit for the entries accordingly. When
+		// entries referencing the orphaned buffers are removed as a
+		// result, the buffers are freed and the limit rises again.
+		static void limitCacheMemory()
+		{
+			// Bounded, in case concurrent activity prevents us
+			// from settling. The next call will continue the work.
+			for( int i = 0; i < 4; ++i )
+			{
+				const size_t limit = g_cacheMemoryLimit;
+				const size_t orphaned = g_orphanedBufferMemory;
+				const size_t maxCost = limit > orphaned ? limit - orphaned : 0;
+				if( maxCost == g_cache.getMaxCost() )
+				{
+					return;
+				}
+				g_cache.setMaxCost( maxCost );
+			}
+		}
+
+		static void storeInCache( const ValuePlug *plug, const IECore::MurmurHash &hash, const IECore::ConstObjectPtr &value )
+		{
+			// Store the value in the cache, after first checking that this hasn't
+			// been done already. The check is useful because it's common for an
+			// upstream compute triggered by to have already
+			// done the work, and calling memoryUsage() can be very expensive for some
+			// datatypes. A prime example of this is the attribute state passed around
+			// in GafferScene - it's common for a selective filter to mean that the
+			// attribute compute is implemented as a pass-through (thus an upstream node
+			// will already have computed the same result) and the attribute data itself
+			// consists of many small objects for which computing memory usage is slow.
+			/// \todo Accessing the LRUCache multiple times like this does have an
+			/// overhead, and at some point we'll need to address that.
+			if( g_cache.get( hash ) )
+			{
+				return;
+			}
+
+			// Account for the memory before adding the entry, so that our
+			// accounting is always up to date by the time the entry can be
+			// removed by another thread.
+			boost::shared_ptr<CacheEntry> cacheEntry( new CacheEntry );
+			cacheEntry->value = value;
+			cacheEntry->plug = plug;
+			accumulateBuffers( value.get(), cacheEntry->buffers );
+			cacheEntry->cost = addBufferReferences( cacheEntry->buffers );
+			if( cacheEntry->cost )
+			{
+				tbb::spin_mutex::scoped_lock lock( g_cacheMemoryUsageByPlugMutex );
+				g_cacheMemoryUsageByPlug[plug] += cacheEntry->cost;
+			}
+
+			if( !g_cache.set( hash, cacheEntry, cacheEntry->cost ) )
+			{
+				releaseMemoryUsage( *cacheEntry );
+			}
+
+			limitCacheMemory();
+		}
+
+		// Represents a computation which is currently being performed by
+		// one thread, and which may be awaited by any number of others.
+		// The computation is performed within its own task arena, which
+		// serves two purposes :
+		//
+		// - Waiting threads can join the arena, and help to complete any
+		//   TBB tasks spawned by the computation.
+		// - The thread performing the computation can't steal unrelated
+		//   tasks while it waits for its own tasks to complete. Were it to
+		//   do so, it could end up waiting on a computation owned by another
+		//   thread which is itself waiting on this one, causing deadlock.
+		struct InFlightCompute : public boost::noncopyable
+		{
+
+			InFlightCompute()
+				:	exception( NULL ), cancelled( false )
+			{
+			}
+
+			~InFlightCompute()
+			{
+				if( exception )
+				{
+					exception->destroy();
+				}
+			}
+
+			// Waits for the computation to complete, helping out with
+			// its tasks where possible. The compute task is added to
+			// `taskGroup` before the computation is made visible to
+			// other threads, so this always blocks until it is done.
+			void wait()
+			{
+				arena.execute( WaitFunctor( taskGroup ) );
+			}
+
+			// Returns the result, or rethrows the exception thrown by the
+			// computation. Must only be called once the compute task has completed.
+			IECore::ConstObjectPtr value() const
+			{
+				if( cancelled )
+				{
+					throw Cancelled();
+				}
+				if( exception )
+				{
+					try
+					{
+						exception->throw_self();
+					}
+					catch( const tbb::movable_exception<IECore::Exception> &e )
+					{
+						throw e.data();
+					}
+				}
+				return result;
+			}
+
+			tbb::task_arena arena;
+			tbb::task_group taskGroup;
+			IECore::ConstObjectPtr result;
+			// Exceptions can't be transferred between threads in C++98,
+			// so we use TBB's exception transport to carry them from the
+			// thread performing the computation to the owning thread and
+			// any waiting threads. IECore::Exceptions are transferred
+			// intact, and all others as `tbb::captured_exception`, which
+			// preserves the name of their type and their message.
+			tbb::tbb_exception *exception;
+			// True if the computation was cancelled via the canceller
+			// belonging to the context of the owning thread.
+			bool cancelled;
+
+		};
+
+		typedef boost::shared_ptr<InFlightCompute> InFlightComputePtr;
+
+		// Registry of the computations currently in flight, keyed by the plug
+		// being computed and the hash of the value being computed.
+		typedef std::pair<const ValuePlug *, IECore::MurmurHash> InFlightKey;
+
+		struct InFlightKeyHashCompare
+		{
+
+			static size_t hash( const InFlightKey &key )
+			{
+				size_t result = 0;
+				boost::hash_combine( result, key.first );
+				boost::hash_combine( result, key.second );
+				return result;
+			}
+
+			static bool equal( const InFlightKey &a, const InFlightKey &b )
+			{
+				return a == b;
+			}
+
+		};
+
+		typedef tbb::concurrent_hash_map<InFlightKey, InFlightComputePtr, InFlightKeyHashCompare> InFlightComputes;
+		static InFlightComputes g_inFlightComputes;
+
+		// Functor used to run a ComputeProcess for an InFlightCompute.
+		struct ComputeFunctor
+		{
+
+			ComputeFunctor( const ValuePlug *plug, const ValuePlug *downstream, const IECore::MurmurHash &hash, const Context *context, InFlightCompute *inFlightCompute )
+				:	m_plug( plug ), m_downstream( downstream ), m_hash( hash ), m_context( context ), m_parentProcess( Process::current() ), m_inFlightCompute( inFlightCompute )
+			{
+			}
+
+			void operator()() const
+			{
+				// The task group may run us on a different thread to
+				// the one which requested the computation, so we must
+				// transfer the context and parent process explicitly.
+				Context::Scope scope( m_context );
+				Process::Scope processScope( m_parentProcess );
+				// Variables read by the compute are already accounted
+				// for by the hash - see ComputeProcess::value().
+				Context::AccessRecorder::Scope recorderScope( NULL );
+				try
+				{
+					ComputeProcess process( m_plug, m_downstream );
+					m_inFlightCompute->result = process.m_result;
+					storeInCache( m_plug, m_hash, m_inFlightCompute->result );
+				}
+				catch( const Cancelled &e )
+				{
+					m_inFlightCompute->cancelled = true;
+				}
+				catch( tbb::tbb_exception &e )
+				{
+					m_inFlightCompute->exception = e.move();
+				}
+				catch( const IECore::Exception &e )
+				{
+					m_inFlightCompute->exception = tbb::movable_exception<IECore::Exception>( e ).move();
+				}
+				catch( const std::exception &e )
+				{
+					m_inFlightCompute->exception = tbb::captured_exception::allocate( typeid( e ).name(), e.what() );
+				}
+				catch( ... )
+				{
+					m_inFlightCompute->exception = tbb::captured_exception::allocate( "...", "Unknown error" );
+				}
+
+				// Remove the computation from the registry before the task
+				// completes, so that waiting threads which retry following
+				// cancellation can't find it again. Threads arriving after
+				// this point will find the value in the cache.
+				g_inFlightComputes.erase( InFlightKey( m_plug, m_hash ) );
+			}
+
+			const ValuePlug *m_plug;
+			const ValuePlug *m_downstream;
+			const IECore::MurmurHash m_hash;
+			const Context *m_context;
+			const Process *m_parentProcess;
+			InFlightCompute *m_inFlightCompute;
+
+		};
+
+		// Functor used by the owning thread to launch a ComputeFunctor from
+		// within the arena for an InFlightCompute, and then wait for it.
+		// The registry accessor is only released once the task has been
+		// added to the task group, so that collaborating threads always
+		// have something to wait for.
+		struct RunFunctor
+		{
+
+			RunFunctor( const ComputeFunctor &computeFunctor, InFlightComputes::accessor &accessor )
+				:	m_computeFunctor( computeFunctor ), m_accessor( accessor )
+			{
+			}
+
+			void operator()() const
+			{
+				tbb::task_group &taskGroup = m_computeFunctor.m_inFlightCompute->taskGroup;
+				taskGroup.run( m_computeFunctor );
+				m_accessor.release();
+				taskGroup.wait();
+			}
+
+			ComputeFunctor m_computeFunctor;
+			InFlightComputes::accessor &m_accessor;
+
+		};
+
+		struct WaitFunctor
+		{
+
+			WaitFunctor( tbb::task_group &taskGroup )
+				:	m_taskGroup( taskGroup )
+			{
+			}
+
+			void operator()() const
+			{
+				m_taskGroup.wait();
+			}
+
+			tbb::task_group &m_taskGroup;
+
+		};
+
+		// A cache mapping from ValuePlug::hash() to the result of the previous computation
+		// for that hash. This allows us to cache results for faster repeat evaluation
+		typedef IECorePreview::LRUCache<IECore::MurmurHash, ConstCacheEntryPtr> Cache;
+		static Cache g_cache;
+
+		// The limit for the total memory usage of the cache, including
+		// orphaned buffers.
+		static size_t g_cacheMemoryLimit;
+
+		// The current cost of the cache entries, broken down by the plug
+		// which computed them.
+		typedef boost::unordered_map<const ValuePlug *, size_t> PlugMemoryUsage;
+		static PlugMemoryUsage g_cacheMemoryUsageByPlug;
+		static tbb::spin_mutex g_cacheMemoryUsageByPlugMutex;
+
+		IECore::ConstObjectPtr m_result;
+
+};
+
+const IECore::InternedString ValuePlug::ComputeProcess::staticType( "computeNode:compute" );
+ValuePlug::ComputeProcess::PlugMemoryUsage ValuePlug::ComputeProcess::g_cacheMemoryUsageByPlug;
+tbb::spin_mutex ValuePlug::ComputeProcess::g_cacheMemoryUsageByPlugMutex;
+size_t ValuePlug::ComputeProcess::g_cacheMemoryLimit = 1024 * 1024 * 1024 * 1; // 1 gig
+ValuePlug::ComputeProcess::Cache ValuePlug::ComputeProcess::g_cache( nullGetter, removalCallback, g_cacheMemoryLimit );
+ValuePlug::ComputeProcess::InFlightComputes ValuePlug::ComputeProcess::g_inFlightComputes;
+
+//////////////////////////////////////////////////////////////////////////
+// SetValueAction implementation
+//////////////////////////////////////////////////////////////////////////
+
+class ValuePlug::SetValueAction : public Gaffer::Action
+{
+
+	public :
+
+		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( Gaffer::ValuePlug::SetValueAction, SetValueActionTypeId, Gaffer::Action );
+
+		SetValueAction( ValuePlugPtr plug, IECore::ConstObjectPtr value )
+			:	m_plug( plug ), m_doValue( value ), m_undoValue( plug->m_staticValue )
+		{
+		}
+
+	protected :
+
+		virtual GraphComponent *subject() const
+		{
+			return m_plug.get();
+		}
+
+		virtual void doAction()
+		{
+			m_plug->setValueInternal( m_doValue, true );
+		}
+
+		virtual void undoAction()
+		{
+			m_plug->setValueInternal( m_undoValue, true );
+		}
+
+		virtual bool canMerge( const Action *other ) const
+		{
+			if( !Action::canMerge( other ) )
+			{
+				return false;
+			}
+			const SetValueAction *setValueAction = IECore::runTimeCast<const SetValueAction>( other );
+			return setValueAction && setValueAction->m_plug == m_plug;
+		}
+
+		virtual void merge( const Action *other )
+		{
+			const SetValueAction *setValueAction = static_cast<const SetValueAction *>( other );
+			m_doValue = setValueAction->m_doValue;
+		}
+
+	private :
+
+		ValuePlugPtr m_plug;
+		IECore::ConstObjectPtr m_doValue;
+		IECore::ConstObjectPtr m_undoValue;
+
+};
+
+IE_CORE_DEFINERUNTIMETYPED( ValuePlug::SetValueAction );
+
+//////////////////////////////////////////////////////////////////////////
+// SetValuesAction implementation
+//////////////////////////////////////////////////////////////////////////
+
+// Records all the values set within a BatchEditScope, so that
+// they can be undone and redone as one, with a single pass of
+// dirty propagation.
+class ValuePlug::SetValuesAction : public Gaffer::Action
+{
+
+	public :
+
+		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( Gaffer::ValuePlug::SetValuesAction, SetValuesActionTypeId, Gaffer::Action );
+
+		void addEdit( ValuePlugPtr plug, IECore::ConstObjectPtr doValue, IECore::ConstObjectPtr undoValue )
+		{
+			Edit edit;
+			edit.plug = plug;
+			edit.doValue = doValue;
+			edit.undoValue = undoValue;
+			m_edits.push_back( edit );
+		}
+
+	protected :
+
+		virtual GraphComponent *subject() const
+		{
+			return m_edits.front().plug.get();
+		}
+
+		virtual void doAction()
+		{
+			Action::doAction();
+			DirtyPropagationScope dirtyPropagationScope;
+			for( Edits::const_iterator it = m_edits.begin(), eIt = m_edits.end(); it != eIt; ++it )
+			{
+				it->plug->setValueInternal( it->doValue, true );
+			}
+		}
+
+		virtual void undoAction()
+		{
+			Action::undoAction();
+			DirtyPropagationScope dirtyPropagationScope;
+			for( Edits::const_reverse_iterator it = m_edits.rbegin(), eIt = m_edits.rend(); it != eIt; ++it )
+			{
+				it->plug->setValueInternal( it->undoValue, true );
+			}
+		}
+
+		virtual bool canMerge( const Action *other ) const
+		{
+			if( !Action::canMerge( other ) )
+			{
+				return false;
+			}
+
+			const SetValuesAction *setValuesAction = IECore::runTimeCast<const SetValuesAction>( other );
+			if( !setValuesAction || setValuesAction->m_edits.size() != m_edits.size() )
+			{
+				return false;
+			}
 
-				if( m_result == IECore::MurmurHash() )
+			for( size_t i = 0, e = m_edits.size(); i < e; ++i )
+			{
+				if( setValuesAction->m_edits[i].plug != m_edits[i].plug )
 				{
-					throw IECore::Exception( boost::str( boost::format( "ComputeNode::hash() not implemented for Plug \"%s\"." ) % plug->fullName() ) );
+					return false;
 				}
 			}
-			catch( ... )
+
+			return true;
+		}
+
+		virtual void merge( const Action *other )
+		{
+			const SetValuesAction *setValuesAction = static_cast<const SetValuesAction *>( other );
+			for( size_t i = 0, e = m_edits.size(); i < e; ++i )
 			{
-				handleException();
+				m_edits[i].doValue = setValuesAction->m_edits[i].doValue;
 			}
 		}
 
-		// During a single graph evaluation, we actually call ValuePlug::hash()
-		// many times for the same plugs. First hash() is called for the terminating plug,
-		// which will call hash() for all the upstream plugs, and then compute() is called
-		// for the terminating plug, which will call getValue() on the upstream plugs. But
-		// those upstream plugs will need to call their hash() again in getValue(), so their
-		// value can be cached. This ripples on up the chain, leading to quadratic complexity
-		// in the length of the chain of nodes - not good. Thanks is due to David Minor for
-		// being the first to point this out.
-		//
-		// We address this problem by keeping a per-thread cache of hashes, indexed
-		// by the plug the hash is for and the context the hash was performed in. The
-		// typedefs below describe that data structure. We use Plug::dirty() to empty
-		// the caches, because they are invalidated whenever an upstream value or
-		// connection is changed. We also clear the cache unconditionally every N
-		// computations, to prevent unbounded growth.
-		typedef std::pair<const ValuePlug *, IECore::MurmurHash> CacheKey;
-		typedef boost::unordered_map<CacheKey, IECore::MurmurHash> Cache;
-
-		// To support multithreading, each thread has it's own state.
-		struct ThreadData
-		{
-			ThreadData() : cacheClearCount( 0 ) {}
-			int cacheClearCount;
-			Cache cache;
-			// Flag to request that hashCache be cleared.
-			tbb::atomic<int> clearCache;
-		};
+	private :
 
-		static tbb::enumerable_thread_specific<ThreadData, tbb::cache_aligned_allocator<ThreadData>, tbb::ets_key_per_instance > g_threadData;
+		struct Edit
+		{
+			ValuePlugPtr plug;
+			IECore::ConstObjectPtr doValue;
+			IECore::ConstObjectPtr undoValue;
+		};
 
-		IECore::MurmurHash m_result;
+		typedef std::vector<Edit> Edits;
+		Edits m_edits;
 
 };
 
-const IECore::InternedString ValuePlug::HashProcess::staticType( "computeNode:hash" );
-tbb::enumerable_thread_specific<ValuePlug::HashProcess::ThreadData, tbb::cache_aligned_allocator<ValuePlug::HashProcess::ThreadData>, tbb::ets_key_per_instance > ValuePlug::HashProcess::g_threadData;
+IE_CORE_DEFINERUNTIMETYPED( ValuePlug::SetValuesAction );
 
 //////////////////////////////////////////////////////////////////////////
-// The ComputeProcess manages the task of calling ComputeNode::compute()
-// and storing a cache of recently computed results.
+// BatchEdits implementation
 //////////////////////////////////////////////////////////////////////////
 
-class ValuePlug::ComputeProcess : public Process
+// Collects the plugs edited within a BatchEditScope, along with
+// their original values. As with Plug::DirtyPlugs, the container
+// is stored per-thread.
+class ValuePlug::BatchEdits
 {
 
 	public :
 
-		static size_t getCacheMemoryLimit()
-		{
-			return g_cache.getMaxCost();
-		}
-
-		static void setCacheMemoryLimit( size_t bytes )
+		BatchEdits()
+			:	m_flushed( false ), m_scopeCount( 0 )
 		{
-			return g_cache.setMaxCost( bytes );
 		}
 
-		static size_t cacheMemoryUsage()
+		// Must be called before any value or hash is read, so that reads
+		// made within a batch don't retrieve hashes that were cached for
+		// previous values. The check for active batches on any thread is
+		// a single load, so this is cheap enough to call on every read.
+		static void flushAll()
 		{
-			return g_cache.currentCost();
+			if( g_activeCount )
+			{
+				local().flush();
+			}
 		}
 
-		static void clearCache()
+		bool active() const
 		{
-			g_cache.clear();
+			return m_scopeCount;
 		}
 
-		static IECore::ConstObjectPtr value( const ValuePlug *plug, const IECore::MurmurHash *precomputedHash )
+		void setValue( ValuePlug *plug, IECore::ConstObjectPtr value )
 		{
-			const ValuePlug *p = sourcePlug( plug );
-
-			if( !p->getInput<Plug>() )
+			if( m_plugs.insert( plug ).second )
 			{
-				if( p->direction()==In || !p->ancestor<ComputeNode>() )
-				{
-					// No input connection, and no means of computing
-					// a value. There can only ever be a single value,
-					// which is stored directly on the plug.
-					return p->m_staticValue;
-				}
+				// First edit to this plug, so record the value we'll
+				// restore on undo.
+				Edit edit;
+				edit.plug = plug;
+				edit.undoValue = plug->m_staticValue;
+				m_edits.push_back( edit );
 			}
 
-			// A plug with an input connection or an output plug on a ComputeNode. There can be many values -
-			// one per context, computed via ComputeNode::compute().
-
-			if( p->getFlags( Plug::Cacheable ) )
-			{
-				// First see if we've done this computation already, and reuse the
-				// result if we have.
-				IECore::MurmurHash hash = precomputedHash ? *precomputedHash : p->hash();
-				IECore::ConstObjectPtr result = g_cache.get( hash );
-				if( result )
-				{
-					return result;
-				}
-
-				// Otherwise, use a ComputeProcess instance to do the work.
-				ComputeProcess process( p, plug );
-				// Store the value in the cache, after first checking that this hasn't
-				// been done already. The check is useful because it's common for an
-				// upstream compute triggered by to have already
-				// done the work, and calling memoryUsage() can be very expensive for some
-				// datatypes. A prime example of this is the attribute state passed around
-				// in GafferScene - it's common for a selective filter to mean that the
-				// attribute compute is implemented as a pass-through (thus an upstream node
-				// will already have computed the same result) and the attribute data itself
-				// consists of many small objects for which computing memory usage is slow.
-				/// \todo Accessing the LRUCache multiple times like this does have an
-				/// overhead, and at some point we'll need to address that.
-				if( !g_cache.get( hash ) )
-				{
-					g_cache.set( hash, process.m_result, process.m_result->memoryUsage() );
-				}
-				return process.m_result;
-			}
-			else
-			{
-				// Plug has requested no caching, so we compute from scratch every
-				// time.
-				return ComputeProcess( p, plug ).m_result;
-			}
+			plug->m_staticValue = value;
+			m_pending.push_back( plug );
 		}
 
-		static void receiveResult( const ValuePlug *plug, IECore::ConstObjectPtr result )
+		void pushScope()
 		{
-			const Process *process = Process::current();
-			if( !process || process->type() != staticType )
+			if( m_scopeCount++ == 0 )
 			{
-				throw IECore::Exception( boost::str( boost::format( "Cannot set value for plug \"%s\" except during computation." ) % plug->fullName() ) );
+				g_activeCount++;
 			}
+		}
 
-			const ComputeProcess *computeProcess = static_cast<const ComputeProcess *>( process );
-			if( computeProcess->plug() != plug )
+		void popScope()
+		{
+			assert( m_scopeCount );
+			if( --m_scopeCount == 0 )
 			{
-				throw IECore::Exception( boost::str( boost::format( "Cannot set value for plug \"%s\" during computation for plug \"%s\"." ) % plug->fullName() % computeProcess->plug()->fullName() ) );
+				g_activeCount--;
+				commit();
 			}
-
-			const_cast<ComputeProcess *>( computeProcess )->m_result = result;
 		}
 
-		static const IECore::InternedString staticType;
+		static BatchEdits &local()
+		{
+			static tbb::enumerable_thread_specific<ValuePlug::BatchEdits> g_batchEdits;
+			return g_batchEdits.local();
+		}
 
 	private :
 
-		ComputeProcess( const ValuePlug *plug, const ValuePlug *downstream )
-			:	Process( staticType, plug, downstream )
+		typedef boost::intrusive_ptr<SetValuesAction> SetValuesActionPtr;
+
+		// Takes new dirty counts for the plugs edited since the last
+		// flush and everything that depends on them, without emitting any
+		// signals. All the plugs share a single traversal, so that each
+		// downstream plug is visited once no matter how many edits
+		// affect it.
+		void flush()
 		{
-			try
+			if( m_pending.empty() )
 			{
-				if( const ValuePlug *input = plug->getInput<ValuePlug>() )
+				return;
+			}
+
+			for( std::vector<ValuePlug *>::const_iterator pIt = m_pending.begin(), peIt = m_pending.end(); pIt != peIt; ++pIt )
+			{
+				if( !dirtyWithAncestors( *pIt ) )
 				{
-					// Cast is ok, because we know that the resulting setValue() call won't
-					// actually modify the plug, but will just place the value in our m_result.
-					const_cast<ValuePlug *>( plug )->setFrom( input );
+					continue;
 				}
-				else
+				for( DownstreamIterator it( *pIt ); !it.done(); ++it )
 				{
-					const ComputeNode *n = plug->ancestor<ComputeNode>();
-					if( !n )
+					if( !dirtyWithAncestors( &*it ) )
 					{
-						throw IECore::Exception( boost::str( boost::format( "Unable to compute value for Plug \"%s\" as it has no ComputeNode." ) % plug->fullName() ) );
+						it.prune();
 					}
-					// Cast is ok - see comment above.
-					n->compute( const_cast<ValuePlug *>( plug ), Context::current() );
-				}
-				// The calls above should cause setValue() to be called on the result plug, which in
-				// turn will call ValuePlug::setObjectValue(), which will then store the result in
-				// the current ComputeProcess by calling receiveResult(). If that hasn't happened then
-				// something has gone wrong and we should complain about it.
-				if( !m_result )
-				{
-					throw IECore::Exception( boost::str( boost::format( "Value for Plug \"%s\" not set as expected." ) % plug->fullName() ) );
 				}
 			}
-			catch( ... )
-			{
-				handleException();
-			}
-		}
 
-		static IECore::ObjectPtr nullGetter( const IECore::MurmurHash &h, size_t &cost )
-		{
-			cost = 0;
-			return NULL;
+			m_pending.clear();
+			m_visited.clear();
+			m_flushed = true;
 		}
 
-		// A cache mapping from ValuePlug::hash() to the result of the previous computation
-		// for that hash. This allows us to cache results for faster repeat evaluation
-		typedef IECorePreview::LRUCache<IECore::MurmurHash, IECore::ConstObjectPtr> Cache;
-		static Cache g_cache;
-
-		IECore::ConstObjectPtr m_result;
-
-};
-
-const IECore::InternedString ValuePlug::ComputeProcess::staticType( "computeNode:compute" );
-ValuePlug::ComputeProcess::Cache ValuePlug::ComputeProcess::g_cache( nullGetter, 1024 * 1024 * 1024 * 1 ); // 1 gig
-
-//////////////////////////////////////////////////////////////////////////
-// SetValueAction implementation
-//////////////////////////////////////////////////////////////////////////
-
-class ValuePlug::SetValueAction : public Gaffer::Action
-{
-
-	public :
-
-		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( Gaffer::ValuePlug::SetValueAction, SetValueActionTypeId, Gaffer::Action );
-
-		SetValueAction( ValuePlugPtr plug, IECore::ConstObjectPtr value )
-			:	m_plug( plug ), m_doValue( value ), m_undoValue( plug->m_staticValue )
+		// Returns false if the plug had already been visited.
+		bool dirtyWithAncestors( const Plug *plug )
 		{
-		}
+			if( !m_visited.insert( plug ).second )
+			{
+				return false;
+			}
 
-	protected :
+			for( const Plug *p = plug; p; p = p->parent<Plug>() )
+			{
+				if( ValuePlug *valuePlug = const_cast<ValuePlug *>( IECore::runTimeCast<const ValuePlug>( p ) ) )
+				{
+					valuePlug->dirty();
+				}
+			}
 
-		virtual GraphComponent *subject() const
-		{
-			return m_plug.get();
+			return true;
 		}
 
-		virtual void doAction()
+		void commit()
 		{
-			m_plug->setValueInternal( m_doValue, true );
-		}
+			// Take ownership of the edits, so that any values set
+			// by slots during the commit are dealt with in the usual
+			// way rather than being added to the batch we're iterating.
+			// If nothing was read within the batch, no hashes can have been
+			// cached for the new values, and enacting the actions below
+			// propagates dirtiness for all the edited plugs in a single pass.
+			// Otherwise we must flush, because values which were restored
+			// before the end of the batch aren't enacted.
+			if( m_flushed )
+			{
+				flush();
+				m_flushed = false;
+			}
+			m_pending.clear();
 
-		virtual void undoAction()
-		{
-			m_plug->setValueInternal( m_undoValue, true );
-		}
+			Edits edits;
+			edits.swap( m_edits );
+			m_plugs.clear();
 
-		virtual bool canMerge( const Action *other ) const
-		{
-			if( !Action::canMerge( other ) )
+			// Build one action per ScriptNode, since the actions are
+			// stored in the ScriptNode's undo queue.
+			typedef std::map<const ScriptNode *, SetValuesActionPtr> Actions;
+			Actions actions;
+			for( Edits::const_iterator it = edits.begin(), eIt = edits.end(); it != eIt; ++it )
 			{
-				return false;
+				ValuePlug *plug = it->plug.get();
+				if( plug->m_staticValue->isEqualTo( it->undoValue.get() ) )
+				{
+					// Value was restored before the end of the batch.
+					continue;
+				}
+
+				SetValuesActionPtr &action = actions[plug->ancestor<ScriptNode>()];
+				if( !action )
+				{
+					action = new SetValuesAction;
+				}
+				action->addEdit( plug, plug->m_staticValue, it->undoValue );
+			}
+
+			// Enacting each action calls setValueInternal() for all its
+			// plugs, emitting plugSetSignal() as we go. Dirtiness is signalled
+			// only once, when all the actions have been enacted.
+			DirtyPropagationScope dirtyPropagationScope;
+			for( Actions::const_iterator it = actions.begin(), eIt = actions.end(); it != eIt; ++it )
+			{
+				Action::enact( it->second );
 			}
-			const SetValueAction *setValueAction = IECore::runTimeCast<const SetValueAction>( other );
-			return setValueAction && setValueAction->m_plug == m_plug;
 		}
 
-		virtual void merge( const Action *other )
+		struct Edit
 		{
-			const SetValueAction *setValueAction = static_cast<const SetValueAction *>( other );
-			m_doValue = setValueAction->m_doValue;
-		}
+			ValuePlugPtr plug;
+			IECore::ConstObjectPtr undoValue;
+		};
 
-	private :
+		typedef std::vector<Edit> Edits;
+		Edits m_edits;
+		boost::unordered_set<const ValuePlug *> m_plugs;
+		// Plugs edited since the last flush. These are kept
+		// alive by m_edits.
+		std::vector<ValuePlug *> m_pending;
+		boost::unordered_set<const Plug *> m_visited;
+		// True if flush() has been called within the batch.
+		bool m_flushed;
+		size_t m_scopeCount;
 
-		ValuePlugPtr m_plug;
-		IECore::ConstObjectPtr m_doValue;
-		IECore::ConstObjectPtr m_undoValue;
+		// The number of threads with an active batch.
+		static tbb::atomic<int> g_activeCount;
 
 };
 
-IE_CORE_DEFINERUNTIMETYPED( ValuePlug::SetValueAction );
+tbb::atomic<int> ValuePlug::BatchEdits::g_activeCount;
+
+void ValuePlug::pushBatchEditScope()
+{
+	BatchEdits::local().pushScope();
+}
+
+void ValuePlug::popBatchEditScope()
+{
+	BatchEdits::local().popScope();
+}
 
 //////////////////////////////////////////////////////////////////////////
 // ValuePlug implementation
@@ -472,14 +1937,14 @@ IE_CORE_DEFINERUNTIMETYPED( ValuePlug );
 /// even creating the values before figuring out if we've already got them somewhere).
 ValuePlug::ValuePlug( const std::string &name, Direction direction,
 	IECore::ConstObjectPtr defaultValue, unsigned flags )
-	:	Plug( name, direction, flags ), m_defaultValue( defaultValue ), m_staticValue( defaultValue )
+	:	Plug( name, direction, flags ), m_defaultValue( defaultValue ), m_staticValue( defaultValue ), m_dirtyCount( newDirtyCount() )
 {
 	assert( m_defaultValue );
 	assert( m_staticValue );
 }
 
 ValuePlug::ValuePlug( const std::string &name, Direction direction, unsigned flags )
-	:	Plug( name, direction, flags ), m_defaultValue( NULL ), m_staticValue( NULL )
+	:	Plug( name, direction, flags ), m_defaultValue( NULL ), m_staticValue( NULL ), m_dirtyCount( newDirtyCount() )
 {
 	// We expect to have children added/removed, so arrange to deal with that
 	// appropriately. The other constructor above is for leaf plugs (this is
@@ -490,10 +1955,7 @@ ValuePlug::ValuePlug( const std::string &name, Direction direction, unsigned fla
 
 ValuePlug::~ValuePlug()
 {
-	// Clear hash cache, so that a newly created plug that just
-	// happens to reuse our address won't end up inadvertently also
-	// reusing our cache entries.
-	HashProcess::clearCache();
+	ComputeProcess::plugDestroyed( this );
 }
 
 bool ValuePlug::acceptsChild( const GraphComponent *potentialChild ) const
@@ -674,6 +2136,7 @@ IECore::MurmurHash ValuePlug::hash() const
 		return result;
 	}
 
+	BatchEdits::flushAll();
 	return HashProcess::hash( this );
 }
 
@@ -682,6 +2145,36 @@ void ValuePlug::hash( IECore::MurmurHash &h ) const
 	h.append( hash() );
 }
 
+namespace
+{
+
+struct HashCall
+{
+
+	HashCall( const ValuePlug *plug )
+		:	m_plug( plug )
+	{
+	}
+
+	IECore::MurmurHash operator()() const
+	{
+		return m_plug->hash();
+	}
+
+	private :
+
+		ConstValuePlugPtr m_plug;
+
+};
+
+} // namespace
+
+Future<IECore::MurmurHash>::Ptr ValuePlug::hashAsync() const
+{
+	BatchEdits::flushAll();
+	return Future<IECore::MurmurHash>::launch( HashCall( this ) );
+}
+
 const IECore::Object *ValuePlug::defaultObjectValue() const
 {
 	return m_defaultValue.get();
@@ -689,6 +2182,7 @@ const IECore::Object *ValuePlug::defaultObjectValue() const
 
 IECore::ConstObjectPtr ValuePlug::getObjectValue( const IECore::MurmurHash *precomputedHash ) const
 {
+	BatchEdits::flushAll();
 	return ComputeProcess::value( this, precomputedHash );
 }
 
@@ -715,7 +2209,17 @@ void ValuePlug::setObjectValue( IECore::ConstObjectPtr value )
 
 		if( value->isNotEqualTo( m_staticValue.get() ) )
 		{
-			Action::enact( new SetValueAction( this, value ) );
+			BatchEdits &batchEdits = BatchEdits::local();
+			if( batchEdits.active() )
+			{
+				// Signals, dirty propagation and undo are
+				// deferred until the BatchEditScope exits.
+				batchEdits.setValue( this, value );
+			}
+			else
+			{
+				Action::enact( new SetValueAction( this, value ) );
+			}
 		}
 
 		return;
@@ -757,10 +2261,13 @@ void ValuePlug::emitPlugSet()
 {
 	if( Node *n = node() )
 	{
+		// As in dirty propagation, we avoid the cost of emission
+		// when there are no slots to receive it.
+		Node::UnaryPlugSignal &signal = n->plugSetSignal();
 		ValuePlug *p = this;
-		while( p )
+		while( p && !signal.empty() )
 		{
-			n->plugSetSignal()( p );
+			signal( p );
 			p = p->parent<ValuePlug>();
 		}
 	}
@@ -779,10 +2286,9 @@ void ValuePlug::emitPlugSet()
 
 void ValuePlug::dirty()
 {
-	/// \todo We might want to investigate methods of doing a
-	/// more fine grained clearing of only the dirtied plugs,
-	/// rather than clearing the whole cache.
-	HashProcess::clearCache();
+	// Taking a new dirty count means that any previous
+	// entries in the hash cache are no longer accessible.
+	m_dirtyCount = newDirtyCount();
 }
 
 size_t ValuePlug::getCacheMemoryLimit()
@@ -800,7 +2306,72 @@ size_t ValuePlug::cacheMemoryUsage()
 	return ComputeProcess::cacheMemoryUsage();
 }
 
+ValuePlug::CacheMemoryUsageByPlug ValuePlug::cacheMemoryUsageByPlug()
+{
+	return ComputeProcess::cacheMemoryUsageByPlug();
+}
+
 void ValuePlug::clearCache()
 {
 	ComputeProcess::clearCache();
 }
+
+std::string ValuePlug::getPersistentCacheDirectory()
+{
+	return g_persistentCache.getDirectory();
+}
+
+void ValuePlug::setPersistentCacheDirectory( const std::string &directory )
+{
+	g_persistentCache.setDirectory( directory );
+}
+
+size_t ValuePlug::getPersistentCacheSizeLimit()
+{
+	return g_persistentCache.getSizeLimit();
+}
+
+void ValuePlug::setPersistentCacheSizeLimit( size_t bytes )
+{
+	g_persistentCache.setSizeLimit( bytes );
+}
+
+void ValuePlug::clearPersistentCache()
+{
+	g_persistentCache.clear();
+}
+
+size_t ValuePlug::getHashCacheSizeLimit()
+{
+	return HashProcess::getCacheSizeLimit();
+}
+
+void ValuePlug::setHashCacheSizeLimit( size_t maxEntries )
+{
+	HashProcess::setCacheSizeLimit( maxEntries );
+}
+
+size_t ValuePlug::hashCacheSize()
+{
+	return HashProcess::cacheSize();
+}
+
+void ValuePlug::clearHashCache()
+{
+	HashProcess::clearCache();
+}
+
+ValuePlug::HashCacheStatistics ValuePlug::hashCacheStatistics()
+{
+	return HashProcess::cacheStatistics();
+}
+
+void ValuePlug::resetHashCacheStatistics()
+{
+	HashProcess::resetCacheStatistics();
+}
+
+ValuePlug::HashCacheStatistics::HashCacheStatistics()
+	:	hits( 0 ), misses( 0 ), evictions( 0 )
+{
+}
@@ -37,6 +37,8 @@
 #include "boost/python.hpp"
 #include "boost/lexical_cast.hpp"
 
+#include "IECore/VectorTypedData.h"
+
 #include "Gaffer/Animation.h"
 
 #include "GafferBindings/DependencyNodeBinding.h"
@@ -75,6 +77,38 @@ std::string keyRepr( const Animation::Key &k )
 	);
 };
 
+IECore::FloatVectorDataPtr evaluateTimes( const Animation::CurvePlug &curve, const IECore::FloatVectorData *times )
+{
+	if( !times )
+	{
+		PyErr_SetString( PyExc_TypeError, "times must not be None" );
+		throw_error_already_set();
+	}
+
+	IECore::FloatVectorDataPtr result = new IECore::FloatVectorData;
+	curve.evaluate( times->readable(), result->writable() );
+	return result;
+}
+
+IECore::FloatVectorDataPtr evaluateCurves( object pythonCurves, float time )
+{
+	std::vector<const Animation::CurvePlug *> curves;
+	for( size_t i = 0, e = len( pythonCurves ); i < e; ++i )
+	{
+		const Animation::CurvePlug *curve = extract<const Animation::CurvePlug *>( pythonCurves[i] );
+		if( !curve )
+		{
+			PyErr_SetString( PyExc_TypeError, "curves must not contain None" );
+			throw_error_already_set();
+		}
+		curves.push_back( curve );
+	}
+
+	IECore::FloatVectorDataPtr result = new IECore::FloatVectorData;
+	Animation::evaluate( curves, time, result->writable() );
+	return result;
+}
+
 class CurvePlugSerialiser : public ValuePlugSerialiser
 {
 
@@ -107,6 +141,8 @@ void GafferBindings::bindAnimation()
 		.staticmethod( "isAnimated" )
 		.def( "acquire", &Animation::acquire, return_value_policy<CastToIntrusivePtr>() )
 		.staticmethod( "acquire" )
+		.def( "evaluate", &evaluateCurves )
+		.staticmethod( "evaluate" )
 	;
 
 	enum_<Animation::Type>( "Type" )
@@ -150,7 +186,8 @@ void GafferBindings::bindAnimation()
 		.def( "closestKey", &Animation::CurvePlug::closestKey )
 		.def( "previousKey", &Animation::CurvePlug::previousKey )
 		.def( "nextKey", &Animation::CurvePlug::nextKey )
-		.def( "evaluate", &Animation::CurvePlug::evaluate )
+		.def( "evaluate", (float (Animation::CurvePlug::*)( float ) const)&Animation::CurvePlug::evaluate )
+		.def( "evaluate", &evaluateTimes )
 		// Adjusting the name so that it correctly reflects
 		// the nesting, and can be used by the PlugSerialiser.
 		.attr( "__name__" ) = "Animation.CurvePlug"
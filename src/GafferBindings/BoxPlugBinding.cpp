@@ -43,6 +43,7 @@
 
 #include "GafferBindings/PlugBinding.h"
 #include "GafferBindings/BoxPlugBinding.h"
+#include "GafferBindings/FutureBinding.h"
 
 using namespace boost::python;
 using namespace GafferBindings;
@@ -92,6 +93,7 @@ static void bind()
 		.def( "maxValue", &T::maxValue )
 		.def( "setValue", &T::setValue )
 		.def( "getValue", &getValue<T> )
+		.def( "getValueAsync", &GafferBindings::getValueAsync<T> )
 	;
 }
 
@@ -45,6 +45,7 @@
 
 #include "GafferBindings/ValuePlugBinding.h"
 #include "GafferBindings/CompoundNumericPlugBinding.h"
+#include "GafferBindings/FutureBinding.h"
 
 using namespace boost::python;
 using namespace GafferBindings;
@@ -146,6 +147,7 @@ void bind()
 		.def( "maxValue", &T::maxValue )
 		.def( "setValue", &setValue<T> )
 		.def( "getValue", &getValue<T> )
+		.def( "getValueAsync", &GafferBindings::getValueAsync<T> )
 		.def( "canGang", &T::canGang )
 		.def( "gang", &gang<T> )
 		.def( "isGanged", &T::isGanged )
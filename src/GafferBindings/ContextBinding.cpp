@@ -35,6 +35,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "boost/python.hpp"
+#include "boost/python/suite/indexing/container_utils.hpp"
 
 #include "IECorePython/RefCountedBinding.h"
 
@@ -125,6 +126,18 @@ list names( const Context &context )
 	return result;
 }
 
+IECore::MurmurHash hash( const Context &context )
+{
+	return context.hash();
+}
+
+IECore::MurmurHash hashNames( const Context &context, object pythonNames )
+{
+	std::vector<IECore::InternedString> names;
+	boost::python::container_utils::extend_container( names, pythonNames );
+	return context.hash( names );
+}
+
 struct ChangedSlotCaller
 {
 	boost::signals::detail::unusable operator()( boost::python::object slot, ConstContextPtr context, const IECore::InternedString &name )
@@ -150,6 +163,11 @@ ContextPtr current()
 
 void GafferBindings::bindContext()
 {
+	class_<Canceller, boost::noncopyable>( "Canceller" )
+		.def( "cancel", &Canceller::cancel )
+		.def( "cancelled", &Canceller::cancelled )
+	;
+
 	IECorePython::RefCountedClass<Context, IECore::RefCounted> contextClass( "Context" );
 	scope s = contextClass;
 
@@ -171,6 +189,7 @@ void GafferBindings::bindContext()
 	contextClass
 		.def( init<>() )
 		.def( init<const Context &, Context::Ownership>( ( arg( "other" ), arg( "ownership" ) = Context::Copied ) ) )
+		.def( init<const Context &, const Canceller &, Context::Ownership>( ( arg( "other" ), arg( "canceller" ), arg( "ownership" ) = Context::Copied ) )[ with_custodian_and_ward<1,3>() ] )
 		.def( "setFrame", &setFrame )
 		.def( "getFrame", &Context::getFrame )
 		.def( "setFramesPerSecond", &setFramesPerSecond )
@@ -205,7 +224,9 @@ void GafferBindings::bindContext()
 		.def( "names", &names )
 		.def( "keys", &names )
 		.def( "changedSignal", &Context::changedSignal, return_internal_reference<1>() )
-		.def( "hash", &Context::hash )
+		.def( "canceller", &Context::canceller, return_value_policy<reference_existing_object>() )
+		.def( "hash", &hash )
+		.def( "hash", &hashNames )
 		.def( self == self )
 		.def( self != self )
 		.def( "substitute", &Context::substitute, ( arg( "input" ), arg( "substitutions" ) = Context::AllSubstitutions ) )
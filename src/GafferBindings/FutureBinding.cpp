@@ -0,0 +1,91 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2016, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "boost/python.hpp"
+
+#include "IECorePython/ScopedGILRelease.h"
+
+#include "GafferBindings/FutureBinding.h"
+
+using namespace boost::python;
+using namespace Gaffer;
+using namespace GafferBindings;
+
+PythonFuture::PythonFuture( Gaffer::FutureBasePtr future, ResultFunction resultFunction )
+	:	m_future( future ), m_resultFunction( resultFunction )
+{
+}
+
+bool PythonFuture::done() const
+{
+	return m_future->done();
+}
+
+void PythonFuture::wait() const
+{
+	// The work may need to enter Python on another thread,
+	// so we mustn't hold the GIL while waiting for it.
+	IECorePython::ScopedGILRelease gilRelease;
+	m_future->wait();
+}
+
+void PythonFuture::cancel()
+{
+	m_future->cancel();
+}
+
+bool PythonFuture::cancelled() const
+{
+	return m_future->cancelled();
+}
+
+boost::python::object PythonFuture::result() const
+{
+	wait();
+	return m_resultFunction( m_future.get() );
+}
+
+void GafferBindings::bindFuture()
+{
+	class_<PythonFuture>( "Future", no_init )
+		.def( "done", &PythonFuture::done )
+		.def( "wait", &PythonFuture::wait )
+		.def( "cancel", &PythonFuture::cancel )
+		.def( "cancelled", &PythonFuture::cancelled )
+		.def( "result", &PythonFuture::result )
+	;
+}
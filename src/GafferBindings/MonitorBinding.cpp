@@ -116,6 +116,37 @@ dict allStatistics( T &m )
 	return result;
 }
 
+list events( const PerformanceMonitor &m )
+{
+	const PerformanceMonitor::Events &e = m.events();
+	list result;
+	for( PerformanceMonitor::Events::const_iterator it = e.begin(), eIt = e.end(); it != eIt; ++it )
+	{
+		result.append( *it );
+	}
+	return result;
+}
+
+PlugPtr eventPlug( const PerformanceMonitor::Event &e )
+{
+	return boost::const_pointer_cast<Plug>( e.plug );
+}
+
+std::string eventType( const PerformanceMonitor::Event &e )
+{
+	return e.type.string();
+}
+
+boost::chrono::nanoseconds::rep eventStart( const PerformanceMonitor::Event &e )
+{
+	return e.start.count();
+}
+
+boost::chrono::nanoseconds::rep eventEnd( const PerformanceMonitor::Event &e )
+{
+	return e.end.count();
+}
+
 list contextMonitorVariableNames( const ContextMonitor::Statistics &s )
 {
 	std::vector<IECore::InternedString> names = s.variableNames();
@@ -167,6 +198,9 @@ void GafferBindings::bindMonitor()
 				arg( "maxLines" ) = 50
 			)
 		);
+
+		def( "formatChromeTrace", &formatChromeTrace, ( arg( "monitor" ) ) );
+		def( "formatFlameGraph", &formatFlameGraph, ( arg( "monitor" ) ) );
 	}
 
 	class_<Monitor, boost::noncopyable>( "Monitor", no_init )
@@ -177,9 +211,23 @@ void GafferBindings::bindMonitor()
 	;
 
 	{
-		scope s = class_<PerformanceMonitor, bases<Monitor>, boost::noncopyable >( "PerformanceMonitor" )
+		scope s = class_<PerformanceMonitor, bases<Monitor>, boost::noncopyable >( "PerformanceMonitor", no_init )
+			.def( init<bool, size_t>( ( arg( "recordEvents" ) = false, arg( "sampleInterval" ) = 1 ) ) )
 			.def( "allStatistics", &allStatistics<PerformanceMonitor> )
 			.def( "plugStatistics", &PerformanceMonitor::plugStatistics, return_value_policy<copy_const_reference>() )
+			.def( "getRecordEvents", &PerformanceMonitor::getRecordEvents )
+			.def( "getSampleInterval", &PerformanceMonitor::getSampleInterval )
+			.def( "events", &events )
+		;
+
+		class_<PerformanceMonitor::Event>( "Event", no_init )
+			.add_property( "plug", &eventPlug )
+			.add_property( "type", &eventType )
+			.def_readonly( "processId", &PerformanceMonitor::Event::processId )
+			.def_readonly( "parentProcessId", &PerformanceMonitor::Event::parentProcessId )
+			.def_readonly( "thread", &PerformanceMonitor::Event::thread )
+			.add_property( "start", &eventStart )
+			.add_property( "end", &eventEnd )
 		;
 
 		class_<PerformanceMonitor::Statistics>( "Statistics" )
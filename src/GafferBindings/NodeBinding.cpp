@@ -84,6 +84,41 @@ struct BinaryPlugSlotCaller
 	}
 };
 
+struct PlugVectorSignalCaller
+{
+	static void call( Node::PlugVectorSignal &s, boost::python::list plugs )
+	{
+		std::vector<Plug *> plugVector;
+		for( boost::python::ssize_t i = 0, e = boost::python::len( plugs ); i < e; ++i )
+		{
+			plugVector.push_back( extract<Plug *>( plugs[i] ) );
+		}
+		IECorePython::ScopedGILRelease gilRelease;
+		s( plugVector );
+	}
+};
+
+struct PlugVectorSlotCaller
+{
+	boost::signals::detail::unusable operator()( boost::python::object slot, const std::vector<Plug *> &plugs )
+	{
+		try
+		{
+			boost::python::list pythonPlugs;
+			for( std::vector<Plug *>::const_iterator it = plugs.begin(), eIt = plugs.end(); it != eIt; ++it )
+			{
+				pythonPlugs.append( PlugPtr( *it ) );
+			}
+			slot( pythonPlugs );
+		}
+		catch( const error_already_set &e )
+		{
+			PyErr_PrintEx( 0 ); // clears the error status
+		}
+		return boost::signals::detail::unusable();
+	}
+};
+
 struct ErrorSlotCaller
 {
 	boost::signals::detail::unusable operator()( boost::python::object slot, const Plug *plug, const Plug *source, const std::string &error )
@@ -158,11 +193,13 @@ void GafferBindings::bindNode()
 		.def( "plugInputChangedSignal", &Node::plugInputChangedSignal, return_internal_reference<1>() )
 		.def( "plugFlagsChangedSignal", &Node::plugFlagsChangedSignal, return_internal_reference<1>() )
 		.def( "plugDirtiedSignal", &Node::plugDirtiedSignal, return_internal_reference<1>() )
+		.def( "plugsDirtiedSignal", &Node::plugsDirtiedSignal, return_internal_reference<1>() )
 		.def( "errorSignal", (Node::ErrorSignal &(Node::*)())&Node::errorSignal, return_internal_reference<1>() )
 	;
 
 	SignalClass<Node::UnaryPlugSignal, DefaultSignalCaller<Node::UnaryPlugSignal>, UnaryPlugSlotCaller >( "UnaryPlugSignal" );
 	SignalClass<Node::BinaryPlugSignal, DefaultSignalCaller<Node::BinaryPlugSignal>, BinaryPlugSlotCaller >( "BinaryPlugSignal" );
+	SignalClass<Node::PlugVectorSignal, PlugVectorSignalCaller, PlugVectorSlotCaller >( "PlugVectorSignal" );
 	SignalClass<Node::ErrorSignal, DefaultSignalCaller<Node::ErrorSignal>, ErrorSlotCaller >( "ErrorSignal" );
 
 	Serialisation::registerSerialiser( Node::staticTypeId(), new NodeSerialiser() );
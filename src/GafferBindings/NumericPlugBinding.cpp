@@ -46,6 +46,7 @@
 
 #include "GafferBindings/NumericPlugBinding.h"
 #include "GafferBindings/ValuePlugBinding.h"
+#include "GafferBindings/FutureBinding.h"
 
 using namespace boost::python;
 using namespace GafferBindings;
@@ -96,6 +97,7 @@ void bind()
 		.def( "maxValue", &T::maxValue )
 		.def( "setValue", setValue<T> )
 		.def( "getValue", &getValue<T>, ( boost::python::arg( "_precomputedHash" ) = boost::python::object() ) )
+		.def( "getValueAsync", &GafferBindings::getValueAsync<T> )
 	;
 
 }
@@ -37,6 +37,10 @@
 
 #include "boost/python.hpp" // must be the first include
 
+#include <limits>
+
+#include "boost/unordered_map.hpp"
+
 #include "IECore/MessageHandler.h"
 
 #include "IECorePython/ScopedGILLock.h"
@@ -48,6 +52,9 @@
 #include "Gaffer/StandardSet.h"
 #include "Gaffer/CompoundDataPlug.h"
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/NumericPlug.h"
+#include "Gaffer/TypedPlug.h"
+#include "Gaffer/ThreadBudget.h"
 
 #include "GafferBindings/ScriptNodeBinding.h"
 #include "GafferBindings/SignalBinding.h"
@@ -98,58 +105,477 @@ const std::string formattedErrorContext( int lineNumber, const std::string &cont
 	);
 }
 
-// Execute the script one top level statement at a time,
-// reporting errors that occur, but otherwise continuing
-// with execution.
-bool tolerantExec( const char *pythonScript, boost::python::object globals, boost::python::object locals, const std::string &context )
+// Native execution of simple statements
+// =====================================
+//
+// Serialisations consist mostly of statements such as
+// `__children["n"]["p"].setValue( 1 )` and `a["in"].setInput( b["out"] )`.
+// Compiling and evaluating each of these via the interpreter dominates
+// the time taken to load large scripts, so we recognise them in the
+// parsed AST and execute them directly. Anything we don't recognise,
+// or which might behave differently if executed natively (for instance
+// because it would raise an error) is left for Python to execute as
+// usual.
+
+const char *identifierString( identifier i )
+{
+	return PyString_Check( i ) ? PyString_AsString( i ) : NULL;
+}
+
+// Returns the GraphComponent referred to by expressions such as
+// `parent`, `parent["n"]["p"]` and `__children["n"]["in"][0]`, or
+// NULL if the expression is of any other form, or doesn't refer to
+// an existing GraphComponent.
+GraphComponent *nativeGraphComponent( expr_ty e, PyObject *locals )
+{
+	if( e->kind == Name_kind )
+	{
+		PyObject *o = PyDict_GetItem( locals, e->v.Name.id );
+		if( !o )
+		{
+			return NULL;
+		}
+		boost::python::extract<GraphComponent *> graphComponent( o );
+		return graphComponent.check() ? graphComponent() : NULL;
+	}
+
+	if( e->kind != Subscript_kind || e->v.Subscript.slice->kind != Index_kind )
+	{
+		return NULL;
+	}
+
+	const expr_ty index = e->v.Subscript.slice->v.Index.value;
+	const expr_ty value = e->v.Subscript.value;
+
+	if( value->kind == Name_kind && index->kind == Str_kind )
+	{
+		// Lookup in the `__children` dictionary.
+		PyObject *o = PyDict_GetItem( locals, value->v.Name.id );
+		if( o && PyDict_Check( o ) )
+		{
+			PyObject *child = PyDict_GetItem( o, index->v.Str.s );
+			if( !child )
+			{
+				return NULL;
+			}
+			boost::python::extract<GraphComponent *> graphComponent( child );
+			return graphComponent.check() ? graphComponent() : NULL;
+		}
+	}
+
+	GraphComponent *parent = nativeGraphComponent( value, locals );
+	if( !parent )
+	{
+		return NULL;
+	}
+
+	if( index->kind == Str_kind )
+	{
+		const char *name = PyString_Check( index->v.Str.s ) ? PyString_AsString( index->v.Str.s ) : NULL;
+		return name ? parent->getChild<GraphComponent>( name ) : NULL;
+	}
+	else if( index->kind == Num_kind && PyInt_Check( index->v.Num.n ) )
+	{
+		long i = PyInt_AsLong( index->v.Num.n );
+		const long size = parent->children().size();
+		i = i < 0 ? i + size : i;
+		return i >= 0 && i < size ? parent->getChild<GraphComponent>( i ) : NULL;
+	}
+
+	return NULL;
+}
+
+// Returns the number from a literal such as `1` or `-1.5`, or NULL.
+// Note that the parser folds negation into numeric literals for us.
+PyObject *numberLiteral( expr_ty e )
+{
+	return e->kind == Num_kind ? e->v.Num.n : NULL;
+}
+
+bool nativeSetValue( ValuePlug *plug, expr_ty value )
+{
+	if( !plug->settable() )
+	{
+		return false;
+	}
+
+	if( BoolPlug *boolPlug = IECore::runTimeCast<BoolPlug>( plug ) )
+	{
+		if( value->kind != Name_kind )
+		{
+			return false;
+		}
+		const char *name = identifierString( value->v.Name.id );
+		if( !name || ( strcmp( name, "True" ) && strcmp( name, "False" ) ) )
+		{
+			return false;
+		}
+		IECorePython::ScopedGILRelease gilRelease;
+		boolPlug->setValue( !strcmp( name, "True" ) );
+		return true;
+	}
+	else if( IntPlug *intPlug = IECore::runTimeCast<IntPlug>( plug ) )
+	{
+		PyObject *n = numberLiteral( value );
+		if( !n || !PyInt_Check( n ) )
+		{
+			return false;
+		}
+		const long v = PyInt_AsLong( n );
+		if( v < std::numeric_limits<int>::min() || v > std::numeric_limits<int>::max() )
+		{
+			return false;
+		}
+		IECorePython::ScopedGILRelease gilRelease;
+		intPlug->setValue( v );
+		return true;
+	}
+	else if( FloatPlug *floatPlug = IECore::runTimeCast<FloatPlug>( plug ) )
+	{
+		PyObject *n = numberLiteral( value );
+		if( !n || !( PyFloat_Check( n ) || PyInt_Check( n ) ) )
+		{
+			return false;
+		}
+		const double v = PyFloat_Check( n ) ? PyFloat_AsDouble( n ) : PyInt_AsLong( n );
+		IECorePython::ScopedGILRelease gilRelease;
+		floatPlug->setValue( v );
+		return true;
+	}
+	else if( StringPlug *stringPlug = IECore::runTimeCast<StringPlug>( plug ) )
+	{
+		if( value->kind != Str_kind || !PyString_Check( value->v.Str.s ) )
+		{
+			return false;
+		}
+		const std::string v( PyString_AsString( value->v.Str.s ), PyString_Size( value->v.Str.s ) );
+		IECorePython::ScopedGILRelease gilRelease;
+		stringPlug->setValue( v );
+		return true;
+	}
+
+	return false;
+}
+
+bool nativeSetInput( Plug *plug, expr_ty value, PyObject *locals )
+{
+	Plug *input = NULL;
+	if( value->kind == Name_kind && identifierString( value->v.Name.id ) && !strcmp( identifierString( value->v.Name.id ), "None" ) )
+	{
+		input = NULL;
+	}
+	else
+	{
+		input = IECore::runTimeCast<Plug>( nativeGraphComponent( value, locals ) );
+		if( !input )
+		{
+			return false;
+		}
+	}
+
+	if( !plug->acceptsInput( input ) )
+	{
+		// Leave it to Python to report the error.
+		return false;
+	}
+
+	IECorePython::ScopedGILRelease gilRelease;
+	plug->setInput( input );
+	return true;
+}
+
+bool nativeAddChild( GraphComponent *parent, expr_ty value, PyObject *locals )
+{
+	GraphComponent *child = nativeGraphComponent( value, locals );
+	if( !child || child == parent || child->isAncestorOf( parent ) || !parent->acceptsChild( child ) || !child->acceptsParent( parent ) )
+	{
+		return false;
+	}
+
+	IECorePython::ScopedGILRelease gilRelease;
+	parent->addChild( child );
+	return true;
+}
+
+// Returns true if the statement was executed natively, and false if it
+// must be executed by Python. May throw if native execution fails.
+bool nativeExec( stmt_ty statement, PyObject *locals )
+{
+	if( statement->kind != Expr_kind )
+	{
+		return false;
+	}
+
+	const expr_ty call = statement->v.Expr.value;
+	if(
+		call->kind != Call_kind ||
+		call->v.Call.func->kind != Attribute_kind ||
+		asdl_seq_LEN( call->v.Call.args ) != 1 ||
+		asdl_seq_LEN( call->v.Call.keywords ) != 0 ||
+		call->v.Call.starargs ||
+		call->v.Call.kwargs
+	)
+	{
+		return false;
+	}
+
+	const char *method = identifierString( call->v.Call.func->v.Attribute.attr );
+	if( !method )
+	{
+		return false;
+	}
+
+	GraphComponent *target = nativeGraphComponent( call->v.Call.func->v.Attribute.value, locals );
+	if( !target )
+	{
+		return false;
+	}
+
+	const expr_ty argument = (expr_ty)asdl_seq_GET( call->v.Call.args, 0 );
+	if( !strcmp( method, "setValue" ) )
+	{
+		ValuePlug *plug = IECore::runTimeCast<ValuePlug>( target );
+		return plug && nativeSetValue( plug, argument );
+	}
+	else if( !strcmp( method, "setInput" ) )
+	{
+		Plug *plug = IECore::runTimeCast<Plug>( target );
+		return plug && nativeSetInput( plug, argument, locals );
+	}
+	else if( !strcmp( method, "addChild" ) )
+	{
+		return nativeAddChild( target, argument, locals );
+	}
+
+	return false;
+}
+
+// Parsed scripts
+// ==============
+//
+// Parsing and compiling a serialisation accounts for a significant
+// proportion of the time spent executing it. When the same file is
+// executed repeatedly, as is the case for a reference instantiated
+// many times in a script, we reuse the parse from the first execution,
+// and each statement is compiled at most once.
+
+struct ParsedScript
 {
+
+	ParsedScript( const std::string &serialisation )
+		:	arena( PyArena_New(), PyArena_Free )
+	{
+		// Parse the whole script, getting an abstract syntax tree for a
+		// module which would execute everything.
+		flags.cf_flags = 0;
+		futureLineNumber = 0;
+		module = PyParser_ASTFromString(
+			serialisation.c_str(),
+			"<string>",
+			Py_file_input,
+			&flags,
+			arena.get()
+		);
+
+		if( !module )
+		{
+			return;
+		}
+
+		assert( module->kind == Module_kind );
+
+		// We compile each statement as a module of its own, so `__future__`
+		// imports wouldn't carry over to the statements that follow. Instead
+		// we gather the features for the whole module up front, and compile
+		// every statement with them, as a single exec of the module would.
+		PyFutureFeatures *future = PyFuture_FromAST( module, "<string>" );
+		if( !future )
+		{
+			module = NULL;
+			return;
+		}
+		flags.cf_flags |= future->ff_features & PyCF_MASK;
+		futureLineNumber = future->ff_lineno;
+		PyObject_Free( future );
+
+		code.resize( asdl_seq_LEN( module->v.Module.body ) );
+	}
+
+	size_t numStatements() const
+	{
+		return code.size();
+	}
+
+	stmt_ty statement( size_t i ) const
+	{
+		return (stmt_ty)asdl_seq_GET( module->v.Module.body, i );
+	}
+
+	// Returns the code for statement i, compiling it if necessary.
+	PyCodeObject *statementCode( size_t i )
+	{
+		if( !code[i] )
+		{
+			// Compiled on its own, a `__future__` import would always
+			// be at the start of its module, so we must check the
+			// placement ourselves.
+			const stmt_ty s = statement( i );
+			if(
+				s->kind == ImportFrom_kind && s->v.ImportFrom.module &&
+				identifierString( s->v.ImportFrom.module ) &&
+				!strcmp( identifierString( s->v.ImportFrom.module ), "__future__" ) &&
+				s->lineno > futureLineNumber
+			)
+			{
+				PyErr_SetString( PyExc_SyntaxError, "from __future__ imports must occur at the beginning of the file" );
+				PyErr_SyntaxLocation( "<string>", s->lineno );
+				boost::python::throw_error_already_set();
+			}
+			// Make a new module containing just this one statement.
+			asdl_seq *newBody = asdl_seq_new( 1, arena.get() );
+			asdl_seq_SET( newBody, 0, statement( i ) );
+			mod_ty newModule = Module(
+				newBody,
+				arena.get()
+			);
+			// And compile it.
+			PyCompilerFlags statementFlags = flags;
+			code[i] = boost::python::handle<PyCodeObject>( PyAST_Compile( newModule, "<string>", &statementFlags, arena.get() ) );
+		}
+		return code[i].get();
+	}
+
 	// The python parsing framework uses an arena to simplify memory allocation,
 	// which is handy for us, since we're going to manipulate the AST a little.
-	boost::shared_ptr<PyArena> arena( PyArena_New(), PyArena_Free );
-
-	// Parse the whole script, getting an abstract syntax tree for a
-	// module which would execute everything.
-	mod_ty mod = PyParser_ASTFromString(
-		pythonScript,
-		"<string>",
-		Py_file_input,
-		NULL,
-		arena.get()
-	);
+	boost::shared_ptr<PyArena> arena;
+	// NULL if parsing failed.
+	mod_ty module;
+	// The `__future__` features in effect for the module, and
+	// the line number of the last valid `__future__` import.
+	PyCompilerFlags flags;
+	int futureLineNumber;
+	std::vector<boost::python::handle<PyCodeObject> > code;
 
-	assert( mod->kind == Module_kind );
+};
+
+typedef boost::shared_ptr<ParsedScript> ParsedScriptPtr;
+
+// Cache of parsed scripts, keyed by serialisation. Access is
+// protected by the GIL. We limit the cache by the memory used by the
+// scripts it holds, clearing it when that is exceeded. Python doesn't
+// report the size of an AST arena, so we estimate it from the size of
+// the serialisation. Measuring typical serialisations showed the AST and
+// compiled code to occupy between 12 and 14 times the size of the source,
+// so we use the upper end of that range.
+typedef boost::unordered_map<std::string, ParsedScriptPtr> ParsedScriptCache;
+ParsedScriptCache g_parsedScriptCache;
+size_t g_parsedScriptCacheSize = 0;
+const size_t g_maxParsedScriptCacheSize = 256 * 1024 * 1024;
+const size_t g_parsedScriptSizeMultiplier = 14;
+
+ParsedScriptPtr parsedScript( const std::string &serialisation, bool cache )
+{
+	if( cache )
+	{
+		ParsedScriptCache::const_iterator it = g_parsedScriptCache.find( serialisation );
+		if( it != g_parsedScriptCache.end() )
+		{
+			return it->second;
+		}
+	}
+
+	ParsedScriptPtr result( new ParsedScript( serialisation ) );
+	// The key is a copy of the serialisation, so we charge for that too.
+	const size_t size = serialisation.size() * ( g_parsedScriptSizeMultiplier + 1 );
+	if( cache && result->module && size <= g_maxParsedScriptCacheSize )
+	{
+		if( g_parsedScriptCacheSize + size > g_maxParsedScriptCacheSize )
+		{
+			g_parsedScriptCache.clear();
+			g_parsedScriptCacheSize = 0;
+		}
+		g_parsedScriptCache[serialisation] = result;
+		g_parsedScriptCacheSize += size;
+	}
+
+	return result;
+}
+
+// Execute the script one top level statement at a time, so that
+// we can execute simple statements natively. If continueOnError
+// is true, errors are reported and execution continues with the
+// next statement, otherwise the first error is thrown.
+bool executeStatements( ParsedScript &script, boost::python::object globals, boost::python::object locals, const std::string &context, bool continueOnError )
+{
+	if( !script.module )
+	{
+		int lineNumber = 0;
+		std::string message = ExceptionAlgo::formatPythonException( /* withTraceback = */ false, &lineNumber );
+		if( !continueOnError )
+		{
+			throw IECore::Exception( formattedErrorContext( lineNumber, context ) + " : " + message );
+		}
+		IECore::msg( IECore::Msg::Error, formattedErrorContext( lineNumber, context ), message );
+		return true;
+	}
 
 	// Loop over the top-level statements in the module body,
 	// executing one at a time.
 	bool result = false;
-	int numStatements = asdl_seq_LEN( mod->v.Module.body );
-	for( int i=0; i<numStatements; ++i )
-	{
-		// Make a new module containing just this one statement.
-		asdl_seq *newBody = asdl_seq_new( 1, arena.get() );
-		asdl_seq_SET( newBody, 0, asdl_seq_GET( mod->v.Module.body, i ) );
-		mod_ty newModule = Module(
-			newBody,
-			arena.get()
-		);
+	for( size_t i = 0, e = script.numStatements(); i < e; ++i )
+	{
+		stmt_ty statement = script.statement( i );
 
-		// Compile it.
-		boost::python::handle<PyCodeObject> code( PyAST_Compile( newModule, "<string>", NULL, arena.get() ) );
+		try
+		{
+			if( nativeExec( statement, locals.ptr() ) )
+			{
+				continue;
+			}
+		}
+		catch( const std::exception &e )
+		{
+			if( !continueOnError )
+			{
+				throw IECore::Exception( formattedErrorContext( statement->lineno, context ) + " : " + e.what() );
+			}
+			IECore::msg( IECore::Msg::Error, formattedErrorContext( statement->lineno, context ), e.what() );
+			result = true;
+			continue;
+		}
 
-		// And execute it.
-		boost::python::handle<> v( boost::python::allow_null(
-			PyEval_EvalCode(
-				code.get(),
-				globals.ptr(),
-				locals.ptr()
-			)
-		) );
+		// Execute via Python. Compilation errors are reported
+		// in the same way as errors during execution.
+		boost::python::handle<> v;
+		PyCodeObject *code = NULL;
+		try
+		{
+			code = script.statementCode( i );
+		}
+		catch( const boost::python::error_already_set & )
+		{
+		}
+
+		if( code )
+		{
+			v = boost::python::handle<>( boost::python::allow_null(
+				PyEval_EvalCode(
+					code,
+					globals.ptr(),
+					locals.ptr()
+				)
+			) );
+		}
 
 		// Report any errors.
 		if( v == NULL)
 		{
 			int lineNumber = 0;
 			std::string message = ExceptionAlgo::formatPythonException( /* withTraceback = */ false, &lineNumber );
+			if( !continueOnError )
+			{
+				throw IECore::Exception( formattedErrorContext( lineNumber, context ) + " : " + message );
+			}
 			IECore::msg( IECore::Msg::Error, formattedErrorContext( lineNumber, context ), message );
 			result = true;
 		}
@@ -212,24 +638,10 @@ bool execute( ScriptNode *script, const std::string &serialisation, Node *parent
 	try
 	{
 		boost::python::object e = executionDict( script, parent );
-
-		if( !continueOnError )
-		{
-			try
-			{
-				exec( serialisation.c_str(), e, e );
-			}
-			catch( boost::python::error_already_set &e )
-			{
-				int lineNumber = 0;
-				std::string message = ExceptionAlgo::formatPythonException( /* withTraceback = */ false, &lineNumber );
-				throw IECore::Exception( formattedErrorContext( lineNumber, context ) + " : " + message );
-			}
-		}
-		else
-		{
-			result = tolerantExec( serialisation.c_str(), e, e, context );
-		}
+		// We only cache scripts executed from files, since those are
+		// the ones likely to be executed repeatedly.
+		ParsedScriptPtr parsed = parsedScript( serialisation, /* cache = */ !context.empty() );
+		result = executeStatements( *parsed, e, e, context, continueOnError );
 	}
 	catch( boost::python::error_already_set &e )
 	{
@@ -296,6 +708,11 @@ ContextPtr context( ScriptNode &s )
 	return s.context();
 }
 
+ThreadBudgetPtr getThreadBudget( ScriptNode &s )
+{
+	return s.getThreadBudget();
+}
+
 ApplicationRootPtr applicationRoot( ScriptNode &s )
 {
 	return s.applicationRoot();
@@ -387,6 +804,8 @@ void GafferBindings::bindScriptNode()
 		.def( "save", &ScriptNode::save )
 		.def( "load", &ScriptNode::load, ( boost::python::arg( "continueOnError" ) = false ) )
 		.def( "context", &context )
+		.def( "setThreadBudget", &ScriptNode::setThreadBudget )
+		.def( "getThreadBudget", &getThreadBudget )
 	;
 
 	SignalClass<ScriptNode::ActionSignal, DefaultSignalCaller<ScriptNode::ActionSignal>, ActionSlotCaller>( "ActionSignal" );
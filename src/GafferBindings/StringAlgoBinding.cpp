@@ -54,6 +54,11 @@ void bindStringAlgo()
 	def( "match", (bool (*)( const char *, const char * ))&Gaffer::StringAlgo::match );
 	def( "matchMultiple", (bool (*)( const char *, const char * ))&Gaffer::StringAlgo::matchMultiple );
 	def( "hasWildcards", (bool (*)( const char * ))&Gaffer::StringAlgo::hasWildcards );
+
+	class_<Gaffer::StringAlgo::CompiledMatchPattern>( "CompiledMatchPattern", init<>() )
+		.def( init<const std::string &, bool>( ( arg( "pattern" ), arg( "multiple" ) = false ) ) )
+		.def( "match", (bool (Gaffer::StringAlgo::CompiledMatchPattern::*)( const char * ) const)&Gaffer::StringAlgo::CompiledMatchPattern::match )
+	;
 }
 
 } // namespace GafferBindings
@@ -40,6 +40,7 @@
 
 #include "GafferBindings/ValuePlugBinding.h"
 #include "GafferBindings/StringPlugBinding.h"
+#include "GafferBindings/FutureBinding.h"
 
 using namespace boost::python;
 using namespace Gaffer;
@@ -143,6 +144,7 @@ void GafferBindings::bindStringPlug()
 		.def( "defaultValue", &StringPlug::defaultValue, return_value_policy<boost::python::copy_const_reference>() )
 		.def( "setValue", &setValue )
 		.def( "getValue", &getValue, ( boost::python::arg( "_precomputedHash" ) = object() ) )
+		.def( "getValueAsync", &GafferBindings::getValueAsync<StringPlug> )
 	;
 
 	Serialisation::registerSerialiser( StringPlug::staticTypeId(), new StringPlugSerialiser );
@@ -0,0 +1,114 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2016, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "boost/python.hpp"
+
+#include "IECorePython/RefCountedBinding.h"
+#include "IECorePython/ScopedGILLock.h"
+#include "IECorePython/ScopedGILRelease.h"
+
+#include "Gaffer/ThreadBudget.h"
+
+#include "GafferBindings/ThreadBudgetBinding.h"
+
+using namespace boost::python;
+using namespace Gaffer;
+using namespace GafferBindings;
+
+namespace
+{
+
+// Calls a Python callable from within the budget's arena. The arena
+// may run us on a thread other than the caller's, so any Python error
+// is fetched here and restored by the caller in `execute()` below.
+struct PythonCall
+{
+
+	PythonCall( object &callable, PyObject *&errorType, PyObject *&errorValue, PyObject *&errorTraceback )
+		:	m_callable( callable ), m_errorType( errorType ), m_errorValue( errorValue ), m_errorTraceback( errorTraceback )
+	{
+	}
+
+	void operator()() const
+	{
+		IECorePython::ScopedGILLock gilLock;
+		try
+		{
+			m_callable();
+		}
+		catch( const error_already_set &e )
+		{
+			PyErr_Fetch( &m_errorType, &m_errorValue, &m_errorTraceback );
+		}
+	}
+
+	private :
+
+		object &m_callable;
+		PyObject *&m_errorType;
+		PyObject *&m_errorValue;
+		PyObject *&m_errorTraceback;
+
+};
+
+void execute( ThreadBudget &budget, object callable )
+{
+	PyObject *errorType = NULL;
+	PyObject *errorValue = NULL;
+	PyObject *errorTraceback = NULL;
+	{
+		IECorePython::ScopedGILRelease gilRelease;
+		budget.execute( PythonCall( callable, errorType, errorValue, errorTraceback ) );
+	}
+
+	if( errorType )
+	{
+		PyErr_Restore( errorType, errorValue, errorTraceback );
+		throw_error_already_set();
+	}
+}
+
+} // namespace
+
+void GafferBindings::bindThreadBudget()
+{
+	IECorePython::RefCountedClass<ThreadBudget, IECore::RefCounted>( "ThreadBudget" )
+		.def( init<int>( ( arg( "maxThreads" ) = 0 ) ) )
+		.def( "maxThreads", &ThreadBudget::maxThreads )
+		.def( "execute", &execute )
+	;
+}
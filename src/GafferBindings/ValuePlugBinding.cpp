@@ -47,6 +47,7 @@
 #include "GafferBindings/ValuePlugBinding.h"
 #include "GafferBindings/PlugBinding.h"
 #include "GafferBindings/Serialisation.h"
+#include "GafferBindings/FutureBinding.h"
 
 using namespace boost::python;
 using namespace GafferBindings;
@@ -67,6 +68,32 @@ static bool shouldResetPlugDefault( const Gaffer::Plug *plug, const Serialisatio
 	return Context::current()->get<bool>( "valuePlugSerialiser:resetParentPlugDefaults", false );
 }
 
+static PythonFuture hashAsync( const ValuePlug *plug )
+{
+	return PythonFuture( plug->hashAsync(), &GafferBindings::Detail::futureResult<IECore::MurmurHash> );
+}
+
+static std::string hashCacheStatisticsRepr( const ValuePlug::HashCacheStatistics &s )
+{
+	return boost::str(
+		boost::format( "Gaffer.ValuePlug.HashCacheStatistics( hits = %d, misses = %d, evictions = %d )" )
+			% s.hits
+			% s.misses
+			% s.evictions
+	);
+}
+
+static dict cacheMemoryUsageByPlug()
+{
+	const ValuePlug::CacheMemoryUsageByPlug usage = ValuePlug::cacheMemoryUsageByPlug();
+	dict result;
+	for( ValuePlug::CacheMemoryUsageByPlug::const_iterator it = usage.begin(), eIt = usage.end(); it != eIt; ++it )
+	{
+		result[it->first] = it->second;
+	}
+	return result;
+}
+
 static std::string repr( const ValuePlug *plug )
 {
 	return ValuePlugSerialiser::repr( plug );
@@ -269,7 +296,7 @@ bool ValuePlugSerialiser::valueNeedsSerialisation( const Gaffer::ValuePlug *plug
 
 void GafferBindings::bindValuePlug()
 {
-	PlugClass<ValuePlug, PlugWrapper<ValuePlug> >()
+	scope s = PlugClass<ValuePlug, PlugWrapper<ValuePlug> >()
 		.def( boost::python::init<const std::string &, Plug::Direction, unsigned>(
 				(
 					boost::python::arg_( "name" ) = GraphComponent::defaultName<ValuePlug>(),
@@ -284,16 +311,55 @@ void GafferBindings::bindValuePlug()
 		.def( "isSetToDefault", &ValuePlug::isSetToDefault )
 		.def( "hash", (IECore::MurmurHash (ValuePlug::*)() const)&ValuePlug::hash )
 		.def( "hash", (void (ValuePlug::*)( IECore::MurmurHash & ) const)&ValuePlug::hash )
+		.def( "hashAsync", &hashAsync )
 		.def( "getCacheMemoryLimit", &ValuePlug::getCacheMemoryLimit )
 		.staticmethod( "getCacheMemoryLimit" )
 		.def( "setCacheMemoryLimit", &ValuePlug::setCacheMemoryLimit )
 		.staticmethod( "setCacheMemoryLimit" )
 		.def( "cacheMemoryUsage", &ValuePlug::cacheMemoryUsage )
 		.staticmethod( "cacheMemoryUsage" )
+		.def( "cacheMemoryUsageByPlug", &cacheMemoryUsageByPlug )
+		.staticmethod( "cacheMemoryUsageByPlug" )
 		.def( "clearCache", &ValuePlug::clearCache )
 		.staticmethod( "clearCache" )
+		.def( "getPersistentCacheDirectory", &ValuePlug::getPersistentCacheDirectory )
+		.staticmethod( "getPersistentCacheDirectory" )
+		.def( "setPersistentCacheDirectory", &ValuePlug::setPersistentCacheDirectory )
+		.staticmethod( "setPersistentCacheDirectory" )
+		.def( "getPersistentCacheSizeLimit", &ValuePlug::getPersistentCacheSizeLimit )
+		.staticmethod( "getPersistentCacheSizeLimit" )
+		.def( "setPersistentCacheSizeLimit", &ValuePlug::setPersistentCacheSizeLimit )
+		.staticmethod( "setPersistentCacheSizeLimit" )
+		.def( "clearPersistentCache", &ValuePlug::clearPersistentCache )
+		.staticmethod( "clearPersistentCache" )
+		.def( "getHashCacheSizeLimit", &ValuePlug::getHashCacheSizeLimit )
+		.staticmethod( "getHashCacheSizeLimit" )
+		.def( "setHashCacheSizeLimit", &ValuePlug::setHashCacheSizeLimit )
+		.staticmethod( "setHashCacheSizeLimit" )
+		.def( "hashCacheSize", &ValuePlug::hashCacheSize )
+		.staticmethod( "hashCacheSize" )
+		.def( "clearHashCache", &ValuePlug::clearHashCache )
+		.staticmethod( "clearHashCache" )
+		.def( "hashCacheStatistics", &ValuePlug::hashCacheStatistics )
+		.staticmethod( "hashCacheStatistics" )
+		.def( "resetHashCacheStatistics", &ValuePlug::resetHashCacheStatistics )
+		.staticmethod( "resetHashCacheStatistics" )
 		.def( "__repr__", &repr )
 	;
 
+	enum_<ValuePlug::CachePolicy>( "CachePolicy" )
+		.value( "Uncached", ValuePlug::Uncached )
+		.value( "HashOnly", ValuePlug::HashOnly )
+		.value( "Standard", ValuePlug::Standard )
+		.value( "TaskCollaboration", ValuePlug::TaskCollaboration )
+	;
+
+	class_<ValuePlug::HashCacheStatistics>( "HashCacheStatistics" )
+		.def_readonly( "hits", &ValuePlug::HashCacheStatistics::hits )
+		.def_readonly( "misses", &ValuePlug::HashCacheStatistics::misses )
+		.def_readonly( "evictions", &ValuePlug::HashCacheStatistics::evictions )
+		.def( "__repr__", &hashCacheStatisticsRepr )
+	;
+
 	Serialisation::registerSerialiser( Gaffer::ValuePlug::staticTypeId(), new ValuePlugSerialiser );
 }
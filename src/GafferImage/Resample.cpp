@@ -613,6 +613,9 @@ IECore::ConstFloatVectorDataPtr Resample::computeChannelData( const std::string
 
 		for( oP.y = tileBound.min.y; oP.y < tileBound.max.y; ++oP.y )
 		{
+			// Large filters can make this expensive, so we
+			// check for cancellation on every row.
+			Canceller::check( context->canceller() );
 			iP.y = ( oP.y + 0.5 ) / ratio.y + offset.y;
 			iPF.y = OIIO::floorfrac( iP.y, &iPI.y );
 
@@ -672,6 +675,7 @@ IECore::ConstFloatVectorDataPtr Resample::computeChannelData( const std::string
 
 		for( oP.y = tileBound.min.y; oP.y < tileBound.max.y; ++oP.y )
 		{
+			Canceller::check( context->canceller() );
 			std::vector<float>::const_iterator wIt = weights.begin();
 			for( oP.x = tileBound.min.x; oP.x < tileBound.max.x; ++oP.x )
 			{
@@ -716,6 +720,7 @@ IECore::ConstFloatVectorDataPtr Resample::computeChannelData( const std::string
 
 		for( oP.y = tileBound.min.y; oP.y < tileBound.max.y; ++oP.y )
 		{
+			Canceller::check( context->canceller() );
 			iY = ( oP.y + 0.5 ) / ratio.y + offset.y;
 			OIIO::floorfrac( iY, &iYI );
 
@@ -56,6 +56,7 @@
 #include "GafferBindings/ApplicationRootBinding.h"
 #include "GafferBindings/SetBinding.h"
 #include "GafferBindings/UndoContextBinding.h"
+#include "GafferBindings/BatchEditScopeBinding.h"
 #include "GafferBindings/CompoundPlugBinding.h"
 #include "GafferBindings/CompoundNumericPlugBinding.h"
 #include "GafferBindings/SplinePlugBinding.h"
@@ -92,6 +93,8 @@
 #include "GafferBindings/MonitorBinding.h"
 #include "GafferBindings/MetadataAlgoBinding.h"
 #include "GafferBindings/SwitchBinding.h"
+#include "GafferBindings/ThreadBudgetBinding.h"
+#include "GafferBindings/FutureBinding.h"
 
 using namespace boost::python;
 using namespace Gaffer;
@@ -147,6 +150,7 @@ BOOST_PYTHON_MODULE( _Gaffer )
 	bindDependencyNode();
 	bindComputeNode();
 	bindPlug();
+	bindFuture();
 	bindValuePlug();
 	bindNumericPlug();
 	bindTypedPlug();
@@ -156,6 +160,7 @@ BOOST_PYTHON_MODULE( _Gaffer )
 	bindApplicationRoot();
 	bindSet();
 	bindUndoContext();
+	bindBatchEditScope();
 	bindCompoundPlug();
 	bindCompoundNumericPlug();
 	bindSplinePlug();
@@ -188,6 +193,7 @@ BOOST_PYTHON_MODULE( _Gaffer )
 	bindMonitor();
 	bindMetadataAlgo();
 	bindSwitch();
+	bindThreadBudget();
 
 	NodeClass<Backdrop>();
 
@@ -54,6 +54,8 @@
 #include "IECore/Shader.h"
 #include "IECore/SplineData.h"
 
+#include "Gaffer/Context.h"
+
 #include "GafferOSL/ShadingEngine.h"
 
 using namespace std;
@@ -953,13 +955,23 @@ IECore::CompoundDataPtr ShadingEngine::shade( const IECore::CompoundData *points
 
 	ShadingResults results( numPoints );
 
-	// Iterate over the input points, doing the shading as we go
+	// Iterate over the input points, doing the shading as we go. Shading
+	// large numbers of points can take a while, so we periodically check
+	// to see if the work has been cancelled.
+
+	const Gaffer::Canceller *canceller = Gaffer::Context::current()->canceller();
 
 	ShadingSystem *shadingSystem = ::shadingSystem();
 	ShadingContext *shadingContext = shadingSystem->get_context();
 	ShaderGroup &shaderGroup = **static_cast<ShaderGroupRef *>( m_shaderGroupRef );
 	for( size_t i = 0; i < numPoints; ++i )
 	{
+		if( canceller && i % 1000 == 0 && canceller->cancelled() )
+		{
+			shadingSystem->release_context( shadingContext );
+			throw Gaffer::Cancelled();
+		}
+
 		shaderGlobals.P = *p++;
 		if( u )
 		{
@@ -185,6 +185,19 @@ void Group::compute( Gaffer::ValuePlug *output, const Gaffer::Context *context )
 	return SceneProcessor::compute( output, context );
 }
 
+Gaffer::ValuePlug::CachePolicy Group::computeCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output == mappingPlug() )
+	{
+		// The mapping is required by every location below the group,
+		// and is expensive to compute when there are many inputs, so
+		// it is worth collaborating on.
+		return Gaffer::ValuePlug::TaskCollaboration;
+	}
+
+	return SceneProcessor::computeCachePolicy( output );
+}
+
 void Group::hashBound( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
 	if( path.size() == 0 ) // "/"
@@ -44,6 +44,7 @@
 #include "IECore/Primitive.h"
 
 #include "Gaffer/Context.h"
+#include "Gaffer/Process.h"
 #include "Gaffer/StringPlug.h"
 
 #include "GafferScene/Instancer.h"
@@ -115,19 +116,24 @@ struct Instancer::BoundHash
 {
 
 	BoundHash( const Instancer *instancer, const ScenePath &branchPath, const Context *c )
-		:	m_instancer( instancer ), m_branchPath( branchPath ), m_context( c ), m_hash()
+		:	m_instancer( instancer ), m_branchPath( branchPath ), m_context( c ), m_process( Process::current() ), m_recorder( Context::AccessRecorder::current() ), m_hash()
 	{
 	}
 
 	BoundHash( const BoundHash &rhs, split )
-		:	m_instancer( rhs.m_instancer ), m_branchPath( rhs.m_branchPath ), m_context( rhs.m_context ), m_hash()
+		:	m_instancer( rhs.m_instancer ), m_branchPath( rhs.m_branchPath ), m_context( rhs.m_context ), m_process( rhs.m_process ), m_recorder( rhs.m_recorder ), m_hash()
 	{
 	}
 
 	void operator() ( const blocked_range<size_t> &r )
 	{
-		ContextPtr ic = new Context( *m_context, Context::Borrowed );
-		Context::Scope scopedContext( ic.get() );
+		// We may be running on a different thread to the one
+		// which requested the hash, so must transfer the recorder
+		// for the context variables it depends on, and the parent
+		// process.
+		Context::AccessRecorder::Scope recorderScope( m_recorder );
+		Process::Scope processScope( m_process );
+		Context::EditableScope scope( m_context );
 
 		ScenePath branchChildPath( m_branchPath );
 		branchChildPath.push_back( InternedString() ); // where we'll place the instance index
@@ -135,7 +141,7 @@ struct Instancer::BoundHash
 		for( size_t i=r.begin(); i!=r.end(); ++i )
 		{
 			branchChildPath[branchChildPath.size()-1] = InternedString( i );
-			m_instancer->fillInstanceContext( ic.get(), branchChildPath, i );
+			m_instancer->fillInstanceContext( scope, branchChildPath, i );
 			m_instancer->instancePlug()->boundPlug()->hash( m_hash );
 			// no need to hash transform of instance because we know all
 			// root transforms are identity.
@@ -157,6 +163,8 @@ struct Instancer::BoundHash
 		const Instancer *m_instancer;
 		const ScenePath &m_branchPath;
 		const Context *m_context;
+		const Process *m_process;
+		Context::AccessRecorder *m_recorder;
 		MurmurHash m_hash;
 
 };
@@ -201,19 +209,20 @@ struct Instancer::BoundUnion
 {
 
 	BoundUnion( const Instancer *instancer, const ScenePath &branchPath, const Context *c, const V3fVectorData *p )
-		:	m_instancer( instancer ), m_branchPath( branchPath ), m_context( c ), m_p( p ), m_union()
+		:	m_instancer( instancer ), m_branchPath( branchPath ), m_context( c ), m_process( Process::current() ), m_recorder( Context::AccessRecorder::current() ), m_p( p ), m_union()
 	{
 	}
 
 	BoundUnion( const BoundUnion &rhs, split )
-		:	m_instancer( rhs.m_instancer ), m_branchPath( rhs.m_branchPath ), m_context( rhs.m_context ), m_p( rhs.m_p ), m_union()
+		:	m_instancer( rhs.m_instancer ), m_branchPath( rhs.m_branchPath ), m_context( rhs.m_context ), m_process( rhs.m_process ), m_recorder( rhs.m_recorder ), m_p( rhs.m_p ), m_union()
 	{
 	}
 
 	void operator() ( const blocked_range<size_t> &r )
 	{
-		ContextPtr ic = new Context( *m_context, Context::Borrowed );
-		Context::Scope scopedContext( ic.get() );
+		Context::AccessRecorder::Scope recorderScope( m_recorder );
+		Process::Scope processScope( m_process );
+		Context::EditableScope scope( m_context );
 
 		ScenePath branchChildPath( m_branchPath );
 		branchChildPath.push_back( InternedString() ); // where we'll place the instance index
@@ -221,7 +230,7 @@ struct Instancer::BoundUnion
 		for( size_t i=r.begin(); i!=r.end(); ++i )
 		{
 			branchChildPath[branchChildPath.size()-1] = InternedString( i );
-			m_instancer->fillInstanceContext( ic.get(), branchChildPath, i );
+			m_instancer->fillInstanceContext( scope, branchChildPath, i );
 
 			Box3f branchChildBound = m_instancer->instancePlug()->boundPlug()->getValue();
 			branchChildBound = transform( branchChildBound, m_instancer->instanceTransform( m_p, i ) );
@@ -244,6 +253,8 @@ struct Instancer::BoundUnion
 		const Instancer *m_instancer;
 		const ScenePath &m_branchPath;
 		const Context *m_context;
+		const Process *m_process;
+		Context::AccessRecorder *m_recorder;
 		const V3fVectorData *m_p;
 		Box3f m_union;
 
@@ -482,18 +493,22 @@ void Instancer::fillInstanceContext( Gaffer::Context *instanceContext, const Sce
 {
 	assert( branchPath.size() >= 2 );
 
-	fillInstanceContext( instanceContext, branchPath, instanceIndex( branchPath ) );
+	ScenePath instancePath;
+	instancePath.insert( instancePath.end(), branchPath.begin() + 2, branchPath.end() );
+	instanceContext->set( ScenePlug::scenePathContextName, instancePath );
+
+	instanceContext->set( "instancer:id", instanceIndex( branchPath ) );
 }
 
-void Instancer::fillInstanceContext( Gaffer::Context *instanceContext, const ScenePath &branchPath, int instanceId ) const
+void Instancer::fillInstanceContext( Gaffer::Context::EditableScope &instanceScope, const ScenePath &branchPath, int instanceId ) const
 {
 	assert( branchPath.size() >= 2 );
 
 	ScenePath instancePath;
 	instancePath.insert( instancePath.end(), branchPath.begin() + 2, branchPath.end() );
-	instanceContext->set( ScenePlug::scenePathContextName, instancePath );
+	instanceScope.set( ScenePlug::scenePathContextName, instancePath );
 
-	instanceContext->set( "instancer:id", instanceId );
+	instanceScope.set( "instancer:id", instanceId );
 }
 
 Imath::M44f Instancer::instanceTransform( const IECore::V3fVectorData *p, int instanceId ) const
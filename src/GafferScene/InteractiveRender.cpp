@@ -48,6 +48,7 @@
 
 #include "Gaffer/Context.h"
 #include "Gaffer/ScriptNode.h"
+#include "Gaffer/ThreadBudget.h"
 
 #include "GafferScene/InteractiveRender.h"
 #include "GafferScene/RendererAlgo.h"
@@ -811,12 +812,52 @@ class InteractiveRender::SceneGraphOutputFilter : public tbb::thread_bound_filte
 		bool m_editMode;
 };
 
-void InteractiveRender::runPipeline(tbb::pipeline *p)
+namespace
+{
+
+// Returns the budget for work performed on behalf of the script
+// containing `node`, or NULL if there is no such budget.
+ThreadBudget *threadBudget( Node *node )
+{
+	ScriptNode *script = node->ancestor<ScriptNode>();
+	return script ? script->getThreadBudget() : NULL;
+}
+
+struct PipelineRunner
+{
+
+	PipelineRunner( tbb::pipeline *pipeline, size_t maxTokens )
+		:	m_pipeline( pipeline ), m_maxTokens( maxTokens )
+	{
+	}
+
+	void operator()() const
+	{
+		m_pipeline->run( m_maxTokens );
+	}
+
+	private :
+
+		tbb::pipeline *m_pipeline;
+		size_t m_maxTokens;
+
+};
+
+} // namespace
+
+void InteractiveRender::runPipeline( tbb::pipeline *p, ThreadBudget *threadBudget )
 {
 	// \todo: tune this number to find a balance between memory and speed once
 	// we have a load of production data:
 
-	p->run( 2 * tbb::task_scheduler_init::default_num_threads() );
+	const int numThreads = threadBudget && threadBudget->maxThreads() > 0 ? threadBudget->maxThreads() : tbb::task_scheduler_init::default_num_threads();
+	ThreadBudget::execute( threadBudget, PipelineRunner( p, 2 * numThreads ) );
+}
+
+void InteractiveRender::buildSceneGraph()
+{
+	SceneGraphBuildTask *task = new( tbb::task::allocate_root() ) SceneGraphBuildTask( inPlug(), m_context.get(), m_sceneGraph.get(), ScenePlug::ScenePath() );
+	tbb::task::spawn_root_and_wait( *task );
 }
 
 void InteractiveRender::outputScene( bool update )
@@ -841,7 +882,7 @@ void InteractiveRender::outputScene( bool update )
 	p.add_filter( output );
 
 	 // Another thread initiates execution of the pipeline
-	tbb::tbb_thread pipelineThread( runPipeline, &p );
+	tbb::tbb_thread pipelineThread( runPipeline, &p, threadBudget( this ) );
 
 	// Process the SceneGraphOutputFilter with the current thread:
 	while( output.process_item() != tbb::thread_bound_filter::end_of_stream )
@@ -900,8 +941,7 @@ void InteractiveRender::update()
 
 			// build the scene graph structure in parallel:
 			m_sceneGraph.reset( new SceneGraph );
-			SceneGraphBuildTask *task = new( tbb::task::allocate_root() ) SceneGraphBuildTask( inPlug(), m_context.get(), m_sceneGraph.get(), ScenePlug::ScenePath() );
-			tbb::task::spawn_root_and_wait( *task );
+			ThreadBudget::execute( threadBudget( this ), boost::bind( &InteractiveRender::buildSceneGraph, this ) );
 
 			// output the scene for the first time:
 			outputScene( false );
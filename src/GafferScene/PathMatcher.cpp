@@ -35,6 +35,10 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/spin_mutex.h"
+
+#include "boost/unordered_map.hpp"
+
 #include "Gaffer/StringAlgo.h"
 
 #include "GafferScene/PathMatcher.h"
@@ -49,13 +53,39 @@ static IECore::InternedString g_ellipsis( "..." );
 // Name implementation
 //////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+typedef boost::unordered_map<const char *, const Gaffer::StringAlgo::CompiledMatchPattern *> CompiledPatterns;
+CompiledPatterns g_compiledPatterns;
+tbb::spin_mutex g_compiledPatternsMutex;
+
+// InternedStrings are unique, so we can key
+// the compiled patterns by their address.
+const Gaffer::StringAlgo::CompiledMatchPattern *compiledPattern( IECore::InternedString name )
+{
+	tbb::spin_mutex::scoped_lock lock( g_compiledPatternsMutex );
+	CompiledPatterns::iterator it = g_compiledPatterns.find( name.c_str() );
+	if( it == g_compiledPatterns.end() )
+	{
+		it = g_compiledPatterns.insert(
+			CompiledPatterns::value_type( name.c_str(), new Gaffer::StringAlgo::CompiledMatchPattern( name.string() ) )
+		).first;
+	}
+	return it->second;
+}
+
+} // namespace
+
 inline PathMatcher::Name::Name( IECore::InternedString name )
-	: name( name ), type( name == g_ellipsis || Gaffer::StringAlgo::hasWildcards( name.c_str() ) ? Wildcarded : Plain )
+	: name( name ), type( name == g_ellipsis || Gaffer::StringAlgo::hasWildcards( name.c_str() ) ? Wildcarded : Plain ),
+		pattern( type == Wildcarded && name != g_ellipsis ? compiledPattern( name ) : NULL )
 {
 }
 
 inline PathMatcher::Name::Name( IECore::InternedString name, Type type )
-	: name( name ), type( type )
+	: name( name ), type( type ),
+		pattern( type == Wildcarded && name != g_ellipsis ? compiledPattern( name ) : NULL )
 {
 }
 
@@ -304,7 +334,7 @@ void PathMatcher::matchWalk( const Node *node, const NameIterator &start, const
 		}
 
 		NameIterator newStart = start + 1;
-		if( Gaffer::StringAlgo::match( start->c_str(), childIt->first.name.c_str() ) )
+		if( childIt->first.pattern->match( start->string() ) )
 		{
 			matchWalk( childIt->second.get(), newStart, end, result );
 			if( result == Filter::EveryMatch )
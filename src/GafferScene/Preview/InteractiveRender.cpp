@@ -46,6 +46,7 @@
 #include "Gaffer/Context.h"
 #include "Gaffer/ScriptNode.h"
 #include "Gaffer/StringPlug.h"
+#include "Gaffer/ThreadBudget.h"
 
 #include "GafferScene/Preview/RendererAlgo.h"
 #include "GafferScene/Preview/InteractiveRender.h"
@@ -851,6 +852,24 @@ void InteractiveRender::update()
 		}
 	}
 
+	// Update the scene graphs within the script's thread budget if it has one,
+	// so that a large update doesn't starve other work such as the viewer.
+	ScriptNode *script = ancestor<ScriptNode>();
+	ThreadBudget::execute( script ? script->getThreadBudget() : NULL, boost::bind( &InteractiveRender::updateSceneGraphs, this ) );
+
+	if( m_dirtyComponents & SceneGraph::GlobalsComponent )
+	{
+		updateDefaultCamera();
+	}
+
+	m_dirtyComponents = SceneGraph::NoComponent;
+	m_state = requiredState;
+
+	m_renderer->render();
+}
+
+void InteractiveRender::updateSceneGraphs()
+{
 	for( int i = SceneGraph::FirstType; i <= SceneGraph::LastType; ++i )
 	{
 		SceneGraph *sceneGraph = m_sceneGraphs[i].get();
@@ -866,16 +885,6 @@ void InteractiveRender::update()
 		SceneGraphUpdateTask *task = new( tbb::task::allocate_root() ) SceneGraphUpdateTask( this, sceneGraph, (SceneGraph::Type)i, m_dirtyComponents, SceneGraph::NoComponent, ScenePlug::ScenePath() );
 		tbb::task::spawn_root_and_wait( *task );
 	}
-
-	if( m_dirtyComponents & SceneGraph::GlobalsComponent )
-	{
-		updateDefaultCamera();
-	}
-
-	m_dirtyComponents = SceneGraph::NoComponent;
-	m_state = requiredState;
-
-	m_renderer->render();
 }
 
 void InteractiveRender::updateEffectiveContext()
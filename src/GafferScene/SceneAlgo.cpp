@@ -48,6 +48,7 @@
 #include "IECore/VisibleRenderable.h"
 
 #include "Gaffer/Context.h"
+#include "Gaffer/Process.h"
 
 #include "GafferScene/SceneAlgo.h"
 #include "GafferScene/Filter.h"
@@ -62,13 +63,12 @@ using namespace GafferScene;
 
 bool GafferScene::SceneAlgo::exists( const ScenePlug *scene, const ScenePlug::ScenePath &path )
 {
-	ContextPtr context = new Context( *Context::current(), Context::Borrowed );
-	Context::Scope scopedContext( context.get() );
+	Context::EditableScope scope( Context::current() );
 
 	ScenePlug::ScenePath p; p.reserve( path.size() );
 	for( ScenePlug::ScenePath::const_iterator it = path.begin(), eIt = path.end(); it != eIt; ++it )
 	{
-		context->set( ScenePlug::scenePathContextName, p );
+		scope.set( ScenePlug::scenePathContextName, p );
 		ConstInternedStringVectorDataPtr childNamesData = scene->childNamesPlug()->getValue();
 		const vector<InternedString> &childNames = childNamesData->readable();
 		if( find( childNames.begin(), childNames.end(), *it ) == childNames.end() )
@@ -83,14 +83,13 @@ bool GafferScene::SceneAlgo::exists( const ScenePlug *scene, const ScenePlug::Sc
 
 bool GafferScene::SceneAlgo::visible( const ScenePlug *scene, const ScenePlug::ScenePath &path )
 {
-	ContextPtr context = new Context( *Context::current(), Context::Borrowed );
-	Context::Scope scopedContext( context.get() );
+	Context::EditableScope scope( Context::current() );
 
 	ScenePlug::ScenePath p; p.reserve( path.size() );
 	for( ScenePlug::ScenePath::const_iterator it = path.begin(), eIt = path.end(); it != eIt; ++it )
 	{
 		p.push_back( *it );
-		context->set( ScenePlug::scenePathContextName, p );
+		scope.set( ScenePlug::scenePathContextName, p );
 
 		ConstCompoundObjectPtr attributes = scene->attributesPlug()->getValue();
 		const BoolData *visibilityData = attributes->member<BoolData>( "scene:visible" );
@@ -203,12 +202,11 @@ IECore::TransformPtr GafferScene::SceneAlgo::transform( const ScenePlug *scene,
 	}
 
 	MatrixMotionTransformPtr result = new MatrixMotionTransform();
-	ContextPtr transformContext = new Context( *Context::current(), Context::Borrowed );
-	Context::Scope scopedContext( transformContext.get() );
+	Context::EditableScope scope( Context::current() );
 	for( int i = 0; i < numSamples; i++ )
 	{
 		float frame = lerp( shutter[0], shutter[1], (float)i / std::max( 1, numSamples - 1 ) );
-		transformContext->setFrame( frame );
+		scope.setFrame( frame );
 		result->snapshots()[frame] = scene->fullTransform( path );
 	}
 
@@ -445,13 +443,15 @@ struct Sets
 {
 
 	Sets( const ScenePlug *scene, const Context *context, const std::vector<InternedString> &names, std::vector<GafferScene::ConstPathMatcherDataPtr> &sets )
-		:	m_scene( scene ), m_context( context ), m_names( names ), m_sets( sets )
+		:	m_scene( scene ), m_context( context ), m_process( Process::current() ), m_accessRecorder( Context::AccessRecorder::current() ), m_names( names ), m_sets( sets )
 	{
 	}
 
 	void operator()( const tbb::blocked_range<size_t> &r ) const
 	{
 		Context::Scope scopedContext( m_context );
+		Process::Scope scopedProcess( m_process );
+		Context::AccessRecorder::Scope scopedAccessRecorder( m_accessRecorder );
 		for( size_t i=r.begin(); i!=r.end(); ++i )
 		{
 			m_sets[i] = m_scene->set( m_names[i] );
@@ -462,6 +462,8 @@ struct Sets
 
 		const ScenePlug *m_scene;
 		const Context *m_context;
+		const Process *m_process;
+		Context::AccessRecorder *m_accessRecorder;
 		const std::vector<InternedString> &m_names;
 		std::vector<GafferScene::ConstPathMatcherDataPtr> &m_sets;
 
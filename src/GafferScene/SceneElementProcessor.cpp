@@ -253,6 +253,19 @@ IECore::ConstObjectPtr SceneElementProcessor::computeObject( const ScenePath &pa
 	}
 }
 
+Gaffer::ValuePlug::CachePolicy SceneElementProcessor::computeCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	// We only consider the transform here, because processesAttributes() and
+	// processesObject() may be implemented in terms of plug values, and querying
+	// those on every hash would be more expensive than the cache entries we'd save.
+	if( output == outPlug()->transformPlug() && !processesTransform() )
+	{
+		return ValuePlug::HashOnly;
+	}
+
+	return FilteredSceneProcessor::computeCachePolicy( output );
+}
+
 bool SceneElementProcessor::processesBound() const
 {
 	return false;
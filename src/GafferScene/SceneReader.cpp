@@ -284,9 +284,34 @@ IECore::ConstObjectPtr SceneReader::computeObject( const ScenePath &path, const
 		return parent->objectPlug()->defaultValue();
 	}
 
+	// Opening the file may have taken a while, and reading
+	// the object can't be interrupted, so this is our last
+	// chance to abort if the work is no longer needed.
+	Canceller::check( context->canceller() );
 	return s->readObject( context->getTime() );
 }
 
+Gaffer::ValuePlug::CachePolicy SceneReader::computeCachePolicy( const Gaffer::ValuePlug *output ) const
+{
+	if( output == outPlug()->objectPlug() )
+	{
+		// Objects may be large and slow to read, so when several threads
+		// require the same one, it's better for one to read it while the
+		// others wait.
+		return Gaffer::ValuePlug::TaskCollaboration;
+	}
+
+	return SceneNode::computeCachePolicy( output );
+}
+
+bool SceneReader::persistentCacheable( const Gaffer::ValuePlug *output ) const
+{
+	// Our hashes are derived from the file name and the SceneInterface
+	// hashes, which are stable between processes, so it's safe to reuse
+	// objects read by other processes.
+	return output == outPlug()->objectPlug();
+}
+
 void SceneReader::hashChildNames( const ScenePath &path, const Gaffer::Context *context, const ScenePlug *parent, IECore::MurmurHash &h ) const
 {
 	ConstSceneInterfacePtr s = scene( path );
@@ -400,8 +425,10 @@ void SceneReader::hashSet( const IECore::InternedString &setName, const Gaffer::
 	h.append( setName );
 }
 
-static void loadSetWalk( const SceneInterface *s, const InternedString &setName, PathMatcher &set, const vector<InternedString> &path )
+static void loadSetWalk( const SceneInterface *s, const InternedString &setName, PathMatcher &set, const vector<InternedString> &path, const Canceller *canceller )
 {
+	Canceller::check( canceller );
+
 	if( s->hasTag( setName, SceneInterface::LocalTag ) )
 	{
 		set.addPath( path );
@@ -425,7 +452,7 @@ static void loadSetWalk( const SceneInterface *s, const InternedString &setName,
 	{
 		ConstSceneInterfacePtr child = s->child( *it );
 		childPath.back() = *it;
-		loadSetWalk( child.get(), setName, set, childPath );
+		loadSetWalk( child.get(), setName, set, childPath, canceller );
 	}
 }
 
@@ -435,7 +462,7 @@ GafferScene::ConstPathMatcherDataPtr SceneReader::computeSet( const IECore::Inte
 	ConstSceneInterfacePtr rootScene = scene( ScenePath() );
 	if( rootScene )
 	{
-		loadSetWalk( rootScene.get(), setName, result->writable(), ScenePath() );
+		loadSetWalk( rootScene.get(), setName, result->writable(), ScenePath(), context->canceller() );
 	}
 	return result;
 }
@@ -39,6 +39,8 @@
 
 #include "IECore/Timer.h"
 
+#include "Gaffer/Context.h"
+
 #include "GafferTest/Assert.h"
 #include "GafferTest/MultiplyNode.h"
 #include "GafferTest/ComputeNodeTest.h"
@@ -103,6 +105,30 @@ struct Compute
 
 };
 
+struct GetValue
+{
+
+	GetValue( const IntPlug *plug, const Context *context )
+		:	m_plug( plug ), m_context( context )
+	{
+	}
+
+	void operator()( const blocked_range<size_t> &r ) const
+	{
+		Context::Scope scope( m_context );
+		for( size_t i=r.begin(); i!=r.end(); ++i )
+		{
+			m_plug->getValue();
+		}
+	}
+
+	private :
+
+		const IntPlug *m_plug;
+		const Context *m_context;
+
+};
+
 } // namespace
 
 void GafferTest::testComputeNodeThreading()
@@ -127,3 +153,9 @@ void GafferTest::testComputeNodeThreading()
 	//std::cerr << t.stop() << std::endl;
 	stop = true;
 }
+
+void GafferTest::parallelGetValue( const Gaffer::IntPlug *plug, int iterations )
+{
+	GetValue g( plug, Context::current() );
+	parallel_for( blocked_range<size_t>( 0, iterations ), g );
+}
@@ -34,6 +34,8 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/tbb_thread.h"
+
 #include "boost/lexical_cast.hpp"
 
 #include "IECore/Timer.h"
@@ -82,6 +84,64 @@ void GafferTest::testManyContexts()
 	//std::cerr << t.stop() << std::endl;
 }
 
+// Useful for assessing the performance of hashing a context with
+// many variables, when only one of them changes at a time.
+void GafferTest::testManyVariablesHashPerformance()
+{
+	ContextPtr context = new Context();
+	const int numKeys = 1000;
+	vector<InternedString> keys;
+	for( int i = 0; i < numKeys; ++i )
+	{
+		InternedString key = string( "testKey" ) + lexical_cast<string>( i );
+		keys.push_back( key );
+		context->set( key, -1 - i );
+	}
+	const MurmurHash initialHash = context->hash();
+
+	Timer t;
+	for( int i = 0; i < 100000; ++i )
+	{
+		context->set( keys[i%numKeys], i );
+		GAFFERTEST_ASSERT( context->hash() != initialHash );
+	}
+
+	// uncomment to get timing information
+	//std::cerr << t.stop() << std::endl;
+}
+
+// Useful for assessing the performance of hashing a context while
+// iterating over the locations of a deep scene hierarchy, as is
+// common in GafferScene.
+void GafferTest::testDeepPathHashPerformance()
+{
+	ContextPtr context = new Context();
+	for( int i = 0; i < 20; ++i )
+	{
+		context->set( string( "testKey" ) + lexical_cast<string>( i ), i );
+	}
+
+	vector<InternedString> path;
+	for( int i = 0; i < 50; ++i )
+	{
+		path.push_back( string( "location" ) + lexical_cast<string>( i ) );
+	}
+
+	const InternedString scenePathName( "scene:path" );
+	const MurmurHash initialHash = context->hash();
+
+	Timer t;
+	for( int i = 0; i < 100000; ++i )
+	{
+		path.back() = lexical_cast<string>( i % 100 );
+		context->set( scenePathName, path );
+		GAFFERTEST_ASSERT( context->hash() != initialHash );
+	}
+
+	// uncomment to get timing information
+	//std::cerr << t.stop() << std::endl;
+}
+
 // Useful for assessing the performance of substitutions.
 void GafferTest::testManySubstitutions()
 {
@@ -145,3 +205,204 @@ void GafferTest::testScopingNullContext()
 		}
 	}
 }
+
+void GafferTest::testEditableScope()
+{
+	ContextPtr base = new Context();
+	base->set( "a", 1 );
+	base->set( "b", 2 );
+	const MurmurHash baseHash = base->hash();
+
+	Context::Scope baseScope( base.get() );
+
+	{
+		Context::EditableScope scope( base.get() );
+		GAFFERTEST_ASSERT( Context::current() == scope.context() );
+		GAFFERTEST_ASSERT( scope.context() != base.get() );
+		GAFFERTEST_ASSERT( scope.context()->hash() == baseHash );
+		GAFFERTEST_ASSERT( *scope.context() == *base );
+
+		scope.set( "a", 10 );
+		scope.set( "c", std::string( "c" ) );
+		scope.setFrame( 5 );
+		scope.remove( "b" );
+
+		GAFFERTEST_ASSERT( scope.context()->get<int>( "a" ) == 10 );
+		GAFFERTEST_ASSERT( scope.context()->get<std::string>( "c" ) == "c" );
+		GAFFERTEST_ASSERT( scope.context()->getFrame() == 5 );
+		GAFFERTEST_ASSERT( scope.context()->get<int>( "b", -1 ) == -1 );
+
+		// The hash must match that of an equivalent context
+		// made the old fashioned way.
+		ContextPtr expected = new Context( *base );
+		expected->set( "a", 10 );
+		expected->set( "c", std::string( "c" ) );
+		expected->setFrame( 5 );
+		expected->remove( "b" );
+		GAFFERTEST_ASSERT( scope.context()->hash() == expected->hash() );
+
+		// The original is unaffected.
+		GAFFERTEST_ASSERT( base->get<int>( "a" ) == 1 );
+		GAFFERTEST_ASSERT( base->get<int>( "b" ) == 2 );
+		GAFFERTEST_ASSERT( base->hash() == baseHash );
+
+		// Nested scopes see the values of their parent.
+		{
+			Context::EditableScope nestedScope( Context::current() );
+			GAFFERTEST_ASSERT( Context::current() == nestedScope.context() );
+			GAFFERTEST_ASSERT( nestedScope.context()->hash() == expected->hash() );
+			nestedScope.set( "a", 20 );
+			GAFFERTEST_ASSERT( nestedScope.context()->get<int>( "a" ) == 20 );
+			GAFFERTEST_ASSERT( scope.context()->get<int>( "a" ) == 10 );
+		}
+
+		GAFFERTEST_ASSERT( Context::current() == scope.context() );
+
+		// Changing the type of a value is fine.
+		scope.set( "a", 1.5f );
+		GAFFERTEST_ASSERT( scope.context()->get<float>( "a" ) == 1.5f );
+	}
+
+	GAFFERTEST_ASSERT( Context::current() == base.get() );
+
+	// Pooled contexts must not remember anything from
+	// previous scopes.
+	{
+		Context::EditableScope scope( base.get() );
+		GAFFERTEST_ASSERT( scope.context()->hash() == baseHash );
+		GAFFERTEST_ASSERT( scope.context()->get<int>( "c", -1 ) == -1 );
+	}
+
+	// Code that holds on to a context beyond the lifetime of the
+	// scope shouldn't see it changed by subsequent scopes.
+	ConstContextPtr held;
+	{
+		Context::EditableScope scope( base.get() );
+		scope.set( "a", 100 );
+		held = scope.context();
+	}
+
+	{
+		Context::EditableScope scope( base.get() );
+		scope.set( "a", 200 );
+		GAFFERTEST_ASSERT( scope.context() != held.get() );
+		GAFFERTEST_ASSERT( scope.context()->get<int>( "a" ) == 200 );
+	}
+
+	GAFFERTEST_ASSERT( held->get<int>( "a" ) == 100 );
+}
+
+// Equivalent to testManyContexts(), but using EditableScope in
+// the manner of a scene traversal, where each location makes a
+// temporary context with a new value for "scene:path".
+void GafferTest::testManyEditableScopes()
+{
+	ContextPtr base = new Context();
+	const int numKeys = 20;
+	for( int i = 0; i < numKeys; ++i )
+	{
+		base->set( string( "testKey" ) + lexical_cast<string>( i ), -1 - i );
+	}
+	const MurmurHash baseHash = base->hash();
+
+	vector<InternedString> path;
+	for( int i = 0; i < 10; ++i )
+	{
+		path.push_back( string( "location" ) + lexical_cast<string>( i ) );
+	}
+	const InternedString scenePathName( "scene:path" );
+
+	Timer t;
+	for( int i = 0; i < 100000; ++i )
+	{
+		Context::EditableScope scope( base.get() );
+		path.back() = lexical_cast<string>( i % 100 );
+		scope.set( scenePathName, path );
+		GAFFERTEST_ASSERT( scope.context()->get<vector<InternedString> >( scenePathName ) == path );
+		GAFFERTEST_ASSERT( scope.context()->hash() != baseHash );
+
+		Context::EditableScope nestedScope( scope.context() );
+		nestedScope.set( scenePathName, path );
+		GAFFERTEST_ASSERT( nestedScope.context()->hash() == scope.context()->hash() );
+	}
+
+	// uncomment to get timing information
+	//std::cerr << t.stop() << std::endl;
+}
+
+namespace
+{
+
+// Reads a variable on another thread, in the manner of a TBB task
+// which makes the context current without forwarding the recorder.
+struct ReadFunctor
+{
+
+	ReadFunctor( const Context *context, const char *name, bool nestedRecorder = false, bool suspend = false )
+		:	m_context( context ), m_name( name ), m_nestedRecorder( nestedRecorder ), m_suspend( suspend )
+	{
+	}
+
+	void operator()() const
+	{
+		// Copies inherit the link to the recorder.
+		ContextPtr copy = new Context( *m_context, Context::Borrowed );
+		Context::Scope scope( copy.get() );
+		if( m_suspend )
+		{
+			Context::AccessRecorder::Scope suspendedScope( NULL );
+			Context::current()->get<int>( m_name );
+		}
+		else if( m_nestedRecorder )
+		{
+			Context::AccessRecorder recorder;
+			Context::current()->get<int>( m_name );
+		}
+		else
+		{
+			Context::current()->get<int>( m_name );
+		}
+	}
+
+	const Context *m_context;
+	const char *m_name;
+	bool m_nestedRecorder;
+	bool m_suspend;
+
+};
+
+void readOnThread( const ReadFunctor &f )
+{
+	tbb::tbb_thread thread( f );
+	thread.join();
+}
+
+} // namespace
+
+void GafferTest::testAccessRecorderThreading()
+{
+	ContextPtr base = new Context();
+	base->set( "a", 1 );
+	base->set( "b", 2 );
+	base->set( "c", 3 );
+	base->set( "d", 4 );
+	Context::Scope baseScope( base.get() );
+
+	Context::AccessRecorder recorder;
+	const Context *context = Context::current();
+	GAFFERTEST_ASSERT( context != base.get() );
+
+	readOnThread( ReadFunctor( context, "a" ) );
+	readOnThread( ReadFunctor( context, "b", /* nestedRecorder = */ true ) );
+	readOnThread( ReadFunctor( context, "c", /* nestedRecorder = */ false, /* suspend = */ true ) );
+
+	GAFFERTEST_ASSERT( !recorder.all() );
+	GAFFERTEST_ASSERT( recorder.names().size() == 2 );
+	GAFFERTEST_ASSERT( recorder.names().count( "a" ) );
+	GAFFERTEST_ASSERT( recorder.names().count( "b" ) );
+
+	// Accesses to contexts which aren't linked to the
+	// recorder aren't recorded.
+	readOnThread( ReadFunctor( base.get(), "d" ) );
+	GAFFERTEST_ASSERT( recorder.names().size() == 2 );
+}
@@ -0,0 +1,111 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2016, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "boost/bind.hpp"
+
+#include "IECore/Timer.h"
+
+#include "GafferTest/Assert.h"
+#include "GafferTest/MultiplyNode.h"
+#include "GafferTest/DependencyNodeTest.h"
+
+using namespace std;
+using namespace IECore;
+using namespace Gaffer;
+
+namespace
+{
+
+struct DirtiedCounter
+{
+
+	DirtiedCounter()
+		:	count( 0 )
+	{
+	}
+
+	void plugDirtied( Plug *plug )
+	{
+		count++;
+	}
+
+	size_t count;
+
+};
+
+} // namespace
+
+// Useful for assessing the performance of dirty propagation
+// through a large graph, where only a few of the nodes are
+// observed, as is typical when a UI is displaying a script.
+void GafferTest::testDirtyPropagationPerformance()
+{
+	// Declared first so that it outlives the
+	// nodes which are connected to it.
+	DirtiedCounter counter;
+
+	const int numNodes = 1000;
+	vector<MultiplyNodePtr> nodes;
+	for( int i = 0; i < numNodes; ++i )
+	{
+		MultiplyNodePtr node = new MultiplyNode;
+		if( i )
+		{
+			node->op1Plug()->setInput( nodes.back()->productPlug() );
+			node->op2Plug()->setInput( nodes.back()->productPlug() );
+		}
+		if( i % 10 == 0 )
+		{
+			node->plugDirtiedSignal().connect( boost::bind( &DirtiedCounter::plugDirtied, &counter, ::_1 ) );
+		}
+		nodes.push_back( node );
+	}
+
+	Timer t;
+	const int numEdits = 100;
+	for( int i = 0; i < numEdits; ++i )
+	{
+		nodes.front()->op1Plug()->setValue( i + 1 );
+	}
+
+	// uncomment to get timing information
+	//std::cerr << t.stop() << std::endl;
+
+	// The first node has op1 and product dirtied, and the
+	// others have op1, op2 and product dirtied.
+	GAFFERTEST_ASSERT( counter.count == numEdits * ( 2 + 3 * ( numNodes / 10 - 1 ) ) );
+}
@@ -0,0 +1,89 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2016, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "boost/lexical_cast.hpp"
+
+#include "IECore/Timer.h"
+
+#include "Gaffer/GraphComponent.h"
+
+#include "GafferTest/Assert.h"
+#include "GafferTest/GraphComponentTest.h"
+
+using namespace Gaffer;
+
+void GafferTest::testGraphComponentManyChildren()
+{
+	const size_t numChildren = 20000;
+
+	IECore::Timer t;
+
+	// Unique names, as when loading a script.
+
+	GraphComponentPtr parent = new GraphComponent;
+	std::vector<IECore::InternedString> names;
+	for( size_t i = 0; i < numChildren; ++i )
+	{
+		names.push_back( "child" + boost::lexical_cast<std::string>( i ) );
+		parent->setChild( names.back(), new GraphComponent );
+	}
+
+	for( size_t i = 0; i < numChildren; ++i )
+	{
+		GAFFERTEST_ASSERT( parent->getChild<GraphComponent>( names[i] ) == parent->getChild<GraphComponent>( i ) );
+	}
+
+	// Clashing names, as when pasting or adding
+	// inputs to an ArrayPlug.
+
+	GraphComponentPtr clashingParent = new GraphComponent;
+	for( size_t i = 0; i < numChildren; ++i )
+	{
+		clashingParent->addChild( new GraphComponent( "in" ) );
+	}
+	GAFFERTEST_ASSERT( clashingParent->getChild<GraphComponent>( numChildren - 1 )->getName() == "in" + boost::lexical_cast<std::string>( numChildren - 1 ) );
+
+	for( size_t i = 0; i < numChildren; ++i )
+	{
+		clashingParent->getChild<GraphComponent>( i )->setName( "renamed" );
+	}
+	GAFFERTEST_ASSERT( clashingParent->getChild<GraphComponent>( "renamed1" ) == clashingParent->getChild<GraphComponent>( 1 ) );
+
+	clashingParent->clearChildren();
+	GAFFERTEST_ASSERT( clashingParent->children().empty() );
+
+	//std::cerr << t.stop() << std::endl;
+}
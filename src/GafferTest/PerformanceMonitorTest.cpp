@@ -0,0 +1,173 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2016, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "tbb/parallel_for.h"
+
+#include "IECore/Timer.h"
+
+#include "Gaffer/Process.h"
+#include "Gaffer/PerformanceMonitor.h"
+
+#include "GafferTest/Assert.h"
+#include "GafferTest/MultiplyNode.h"
+#include "GafferTest/PerformanceMonitorTest.h"
+
+using namespace tbb;
+using namespace Gaffer;
+
+namespace
+{
+
+// The PerformanceMonitor only monitors hash and compute processes,
+// so we masquerade as hash processes.
+class TestProcess : public Process
+{
+
+	public :
+
+		TestProcess( const Plug *plug )
+			:	Process( g_type, plug )
+		{
+		}
+
+	private :
+
+		static const IECore::InternedString g_type;
+
+};
+
+const IECore::InternedString TestProcess::g_type( "computeNode:hash" );
+
+struct Processes
+{
+
+	Processes( const std::vector<NodePtr> &nodes )
+		:	m_nodes( nodes )
+	{
+	}
+
+	void operator()( const blocked_range<size_t> &r ) const
+	{
+		for( size_t i=r.begin(); i!=r.end(); ++i )
+		{
+			const MultiplyNode *node = static_cast<const MultiplyNode *>( m_nodes[i % m_nodes.size()].get() );
+			TestProcess hash( node->productPlug() );
+			TestProcess upstreamHash( node->op1Plug() );
+		}
+	}
+
+	private :
+
+		const std::vector<NodePtr> &m_nodes;
+
+};
+
+double runProcesses( const std::vector<NodePtr> &nodes, size_t numIterations, PerformanceMonitor *monitor )
+{
+	Monitor::Scope monitorScope( monitor );
+
+	Processes p( nodes );
+	IECore::Timer t;
+	parallel_for( blocked_range<size_t>( 0, numIterations ), p );
+	const double time = t.stop();
+
+	if( !monitor )
+	{
+		return time;
+	}
+
+	size_t hashCount = 0;
+	const PerformanceMonitor::StatisticsMap &statistics = monitor->allStatistics();
+	for( PerformanceMonitor::StatisticsMap::const_iterator it = statistics.begin(), eIt = statistics.end(); it != eIt; ++it )
+	{
+		hashCount += it->second.hashCount;
+		GAFFERTEST_ASSERT( it->second.computeCount == 0 );
+	}
+	GAFFERTEST_ASSERT( statistics.size() == nodes.size() * 2 );
+	GAFFERTEST_ASSERT( hashCount == numIterations * 2 );
+
+	return time;
+}
+
+} // namespace
+
+void GafferTest::testPerformanceMonitorOverhead()
+{
+	std::vector<NodePtr> nodes;
+	for( size_t i = 0; i < 1000; ++i )
+	{
+		nodes.push_back( new MultiplyNode );
+	}
+
+	const size_t numIterations = 1000000;
+	runProcesses( nodes, numIterations, NULL );
+
+	PerformanceMonitor monitor;
+	const double monitorTime = runProcesses( nodes, numIterations, &monitor );
+
+	PerformanceMonitor samplingMonitor( /* recordEvents = */ false, /* sampleInterval = */ 100 );
+	const double samplingTime = runProcesses( nodes, numIterations, &samplingMonitor );
+
+	// Sampling skips the clock queries which dominate the cost of
+	// monitoring, so must be cheaper than timing every process.
+	GAFFERTEST_ASSERT( samplingTime < monitorTime );
+}
+
+void GafferTest::testPerformanceMonitorSamplingAliasing()
+{
+	MultiplyNodePtr node = new MultiplyNode;
+
+	// Alternate between two plugs, so the pattern of processes
+	// has the same period as the sample interval. A sampler which
+	// always chose the same position within each interval would
+	// only ever time one of the plugs.
+	PerformanceMonitor monitor( /* recordEvents = */ false, /* sampleInterval = */ 2 );
+	{
+		Monitor::Scope monitorScope( &monitor );
+		for( size_t i = 0; i < 1000; ++i )
+		{
+			TestProcess( node->op1Plug() );
+			TestProcess( node->op2Plug() );
+		}
+	}
+
+	const PerformanceMonitor::Statistics &s1 = monitor.plugStatistics( node->op1Plug() );
+	const PerformanceMonitor::Statistics &s2 = monitor.plugStatistics( node->op2Plug() );
+	GAFFERTEST_ASSERT( s1.hashCount == 1000 );
+	GAFFERTEST_ASSERT( s2.hashCount == 1000 );
+	GAFFERTEST_ASSERT( s1.hashDuration.count() > 0 );
+	GAFFERTEST_ASSERT( s2.hashDuration.count() > 0 );
+}
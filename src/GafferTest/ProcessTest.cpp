@@ -0,0 +1,126 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2016, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "tbb/parallel_for.h"
+
+#include "Gaffer/Process.h"
+
+#include "GafferTest/Assert.h"
+#include "GafferTest/MultiplyNode.h"
+#include "GafferTest/ProcessTest.h"
+
+using namespace tbb;
+using namespace Gaffer;
+
+namespace
+{
+
+class TestProcess : public Process
+{
+
+	public :
+
+		TestProcess( const Plug *plug )
+			:	Process( g_type, plug )
+		{
+		}
+
+	private :
+
+		static const IECore::InternedString g_type;
+
+};
+
+const IECore::InternedString TestProcess::g_type( "test" );
+
+struct ChildProcesses
+{
+
+	ChildProcesses( const Plug *plug )
+		:	m_plug( plug ), m_parent( Process::current() )
+	{
+	}
+
+	void operator()( const blocked_range<size_t> &r ) const
+	{
+		Process::Scope processScope( m_parent );
+		for( size_t i=r.begin(); i!=r.end(); ++i )
+		{
+			TestProcess child( m_plug );
+			GAFFERTEST_ASSERT( child.parent() == m_parent );
+			GAFFERTEST_ASSERT( child.id() > m_parent->id() );
+			GAFFERTEST_ASSERT( Process::current() == &child );
+		}
+	}
+
+	private :
+
+		const Plug *m_plug;
+		const Process *m_parent;
+
+};
+
+} // namespace
+
+void GafferTest::testParallelProcessParent()
+{
+	MultiplyNodePtr node = new MultiplyNode;
+
+	GAFFERTEST_ASSERT( Process::current() == NULL );
+	{
+		TestProcess parent( node->productPlug() );
+		GAFFERTEST_ASSERT( parent.parent() == NULL );
+		GAFFERTEST_ASSERT( Process::current() == &parent );
+
+		ChildProcesses c( node->op1Plug() );
+		parallel_for( blocked_range<size_t>( 0, 10000 ), c );
+
+		GAFFERTEST_ASSERT( Process::current() == &parent );
+
+		// A NULL scope hides the current process, so that
+		// unrelated work isn't parented to it.
+		{
+			Process::Scope processScope( NULL );
+			GAFFERTEST_ASSERT( Process::current() == NULL );
+			TestProcess unrelated( node->op2Plug() );
+			GAFFERTEST_ASSERT( unrelated.parent() == NULL );
+			GAFFERTEST_ASSERT( Process::current() == &unrelated );
+		}
+
+		GAFFERTEST_ASSERT( Process::current() == &parent );
+	}
+	GAFFERTEST_ASSERT( Process::current() == NULL );
+}
@@ -0,0 +1,113 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2016, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//      * Redistributions of source code must retain the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer.
+//
+//      * Redistributions in binary form must reproduce the above
+//        copyright notice, this list of conditions and the following
+//        disclaimer in the documentation and/or other materials provided with
+//        the distribution.
+//
+//      * Neither the name of John Haddon nor the names of
+//        any other contributors to this software may be used to endorse or
+//        promote products derived from this software without specific prior
+//        written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "boost/lexical_cast.hpp"
+
+#include "IECore/Timer.h"
+
+#include "Gaffer/StringAlgo.h"
+
+#include "GafferTest/Assert.h"
+#include "GafferTest/StringAlgoTest.h"
+
+using namespace Gaffer;
+
+void GafferTest::testMatchPatternPerformance()
+{
+	const size_t numNames = 1000000;
+
+	std::vector<std::string> names;
+	names.reserve( numNames );
+	for( size_t i = 0; i < numNames; ++i )
+	{
+		const std::string n = boost::lexical_cast<std::string>( i );
+		names.push_back( i % 2 ? "object" + n + "Shape" : "group" + n );
+	}
+
+	std::vector<StringAlgo::MatchPattern> patterns;
+	patterns.push_back( "object12*" );
+	patterns.push_back( "*Shape" );
+	patterns.push_back( "group*7" );
+	patterns.push_back( "*ct1*2*Sh*" );
+	patterns.push_back( "group500000" );
+	patterns.push_back( "object1**" );
+
+	IECore::Timer t;
+
+	// Single patterns, compared against match().
+
+	for( std::vector<StringAlgo::MatchPattern>::const_iterator it = patterns.begin(), eIt = patterns.end(); it != eIt; ++it )
+	{
+		const StringAlgo::CompiledMatchPattern compiled( *it );
+		for( std::vector<std::string>::const_iterator nIt = names.begin(), neIt = names.end(); nIt != neIt; ++nIt )
+		{
+			GAFFERTEST_ASSERT( compiled.match( *nIt ) == StringAlgo::match( *nIt, *it ) );
+		}
+	}
+
+	// All patterns at once, compared against matching
+	// each pattern in turn.
+
+	std::string multiple;
+	for( std::vector<StringAlgo::MatchPattern>::const_iterator it = patterns.begin(), eIt = patterns.end(); it != eIt; ++it )
+	{
+		multiple += ( it == patterns.begin() ? "" : " " ) + *it;
+	}
+
+	const StringAlgo::CompiledMatchPattern compiled( patterns );
+	const StringAlgo::CompiledMatchPattern compiledMultiple( multiple, /* multiple = */ true );
+	size_t numMatches = 0;
+	for( std::vector<std::string>::const_iterator nIt = names.begin(), neIt = names.end(); nIt != neIt; ++nIt )
+	{
+		bool expected = false;
+		for( std::vector<StringAlgo::MatchPattern>::const_iterator it = patterns.begin(), eIt = patterns.end(); it != eIt && !expected; ++it )
+		{
+			expected = StringAlgo::match( *nIt, *it );
+		}
+
+		const bool m = compiled.match( *nIt );
+		GAFFERTEST_ASSERT( m == expected );
+		GAFFERTEST_ASSERT( compiledMultiple.match( *nIt ) == expected );
+		GAFFERTEST_ASSERT( StringAlgo::matchMultiple( *nIt, multiple ) == expected );
+		numMatches += m;
+	}
+
+	// Every odd name ends in "Shape", and "group500000" is even.
+	GAFFERTEST_ASSERT( numMatches > numNames / 2 );
+
+	//std::cerr << t.stop() << std::endl;
+}
@@ -46,6 +46,11 @@
 #include "GafferTest/ContextTest.h"
 #include "GafferTest/ComputeNodeTest.h"
 #include "GafferTest/DownstreamIteratorTest.h"
+#include "GafferTest/ProcessTest.h"
+#include "GafferTest/PerformanceMonitorTest.h"
+#include "GafferTest/GraphComponentTest.h"
+#include "GafferTest/StringAlgoTest.h"
+#include "GafferTest/DependencyNodeTest.h"
 
 using namespace boost::python;
 using namespace GafferTest;
@@ -56,6 +61,30 @@ static void testMetadataThreadingWrapper()
 	testMetadataThreading();
 }
 
+static void testParallelProcessParentWrapper()
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	testParallelProcessParent();
+}
+
+static void testPerformanceMonitorOverheadWrapper()
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	testPerformanceMonitorOverhead();
+}
+
+static void testMatchPatternPerformanceWrapper()
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	testMatchPatternPerformance();
+}
+
+static void parallelGetValueWrapper( const Gaffer::IntPlug *plug, int iterations )
+{
+	IECorePython::ScopedGILRelease gilRelease;
+	parallelGetValue( plug, iterations );
+}
+
 BOOST_PYTHON_MODULE( _GafferTest )
 {
 
@@ -65,10 +94,22 @@ BOOST_PYTHON_MODULE( _GafferTest )
 	def( "testFilteredRecursiveChildIterator", &testFilteredRecursiveChildIterator );
 	def( "testMetadataThreading", &testMetadataThreadingWrapper );
 	def( "testManyContexts", &testManyContexts );
+	def( "testManyVariablesHashPerformance", &testManyVariablesHashPerformance );
+	def( "testDeepPathHashPerformance", &testDeepPathHashPerformance );
 	def( "testManySubstitutions", &testManySubstitutions );
 	def( "testManyEnvironmentSubstitutions", &testManyEnvironmentSubstitutions );
 	def( "testScopingNullContext", &testScopingNullContext );
+	def( "testEditableScope", &testEditableScope );
+	def( "testManyEditableScopes", &testManyEditableScopes );
+	def( "testAccessRecorderThreading", &testAccessRecorderThreading );
 	def( "testComputeNodeThreading", &testComputeNodeThreading );
+	def( "testDirtyPropagationPerformance", &testDirtyPropagationPerformance );
+	def( "parallelGetValue", &parallelGetValueWrapper );
 	def( "testDownstreamIterator", &testDownstreamIterator );
+	def( "testParallelProcessParent", &testParallelProcessParentWrapper );
+	def( "testPerformanceMonitorOverhead", &testPerformanceMonitorOverheadWrapper );
+	def( "testPerformanceMonitorSamplingAliasing", &testPerformanceMonitorSamplingAliasing );
+	def( "testGraphComponentManyChildren", &testGraphComponentManyChildren );
+	def( "testMatchPatternPerformance", &testMatchPatternPerformanceWrapper );
 
 }
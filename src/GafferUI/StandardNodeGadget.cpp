@@ -292,7 +292,7 @@ StandardNodeGadget::StandardNodeGadget( Gaffer::NodePtr node )
 	////////////////////////////////////////////////////////
 
 	node->errorSignal().connect( boost::bind( &StandardNodeGadget::error, this, ::_1, ::_2, ::_3 ) );
-	node->plugDirtiedSignal().connect( boost::bind( &StandardNodeGadget::plugDirtied, this, ::_1 ) );
+	node->plugsDirtiedSignal().connect( boost::bind( &StandardNodeGadget::plugsDirtied, this, ::_1 ) );
 
 	dragEnterSignal().connect( boost::bind( &StandardNodeGadget::dragEnter, this, ::_1, ::_2 ) );
 	dragMoveSignal().connect( boost::bind( &StandardNodeGadget::dragMove, this, ::_1, ::_2 ) );
@@ -526,12 +526,16 @@ bool StandardNodeGadget::getLabelsVisibleOnHover() const
 	return m_labelsVisibleOnHover;
 }
 
-void StandardNodeGadget::plugDirtied( const Gaffer::Plug *plug )
+void StandardNodeGadget::plugsDirtied( const std::vector<Gaffer::Plug *> &plugs )
 {
-	updateNodeEnabled( plug );
-	if( ErrorGadget *e = errorGadget( /* createIfMissing = */ false ) )
+	ErrorGadget *e = errorGadget( /* createIfMissing = */ false );
+	for( std::vector<Gaffer::Plug *>::const_iterator it = plugs.begin(), eIt = plugs.end(); it != eIt; ++it )
 	{
-		e->removeError( plug );
+		updateNodeEnabled( *it );
+		if( e )
+		{
+			e->removeError( *it );
+		}
 	}
 }
 